@@ -29,6 +29,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Echo timed with timestamps, HcSr04GetTimestamp()					|
  * 
  **/
 
@@ -66,6 +67,13 @@ uint16_t HcSr04ReadDistanceInCentimeters(void);
  */
 uint16_t HcSr04ReadDistanceInInches(void);
 
+/**
+ * @brief Time of the last measurement (echo rising edge)
+ * 
+ * @return uint64_t Timestamp in us (see timestamp_mcu.h)
+ */
+uint64_t HcSr04GetTimestamp(void);
+
 /**
  * @brief HC_SR04 de-initialization.
  * 
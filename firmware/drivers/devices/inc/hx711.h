@@ -17,6 +17,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 30/01/2024 | Document creation		                         						|
+ * | 19/10/2026 | Median reading (robust to spikes)                 						|
+ * | 19/10/2026 | Reading timestamp (HX711_getTimestamp())          						|
  * 
  **/
 
@@ -65,6 +67,13 @@ uint32_t HX711_read(void);
  */
 uint32_t HX711_readAverage(uint8_t times);
 
+/** @fn HX711_readMedian(uint8_t times)
+ * @brief Returns the median of several readings, a single spike does not change it
+ * @param[in] times How many times to read (up to DSP_ORDER_MAX_WINDOW)
+ * @return Read value
+ */
+uint32_t HX711_readMedian(uint8_t times);
+
 /** @fn HX711_get_value(uint8_t times)
  * @brief Returns (read_average() - OFFSET), that is the current value without the tare weight
  * @param[in] times How many times to read
@@ -110,6 +119,12 @@ void HX711_setOffset(double offset);
  */
 double HX711_getOffset(void);
 
+/** @fn HX711_getTimestamp(void)
+ * @brief Returns the time the last reading was ready (for averages and medians, the last one of the series)
+ * @return Timestamp in us (see timestamp_mcu.h)
+ */
+uint64_t HX711_getTimestamp(void);
+
 /** @fn HX711_powerDown(void)
  * @brief Puts the chip into power down mode
  */
@@ -17,6 +17,7 @@
  * |   Date	| Description                                    			|
  * |:----------:|:----------------------------------------------------------------------|
  * | 30/01/2024 | Document creation		                         		|
+ * | 19/10/2026 | Motion reading timestamp				 		|
  * 
  **/
 
@@ -1849,6 +1850,14 @@ void MPU6050_getMotion9(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int1
  */
 void MPU6050_getMotion6(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz);
 
+/** Get the time of the last motion reading.
+ * @return Timestamp in us (start of the I2C transfer, see timestamp_mcu.h)
+ * @see getMotion6()
+ * @see getAcceleration()
+ * @see getRotation()
+ */
+uint64_t MPU6050_getMotionTimestamp();
+
 /** Get 3-axis accelerometer readings.
  * These registers store the most recent accelerometer measurements.
  * Accelerometer measurements are written to these registers at the Sample Rate
@@ -12,6 +12,7 @@
 /*==================[inclusions]=============================================*/
 #include "hc_sr04.h"
 #include "delay_mcu.h"
+#include "timestamp_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define MAX_US		17700	/* maximun distance time in us (300cm or 118inch) */
 #define MAX_CM		300		/* maximun distance time in cm */
@@ -21,13 +22,40 @@
 #define WAIT_MAX	5900	/* maximun time to wait for echo signal */
 /*==================[internal data declaration]==============================*/
 static gpio_t echo_st, trigger_st; /**<  Stores the pin inicilization*/
+static uint64_t echo_time = 0;	/**< Time of the last echo rising edge (us) */
 /*==================[internal functions declaration]=========================*/
+static uint32_t hc_sr04_echo(void);
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Trigger a measurement and time the echo pulse
+ * 
+ * @return uint32_t Echo pulse width in us (0: no echo, more than MAX_US: out of range)
+ */
+static uint32_t hc_sr04_echo(void){
+	uint64_t start;
+	GPIOOn(trigger_st);
+	DelayUs(10);
+	GPIOOff(trigger_st);
+	start = TimestampNow();
+	while(!GPIORead(echo_st)){
+		if(TimestampElapsed(start) > WAIT_MAX){
+			return 0;
+		}
+	}
+	echo_time = TimestampNow();
+	while(GPIORead(echo_st)){
+		if(TimestampElapsed(echo_time) > MAX_US){
+			return MAX_US + 1;
+		}
+	}
+	return TimestampElapsed(echo_time);
+}
+
 
 /*==================[external functions definition]==========================*/
 
@@ -43,47 +71,21 @@ bool HcSr04Init(gpio_t echo, gpio_t trigger){
 }
 
 uint16_t HcSr04ReadDistanceInCentimeters(void){
-	uint16_t distance = 0, waiting = 0;
-	GPIOOn(trigger_st);
-	DelayUs(10);
-	GPIOOff(trigger_st);
-	while(!GPIORead(echo_st)){
-		DelayUs(1);
-		waiting++;
-		if(waiting > WAIT_MAX){
-			return 0;
-		}
-	}
-	do{
-		DelayUs(1);
-		distance++;
-		if(distance > MAX_US)
-			return MAX_CM;
-	}
-	while(GPIORead(echo_st));
-	return (distance/US2CM);
+	uint32_t width = hc_sr04_echo();
+	if(width > MAX_US)
+		return MAX_CM;
+	return (width/US2CM);
 }
 
 uint16_t HcSr04ReadDistanceInInches(void){
-	uint16_t distance = 0, waiting = 0;
-	GPIOOn(trigger_st);
-	DelayUs(10);
-	GPIOOff(trigger_st);
-	while(!GPIORead(echo_st)){
-		DelayUs(1);
-		waiting++;
-		if(waiting > WAIT_MAX){
-			return 0;
-		}
-	}
-	do{
-		DelayUs(1);
-		distance++;
-		if(distance > MAX_US)
-			return MAX_INCH;
-	}
-	while(GPIORead(echo_st));
-	return (distance/US2INCH);
+	uint32_t width = hc_sr04_echo();
+	if(width > MAX_US)
+		return MAX_INCH;
+	return (width/US2INCH);
+}
+
+uint64_t HcSr04GetTimestamp(void){
+	return echo_time;
 }
 
 bool HcSr04Deinit(void){
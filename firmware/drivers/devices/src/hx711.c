@@ -12,6 +12,9 @@
 #include "hx711.h"
 
 #include <delay_mcu.h>
+#include "dsp_order_stat.h"
+#include "timestamp_mcu.h"
+#include "trace_mcu.h"
 
 /*==================[macros and definitions]=================================*/
 
@@ -23,6 +26,7 @@ float SCALE;	                 /*!<  Used to return weight in grams, kg, ounces,
 
 gpio_t internal_pd_sck;
 gpio_t internal_dout;
+static uint64_t read_time = 0;	 /*!<  Time the last reading was ready (us) */
 
 /*==================[internal functions declaration]=========================*/
 
@@ -80,8 +84,10 @@ void HX711_setGain(uint8_t gain)
 
 uint32_t HX711_read(void)
 {
+	TraceBegin(TRACE_HX711_READ);
 	// wait for the chip to become ready
 	while (!HX711_isReady());
+	read_time = TimestampNow();
 
     unsigned long count;
     unsigned char i;
@@ -111,6 +117,7 @@ uint32_t HX711_read(void)
     GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
     DelayUs(1);
     count ^= 0x800000;
+    TraceEnd(TRACE_HX711_READ);
     return(count);
 }
 
@@ -125,12 +132,23 @@ uint32_t HX711_readAverage(uint8_t times)
 	return sum / times;
 }
 
-double HX711_getValue(uint8_t times)
+uint32_t HX711_readMedian(uint8_t times)
+{
+	static dsp_order_stat_t median;
+	DspOrderStatInit(&median, times, 0);
+	for (uint8_t i = 0; i < times; i++)
+	{
+		DspOrderStatUpdate(&median, HX711_read());
+	}
+	return DspOrderStatMedian(&median);
+}
+
+double HX711_get_value(uint8_t times)
 {
 	return HX711_readAverage(times) - OFFSET;
 }
 
-float HX711_getUnits(uint8_t times)
+float HX711_get_units(uint8_t times)
 {
 	return HX711_get_value(times) / SCALE;
 }
@@ -161,6 +179,11 @@ double HX711_getOffset(void)
 	return OFFSET;
 }
 
+uint64_t HX711_getTimestamp(void)
+{
+	return read_time;
+}
+
 void HX711_powerDown(void)
 {
 	GPIOOff(internal_pd_sck);//PD_SCK_SET_LOW;
@@ -34,6 +34,8 @@
 #include "spi_mcu.h"
 #include "gpio_mcu.h"
 #include "delay_mcu.h"
+#include "fmt.h"
+#include "trace_mcu.h"
 
 /*****************************************************************************
  * Private macros/types/enumerations/variables definitions
@@ -220,6 +222,7 @@ void Fill(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
  * Private functions declarations
  ****************************************************************************/
 void WriteLCD(lcd_cmd_t * data){
+	TraceBegin(TRACE_LCD_WRITE);
 	SpiInit(&spi_conf);
 	/* If command is NULL don't send command */
 	if (data->cmd != NULL){
@@ -233,6 +236,7 @@ void WriteLCD(lcd_cmd_t * data){
 		GPIOOn(ili9341_dc);
 		SpiWrite(ili9341_spi, data->data, data->databytes);
 	}
+	TraceEnd(TRACE_LCD_WRITE);
 }
 
 void SetCursorPosition(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1){
@@ -436,17 +440,18 @@ void ILI9341DrawChar(uint16_t x, uint16_t y, char data, Font_t* font, uint16_t f
 }
 
 void ILI9341DrawInt(uint16_t x, uint16_t y, uint32_t num, uint8_t dig, Font_t* font, uint16_t foreground, uint16_t background){
-	static uint16_t i;
-	static uint16_t lcd_x, lcd_y;
+	char digits[FMT_BUF_SIZE];
+	uint8_t len;
+	uint8_t first;
 
-	/* Set coordinates */
-	lcd_x = x;
-	lcd_y = y;
-
-	for (i=0; i<dig; i++){
-		lcd_x = x + font->FontWidth * (dig-1-i);
-		ILI9341DrawChar(lcd_x, lcd_y, num%10 + '0', font, foreground, background);
-		num = num/10;
+	if (dig > FMT_MAX_WIDTH){
+		dig = FMT_MAX_WIDTH;
+	}
+	/* Last dig digits, zero padded */
+	len = FmtUint(digits, num, 10, dig, '0');
+	first = len - dig;
+	for (uint8_t i=0; i<dig; i++){
+		ILI9341DrawChar(x + font->FontWidth * i, y, digits[first + i], font, foreground, background);
 	}
 }
 
@@ -13,12 +13,14 @@
 #include "mpu6050.h"
 #include "math.h"
 #include <string.h>
+#include "timestamp_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define I2C_NUM I2C_NUM_0
 
 /*==================[internal data definition]===============================*/
 uint8_t devAddr;
 uint8_t buffer[14];
+static uint64_t motion_time = 0;	/*!< Time of the last motion reading (us) */
 /*==================[internal functions declaration]=========================*/
 
 /*==================[external functions definition]==========================*/
@@ -1774,7 +1776,18 @@ void MPU6050_getMotion9(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int1
  * @see getRotation()
  * @see MPU6050_RA_ACCEL_XOUT_H
  */
+/** Get the time of the last motion reading.
+ * Registers are read in a single burst, so all the axes share this timestamp.
+ * @return Timestamp in us (start of the I2C transfer, see timestamp_mcu.h)
+ * @see getMotion6()
+ * @see getAcceleration()
+ * @see getRotation()
+ */
+uint64_t MPU6050_getMotionTimestamp() {
+    return motion_time;
+}
 void MPU6050_getMotion6(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int16_t* gy, int16_t* gz) {
+    motion_time = TimestampNow();
     I2C_readBytes(devAddr, MPU6050_RA_ACCEL_XOUT_H, 14, buffer, I2C_MASTER_TIMEOUT_MS);
     *ax = (((int16_t)buffer[0]) << 8) | buffer[1];
     *ay = (((int16_t)buffer[2]) << 8) | buffer[3];
@@ -1820,6 +1833,7 @@ void MPU6050_getMotion6(int16_t* ax, int16_t* ay, int16_t* az, int16_t* gx, int1
  * @see MPU6050_RA_GYRO_XOUT_H
  */
 void MPU6050_getAcceleration(int16_t* x, int16_t* y, int16_t* z) {
+    motion_time = TimestampNow();
     I2C_readBytes(devAddr, MPU6050_RA_ACCEL_XOUT_H, 6, buffer, I2C_MASTER_TIMEOUT_MS);
     *x = (((int16_t)buffer[0]) << 8) | buffer[1];
     *y = (((int16_t)buffer[2]) << 8) | buffer[3];
@@ -1899,6 +1913,7 @@ int16_t MPU6050_getTemperature() {
  * @see MPU6050_RA_GYRO_XOUT_H
  */
 void MPU6050_getRotation(int16_t* x, int16_t* y, int16_t* z) {
+    motion_time = TimestampNow();
     I2C_readBytes(devAddr, MPU6050_RA_GYRO_XOUT_H, 6, buffer, I2C_MASTER_TIMEOUT_MS);
     *x = (((int16_t)buffer[0]) << 8) | buffer[1];
     *y = (((int16_t)buffer[2]) << 8) | buffer[3];
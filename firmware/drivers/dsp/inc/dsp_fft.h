@@ -0,0 +1,161 @@
+#ifndef DSP_FFT_H
+#define DSP_FFT_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_DSP Drivers DSP
+ ** @{ */
+/** \addtogroup DSP_FFT DSP FFT
+ ** @{ */
+
+/** \brief Fixed point FFT spectrum analyzer.
+ *
+ * In-place radix-2 complex FFT (256 to 1024 points) on Q31 data with a 
+ * precomputed twiddle table, plus the steps needed to go from an ADC block to 
+ * a spectrum: windowing, magnitude, dominant frequency and a compact binary 
+ * format to send the spectrum over UART. 
+ * 
+ * Each stage scales by 1/2, so the transform never overflows and the result 
+ * is X[k]/N. Magnitudes are also corrected by the window gain: a sine of 
+ * amplitude A (Q31) gives a magnitude of A/2 in its bin, independently of 
+ * the FFT size and window.
+ * 
+ * Example (1kHz sampling, 256 points):
+ * @code
+ * static dsp_fft_t fft;
+ * static dsp_cq31_t buf[256];
+ * static uint32_t mag[128];
+ * static uint8_t packet[DSP_FFT_PACK_HEADER + 128];
+ * DspFftInit(&fft, 256, DSP_WINDOW_HANN);
+ * ...
+ * DspFftRaw(&fft, samples, buf);
+ * DspFftMagnitude(&fft, buf, mag);
+ * uint32_t f_mhz = DspFftDominant(&fft, mag, 1000);
+ * uint16_t len = DspFftPack(&fft, mag, 1000, packet);
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_math.h"
+/*==================[macros]=================================================*/
+#define DSP_FFT_MIN_SIZE	256		/*!< Smallest FFT size */
+#define DSP_FFT_MAX_SIZE	1024	/*!< Largest FFT size (twiddle table size) */
+#define DSP_FFT_PACK_HEADER	8		/*!< Bytes before the bins in a packed spectrum */
+/*==================[typedef]================================================*/
+/**
+ * @brief Window applied before the transform
+ */
+typedef enum {
+	DSP_WINDOW_RECT,		/*!< No window */
+	DSP_WINDOW_HANN,		/*!< Hann window */
+	DSP_WINDOW_HAMMING,		/*!< Hamming window */
+} dsp_window_t;
+
+/**
+ * @brief Complex Q31 value
+ */
+typedef struct {
+	q31_t re;				/*!< Real part */
+	q31_t im;				/*!< Imaginary part */
+} dsp_cq31_t;
+
+/**
+ * @brief FFT instance
+ */
+typedef struct {
+	uint16_t n;								/*!< FFT size */
+	uint8_t log2n;							/*!< log2 of FFT size */
+	q15_t window[DSP_FFT_MAX_SIZE / 2];		/*!< First half of the (symmetric) window */
+	q15_t gain;								/*!< Window coherent gain */
+} dsp_fft_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief FFT initialization (builds twiddle and window tables)
+ * 
+ * @note Uses floating point to build the tables (init only).
+ * 
+ * @param fft FFT instance
+ * @param n FFT size, power of 2 from DSP_FFT_MIN_SIZE to DSP_FFT_MAX_SIZE
+ * @param window Window applied to the input
+ * @return true if the size is valid
+ */
+bool DspFftInit(dsp_fft_t *fft, uint16_t n, dsp_window_t window);
+
+/**
+ * @brief In-place complex FFT (no window), result is X[k]/N
+ * 
+ * @param fft FFT instance
+ * @param buf Data (n complex values)
+ */
+void DspFft(dsp_fft_t *fft, dsp_cq31_t *buf);
+
+/**
+ * @brief Window and transform a block of raw ADC samples (12 bits, as read from analog_io_mcu)
+ * 
+ * @param fft FFT instance
+ * @param raw ADC samples (n values)
+ * @param buf Result (n complex values)
+ */
+void DspFftRaw(dsp_fft_t *fft, const uint16_t *raw, dsp_cq31_t *buf);
+
+/**
+ * @brief Window and transform a block of Q15 samples
+ * 
+ * @param fft FFT instance
+ * @param in Samples (n values)
+ * @param buf Result (n complex values)
+ */
+void DspFftQ15(dsp_fft_t *fft, const q15_t *in, dsp_cq31_t *buf);
+
+/**
+ * @brief Magnitude spectrum of a real signal (bins 0 to n/2 - 1)
+ * 
+ * @param fft FFT instance
+ * @param buf Transform result
+ * @param mag Magnitudes (n/2 values), a sine of amplitude A (Q31) gives A/2 in its bin
+ */
+void DspFftMagnitude(dsp_fft_t *fft, const dsp_cq31_t *buf, uint32_t *mag);
+
+/**
+ * @brief Dominant frequency (largest bin but DC, refined with parabolic interpolation)
+ * 
+ * @param fft FFT instance
+ * @param mag Magnitude spectrum
+ * @param fs Sample frequency (Hz)
+ * @return uint32_t Frequency in mHz
+ */
+uint32_t DspFftDominant(dsp_fft_t *fft, const uint32_t *mag, uint32_t fs);
+
+/**
+ * @brief Pack a magnitude spectrum for streaming
+ * 
+ * Format (little endian): 'S', 'P', uint16 bins, uint32 fs, then one byte 
+ * per bin with the magnitude in -0.5dBFS steps (0 = full scale sine, 255 = 
+ * -127.5dBFS or less).
+ * 
+ * @param fft FFT instance
+ * @param mag Magnitude spectrum
+ * @param fs Sample frequency (Hz)
+ * @param out Output buffer (DSP_FFT_PACK_HEADER + n/2 bytes)
+ * @return uint16_t Number of bytes written
+ */
+uint16_t DspFftPack(dsp_fft_t *fft, const uint32_t *mag, uint32_t fs, uint8_t *out);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef DSP_FFT_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,250 @@
+#ifndef DSP_FILTER_H
+#define DSP_FILTER_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_DSP Drivers DSP
+ ** @{ */
+/** \addtogroup DSP_Filter DSP Filter
+ ** @{ */
+
+/** \brief Fixed point streaming filters: FIR, cascaded biquad IIR, DC blocker and notch.
+ *
+ * Filters process blocks of samples and keep their state between calls, so a 
+ * signal can be filtered block by block as it is acquired. No memory is 
+ * allocated: coefficients and state buffers are provided by the caller and 
+ * must live while the filter is used.
+ * 
+ * Example (50Hz notch for a signal sampled at 1kHz):
+ * @code
+ * static dsp_biquad_coeffs_t notch_coeffs;
+ * static dsp_biquad_state_t notch_state;
+ * static dsp_biquad_t notch;
+ * DspBiquadNotch(&notch_coeffs, 50, 1000, 10);
+ * DspBiquadInit(&notch, &notch_coeffs, 1, &notch_state);
+ * ...
+ * DspBiquadQ15(&notch, block, block, ADC_BLOCK_SIZE);
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "dsp_math.h"
+/*==================[macros]=================================================*/
+#define DSP_BIQUAD_COEF(x)	((q31_t)((x) * 1073741824.0 + ((x) >= 0 ? 0.5 : -0.5)))	/*!< Biquad coefficient constant (Q30) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Q15 FIR filter instance
+ */
+typedef struct {
+	const q15_t *coeffs;	/*!< Coefficients h[0]..h[taps-1] */
+	q15_t *state;			/*!< Delay line (2 * taps values) */
+	uint16_t taps;			/*!< Number of coefficients */
+	uint16_t pos;			/*!< Delay line write position */
+} dsp_fir_q15_t;
+
+/**
+ * @brief Q31 FIR filter instance
+ */
+typedef struct {
+	const q31_t *coeffs;	/*!< Coefficients h[0]..h[taps-1] */
+	q31_t *state;			/*!< Delay line (2 * taps values) */
+	uint16_t taps;			/*!< Number of coefficients */
+	uint16_t pos;			/*!< Delay line write position */
+} dsp_fir_q31_t;
+
+/**
+ * @brief Biquad section coefficients (Q30, range [-2, 2)).
+ * 
+ * H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+ */
+typedef struct {
+	q31_t b0;				/*!< Numerator */
+	q31_t b1;				/*!< Numerator */
+	q31_t b2;				/*!< Numerator */
+	q31_t a1;				/*!< Denominator */
+	q31_t a2;				/*!< Denominator */
+} dsp_biquad_coeffs_t;
+
+/**
+ * @brief Biquad section state (Direct Form I, Q31)
+ */
+typedef struct {
+	q31_t x1;				/*!< x[n-1] */
+	q31_t x2;				/*!< x[n-2] */
+	q31_t y1;				/*!< y[n-1] */
+	q31_t y2;				/*!< y[n-2] */
+} dsp_biquad_state_t;
+
+/**
+ * @brief Cascaded biquad filter instance
+ */
+typedef struct {
+	const dsp_biquad_coeffs_t *coeffs;	/*!< Coefficients (one set per stage) */
+	dsp_biquad_state_t *state;			/*!< State (one per stage) */
+	uint8_t stages;						/*!< Number of second order sections */
+} dsp_biquad_t;
+
+/**
+ * @brief DC blocker instance: y[n] = x[n] - x[n-1] + r * y[n-1]
+ */
+typedef struct {
+	q15_t r;				/*!< Pole radius (Q15) */
+	q15_t x1;				/*!< x[n-1] */
+	int32_t y1;				/*!< y[n-1] (Q30, extra precision avoids limit cycles) */
+} dsp_dc_block_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a Q15 FIR filter. The delay line is cleared.
+ * 
+ * @note The accumulator is 32 bits wide: the sum of |h[k]| must be lower 
+ * than 2.0 to avoid overflow (true for most low-pass and band-pass designs).
+ * 
+ * @param fir FIR instance
+ * @param coeffs Coefficients (Q15)
+ * @param taps Number of coefficients
+ * @param state Delay line buffer (2 * taps values)
+ */
+void DspFirQ15Init(dsp_fir_q15_t *fir, const q15_t *coeffs, uint16_t taps, q15_t *state);
+
+/**
+ * @brief Filter a block of Q15 samples.
+ * 
+ * @note in and out can point to the same buffer.
+ * 
+ * @param fir FIR instance
+ * @param in Input samples
+ * @param out Output samples
+ * @param len Number of samples
+ */
+void DspFirQ15(dsp_fir_q15_t *fir, const q15_t *in, q15_t *out, uint32_t len);
+
+/**
+ * @brief Initialize a Q31 FIR filter. The delay line is cleared.
+ * 
+ * @param fir FIR instance
+ * @param coeffs Coefficients (Q31)
+ * @param taps Number of coefficients
+ * @param state Delay line buffer (2 * taps values)
+ */
+void DspFirQ31Init(dsp_fir_q31_t *fir, const q31_t *coeffs, uint16_t taps, q31_t *state);
+
+/**
+ * @brief Filter a block of Q31 samples. Products keep their 32 MSB 
+ * (30 bits of fraction), accumulation is done in 32 bits.
+ * 
+ * @note in and out can point to the same buffer.
+ * 
+ * @param fir FIR instance
+ * @param in Input samples
+ * @param out Output samples
+ * @param len Number of samples
+ */
+void DspFirQ31(dsp_fir_q31_t *fir, const q31_t *in, q31_t *out, uint32_t len);
+
+/**
+ * @brief Initialize a cascaded biquad filter. The state is cleared.
+ * 
+ * @param bq Biquad instance
+ * @param coeffs Coefficients (one set per stage)
+ * @param stages Number of second order sections
+ * @param state State buffer (one per stage)
+ */
+void DspBiquadInit(dsp_biquad_t *bq, const dsp_biquad_coeffs_t *coeffs, uint8_t stages, dsp_biquad_state_t *state);
+
+/**
+ * @brief Filter a block of Q31 samples through all the stages.
+ * 
+ * @note in and out can point to the same buffer.
+ * 
+ * @param bq Biquad instance
+ * @param in Input samples
+ * @param out Output samples
+ * @param len Number of samples
+ */
+void DspBiquadQ31(dsp_biquad_t *bq, const q31_t *in, q31_t *out, uint32_t len);
+
+/**
+ * @brief Filter a block of Q15 samples through all the stages (computed in Q31).
+ * 
+ * @note in and out can point to the same buffer.
+ * 
+ * @param bq Biquad instance
+ * @param in Input samples
+ * @param out Output samples
+ * @param len Number of samples
+ */
+void DspBiquadQ15(dsp_biquad_t *bq, const q15_t *in, q15_t *out, uint32_t len);
+
+/**
+ * @brief Design a second order low-pass section (Butterworth when q = 0.7071).
+ * 
+ * @note Uses floating point, call it at init, not in the sample path.
+ * 
+ * @param coeffs Coefficients to compute
+ * @param fc Cut-off frequency (Hz)
+ * @param fs Sample frequency (Hz)
+ * @param q Quality factor
+ */
+void DspBiquadLowpass(dsp_biquad_coeffs_t *coeffs, float fc, float fs, float q);
+
+/**
+ * @brief Design a second order high-pass section (Butterworth when q = 0.7071).
+ * 
+ * @note Uses floating point, call it at init, not in the sample path.
+ * 
+ * @param coeffs Coefficients to compute
+ * @param fc Cut-off frequency (Hz)
+ * @param fs Sample frequency (Hz)
+ * @param q Quality factor
+ */
+void DspBiquadHighpass(dsp_biquad_coeffs_t *coeffs, float fc, float fs, float q);
+
+/**
+ * @brief Design a notch section.
+ * 
+ * @note Uses floating point, call it at init, not in the sample path.
+ * 
+ * @param coeffs Coefficients to compute
+ * @param f0 Rejected frequency (Hz)
+ * @param fs Sample frequency (Hz)
+ * @param q Quality factor (f0 / rejected bandwidth)
+ */
+void DspBiquadNotch(dsp_biquad_coeffs_t *coeffs, float f0, float fs, float q);
+
+/**
+ * @brief Initialize a DC blocker.
+ * 
+ * @param dc DC blocker instance
+ * @param r Pole radius (Q15), closer to 1 means lower cut-off (e.g. Q15(0.995))
+ */
+void DspDcBlockInit(dsp_dc_block_t *dc, q15_t r);
+
+/**
+ * @brief Remove the DC component of a block of Q15 samples.
+ * 
+ * @note in and out can point to the same buffer.
+ * 
+ * @param dc DC blocker instance
+ * @param in Input samples
+ * @param out Output samples
+ * @param len Number of samples
+ */
+void DspDcBlockQ15(dsp_dc_block_t *dc, const q15_t *in, q15_t *out, uint32_t len);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef DSP_FILTER_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,157 @@
+#ifndef DSP_GOERTZEL_H
+#define DSP_GOERTZEL_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_DSP Drivers DSP
+ ** @{ */
+/** \addtogroup DSP_Goertzel DSP Goertzel
+ ** @{ */
+
+/** \brief Fixed point Goertzel tone detector.
+ *
+ * Measures the amplitude of a few fixed frequencies (e.g. 50Hz mains hum and 
+ * its harmonics) with one multiply per sample per tone, much cheaper than an 
+ * FFT when only a handful of frequencies matter. 
+ * 
+ * Samples are fed in blocks of any length; every n samples (the analysis 
+ * window) the tone amplitudes and the fraction of the signal power in each 
+ * tone are computed and smoothed over successive windows. The tone ratio is 
+ * compared against on/off thresholds (with hysteresis) to give a detection 
+ * flag, e.g. to enable a notch filter only when there is hum.
+ * 
+ * Example (50Hz hum on a 1kHz signal, 200ms window):
+ * @code
+ * static dsp_goertzel_t hum;
+ * const float hum_frec[] = {50, 150};
+ * DspGoertzelInit(&hum, hum_frec, 2, 1000, 200, Q15(0.25));
+ * DspGoertzelDetection(&hum, Q15(0.1), Q15(0.02));
+ * ...
+ * if(DspGoertzelRaw(&hum, samples, ADC_BLOCK_SIZE)){
+ * 	notch_on = DspGoertzelDetected(&hum, 0);
+ * }
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_math.h"
+/*==================[macros]=================================================*/
+#define DSP_GOERTZEL_MAX_TONES	4		/*!< Tones per detector */
+#define DSP_GOERTZEL_MAX_N		1024	/*!< Longest analysis window (keeps the filter state in 32 bits) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Goertzel tone state
+ */
+typedef struct {
+	int32_t coeff;			/*!< 2*cos(w) (Q30) */
+	int32_t s1;				/*!< Filter state */
+	int32_t s2;				/*!< Filter state */
+	q15_t amplitude;		/*!< Smoothed tone amplitude (Q15) */
+	q15_t ratio;			/*!< Smoothed fraction of signal power in the tone (Q15) */
+	bool detected;			/*!< Ratio went above on threshold (and not yet below off threshold) */
+} dsp_goertzel_tone_t;
+
+/**
+ * @brief Goertzel detector instance
+ */
+typedef struct {
+	dsp_goertzel_tone_t tone[DSP_GOERTZEL_MAX_TONES];	/*!< Tones */
+	uint8_t tones;			/*!< Number of tones */
+	uint16_t n;				/*!< Analysis window length */
+	uint16_t count;			/*!< Samples in current window */
+	int32_t sum;			/*!< Sum of samples in current window */
+	uint64_t energy;		/*!< Sum of squared samples in current window */
+	q15_t alpha;			/*!< Smoothing factor (Q15, Q15(1.0): no smoothing) */
+	q15_t on;				/*!< Detection threshold (ratio) */
+	q15_t off;				/*!< Release threshold (ratio) */
+	uint32_t windows;		/*!< Windows analysed */
+} dsp_goertzel_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Goertzel detector initialization
+ * 
+ * @note Uses floating point to compute coefficients (init only).
+ * 
+ * @param g Detector instance
+ * @param frec Tone frequencies (Hz), between 0 and fs/2 (exclusive)
+ * @param tones Number of tones (up to DSP_GOERTZEL_MAX_TONES)
+ * @param fs Sample frequency (Hz)
+ * @param n Analysis window length (up to DSP_GOERTZEL_MAX_N), resolution is fs/n
+ * @param alpha Smoothing factor between windows (Q15, Q15(1.0): no smoothing)
+ */
+void DspGoertzelInit(dsp_goertzel_t *g, const float *frec, uint8_t tones, float fs, uint16_t n, q15_t alpha);
+
+/**
+ * @brief Set detection thresholds
+ * 
+ * @param g Detector instance
+ * @param on Ratio (fraction of signal power in the tone, Q15) that sets the detection
+ * @param off Ratio that clears the detection (below on)
+ */
+void DspGoertzelDetection(dsp_goertzel_t *g, q15_t on, q15_t off);
+
+/**
+ * @brief Process a block of Q15 samples
+ * 
+ * @param g Detector instance
+ * @param in Samples (Q15)
+ * @param len Number of samples
+ * @return uint8_t Number of analysis windows completed in this block
+ */
+uint8_t DspGoertzelQ15(dsp_goertzel_t *g, const q15_t *in, uint32_t len);
+
+/**
+ * @brief Process a block of raw ADC samples (12 bits, as read from analog_io_mcu)
+ * 
+ * @param g Detector instance
+ * @param raw ADC samples
+ * @param len Number of samples
+ * @return uint8_t Number of analysis windows completed in this block
+ */
+uint8_t DspGoertzelRaw(dsp_goertzel_t *g, const uint16_t *raw, uint32_t len);
+
+/**
+ * @brief Tone amplitude
+ * 
+ * @param g Detector instance
+ * @param tone Tone index
+ * @return q15_t Smoothed peak amplitude (Q15, ADC full scale for raw input)
+ */
+q15_t DspGoertzelAmplitude(dsp_goertzel_t *g, uint8_t tone);
+
+/**
+ * @brief Fraction of the signal power (DC excluded) in a tone, usable as quality metric
+ * 
+ * @param g Detector instance
+ * @param tone Tone index
+ * @return q15_t Smoothed ratio (Q15)
+ */
+q15_t DspGoertzelRatio(dsp_goertzel_t *g, uint8_t tone);
+
+/**
+ * @brief Tone detection state
+ * 
+ * @param g Detector instance
+ * @param tone Tone index
+ * @return true if the tone is present (see DspGoertzelDetection())
+ */
+bool DspGoertzelDetected(dsp_goertzel_t *g, uint8_t tone);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef DSP_GOERTZEL_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,106 @@
+#ifndef DSP_MATH_H
+#define DSP_MATH_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_DSP Drivers DSP
+ ** @{ */
+/** \addtogroup DSP_Math DSP Math
+ ** @{ */
+
+/** \brief Fixed point types and helpers shared by the DSP modules.
+ *
+ * The ESP32-C6 core (RV32IMAC) has no FPU and no DSP extension, but it has a
+ * single cycle 32x32 multiplier that also returns the high word (mulh). The 
+ * helpers below are written so the compiler maps them to those instructions.
+ * 
+ * Formats: Q15 is int16_t in [-1, 1), Q31 is int32_t in [-1, 1).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#define Q15_ONE		32768				/*!< 1.0 in Q15 (not representable, used for scaling) */
+#define Q31_ONE		2147483648.0		/*!< 1.0 in Q31 (used for scaling at design time) */
+#define Q15(x)		((int16_t)((x) * 32767.0 + ((x) >= 0 ? 0.5 : -0.5)))		/*!< Constant to Q15 */
+#define Q31(x)		((int32_t)((x) * 2147483647.0 + ((x) >= 0 ? 0.5 : -0.5)))	/*!< Constant to Q31 */
+/*==================[typedef]================================================*/
+typedef int16_t q15_t;		/*!< Q15 fixed point value */
+typedef int32_t q31_t;		/*!< Q31 fixed point value */
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Saturate a 32 bit value to Q15
+ */
+static inline q15_t DspSat16(int32_t x){
+	if(x > INT16_MAX){
+		return INT16_MAX;
+	}
+	if(x < INT16_MIN){
+		return INT16_MIN;
+	}
+	return x;
+}
+
+/**
+ * @brief Saturate a 64 bit value to Q31
+ */
+static inline q31_t DspSat32(int64_t x){
+	if(x > INT32_MAX){
+		return INT32_MAX;
+	}
+	if(x < INT32_MIN){
+		return INT32_MIN;
+	}
+	return x;
+}
+
+/**
+ * @brief High word of a signed 32x32 product (single mulh instruction)
+ */
+static inline int32_t DspMulh(int32_t a, int32_t b){
+	return ((int64_t)a * b) >> 32;
+}
+
+/**
+ * @brief Integer square root of a 64 bit value
+ */
+static inline uint32_t DspSqrt64(uint64_t x){
+	uint64_t res = 0;
+	uint64_t bit = 1ULL << 62;
+	while(bit > x){
+		bit >>= 2;
+	}
+	while(bit != 0){
+		if(x >= res + bit){
+			x -= res + bit;
+			res = (res >> 1) + bit;
+		}
+		else{
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+	return res;
+}
+
+/**
+ * @brief Convert a raw 12 bit ADC value to Q15 (centered at mid-scale)
+ */
+static inline q15_t DspAdcToQ15(uint16_t raw){
+	return ((int32_t)raw - 2048) << 4;
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef DSP_MATH_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,144 @@
+#ifndef DSP_ORDER_STAT_H
+#define DSP_ORDER_STAT_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_DSP Drivers DSP
+ ** @{ */
+/** \addtogroup DSP_Order_Stat DSP Order Statistics
+ ** @{ */
+
+/** \brief Sliding window order statistics: median, trimmed mean, min and max.
+ *
+ * Robust filters for spiky sensors (HC-SR04 echoes, HX711 readings, ADC 
+ * samples). The window is kept split at a given rank in two heaps (a max-heap 
+ * with the smallest values and a min-heap with the rest), so each new sample 
+ * costs O(log n) instead of sorting the window. Min and max use monotonic 
+ * queues (O(1) amortized). All memory is inside the filter instance.
+ * 
+ * Until the window is full the statistics are computed over the samples 
+ * received so far.
+ * 
+ * Example (median of the last 5 distance readings):
+ * @code
+ * static dsp_order_stat_t dist_filter;
+ * DspOrderStatInit(&dist_filter, 5, 0);
+ * ...
+ * DspOrderStatUpdate(&dist_filter, HcSr04ReadDistanceInCentimeters());
+ * distance = DspOrderStatMedian(&dist_filter);
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * | 19/10/2026 | Wrap safe window slots and min/max expiry      						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#define DSP_ORDER_MAX_WINDOW	128		/*!< Largest window */
+/*==================[typedef]================================================*/
+/**
+ * @brief Window split at a rank: lo holds the smallest values (max-heap), hi the rest (min-heap)
+ */
+typedef struct {
+	uint8_t lo[DSP_ORDER_MAX_WINDOW];	/*!< Max-heap of window slots */
+	uint8_t hi[DSP_ORDER_MAX_WINDOW];	/*!< Min-heap of window slots */
+	uint8_t pos[DSP_ORDER_MAX_WINDOW];	/*!< Heap position of each slot (bit 7 set: in hi) */
+	uint8_t lo_len;						/*!< Values in lo */
+	uint8_t hi_len;						/*!< Values in hi */
+	int64_t lo_sum;						/*!< Sum of values in lo */
+} dsp_order_split_t;
+
+/**
+ * @brief Order statistics filter instance
+ */
+typedef struct {
+	int32_t values[DSP_ORDER_MAX_WINDOW];	/*!< Window (ring buffer) */
+	uint8_t window;							/*!< Window length */
+	uint8_t trim;							/*!< Values discarded at each end for the trimmed mean */
+	uint8_t count;							/*!< Values in window */
+	uint8_t slot;							/*!< Window slot of the next sample */
+	uint32_t seq;							/*!< Samples received (wraps, only differences are used) */
+	int64_t sum;							/*!< Sum of values in window */
+	dsp_order_split_t median;				/*!< Split at the middle */
+	dsp_order_split_t trim_lo;				/*!< Split at trim (trimmed mean only) */
+	dsp_order_split_t trim_hi;				/*!< Split at window - trim (trimmed mean only) */
+	uint32_t min_q[DSP_ORDER_MAX_WINDOW];	/*!< Increasing values queue (sample numbers) */
+	uint32_t max_q[DSP_ORDER_MAX_WINDOW];	/*!< Decreasing values queue (sample numbers) */
+	uint8_t min_head, min_len;				/*!< Min queue */
+	uint8_t max_head, max_len;				/*!< Max queue */
+} dsp_order_stat_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Order statistics filter initialization
+ * 
+ * @param f Filter instance
+ * @param window Window length (up to DSP_ORDER_MAX_WINDOW)
+ * @param trim Values discarded at each end for the trimmed mean (less than window/2)
+ */
+void DspOrderStatInit(dsp_order_stat_t *f, uint8_t window, uint8_t trim);
+
+/**
+ * @brief Add a sample to the window (the oldest one leaves when the window is full)
+ * 
+ * @param f Filter instance
+ * @param x New sample
+ */
+void DspOrderStatUpdate(dsp_order_stat_t *f, int32_t x);
+
+/**
+ * @brief Sliding median filter over a block of raw ADC samples
+ * 
+ * @param f Filter instance
+ * @param in ADC samples
+ * @param out Median after each sample (can be the same as in)
+ * @param len Number of samples
+ */
+void DspOrderStatMedianRaw(dsp_order_stat_t *f, const uint16_t *in, uint16_t *out, uint32_t len);
+
+/**
+ * @brief Median of the window (mean of the two middle values for even counts)
+ * 
+ * @param f Filter instance
+ * @return int32_t Median
+ */
+int32_t DspOrderStatMedian(dsp_order_stat_t *f);
+
+/**
+ * @brief Mean of the window without its trim smallest and trim largest values
+ * 
+ * @param f Filter instance
+ * @return int32_t Trimmed mean
+ */
+int32_t DspOrderStatTrimmedMean(dsp_order_stat_t *f);
+
+/**
+ * @brief Smallest value in the window
+ * 
+ * @param f Filter instance
+ * @return int32_t Min
+ */
+int32_t DspOrderStatMin(dsp_order_stat_t *f);
+
+/**
+ * @brief Largest value in the window
+ * 
+ * @param f Filter instance
+ * @return int32_t Max
+ */
+int32_t DspOrderStatMax(dsp_order_stat_t *f);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef DSP_ORDER_STAT_H */
+
+/*==================[end of file]============================================*/
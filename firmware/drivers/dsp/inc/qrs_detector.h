@@ -0,0 +1,136 @@
+#ifndef QRS_DETECTOR_H
+#define QRS_DETECTOR_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_DSP Drivers DSP
+ ** @{ */
+/** \addtogroup QRS_Detector QRS Detector
+ ** @{ */
+
+/** \brief Streaming QRS detector and heart rate meter for ECG signals.
+ *
+ * Fixed point implementation of the Pan-Tompkins algorithm: 5-15Hz band-pass,
+ * derivative, squaring, 150ms moving window integration and adaptive signal/noise 
+ * thresholds with 200ms refractory period and search-back for missed beats.
+ * 
+ * Samples are processed in blocks as they are acquired. Each detected beat 
+ * is reported with its sample index, RR interval and heart rate. A beat is 
+ * decided when the integrated signal falls to half its peak, so it is reported 
+ * within QRS_MAX_LATENCY_MS of its R wave plus the block length (beats 
+ * recovered by search-back are reported when the search-back triggers).
+ * 
+ * @note The first 2 seconds are used to learn the signal and noise levels, no 
+ * beats are reported during that time.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * | 19/10/2026 | Integration window sized for 1000Hz, host replay test					|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include "dsp_math.h"
+#include "dsp_filter.h"
+/*==================[macros]=================================================*/
+#define QRS_MWI_MAX			150		/*!< Max integration window length (samples), 150ms at 1000Hz */
+#define QRS_RR_AVG_LEN		8		/*!< Beats averaged for heart rate */
+#define QRS_MAX_LATENCY_MS	400		/*!< Max delay between R wave and its report (not search-back) */
+/*==================[typedef]================================================*/
+/**
+ * @brief Detected beat
+ */
+typedef struct {
+	uint32_t sample;		/*!< Sample index of the R wave (counted from QrsInit) */
+	uint32_t time_ms;		/*!< Time of the R wave (ms from QrsInit) */
+	uint16_t rr_ms;			/*!< Interval from previous beat in ms (0 for the first beat) */
+	uint16_t hr_bpm;		/*!< Heart rate averaged over the last QRS_RR_AVG_LEN beats */
+} qrs_beat_t;
+
+/**
+ * @brief QRS detector instance (all the state is inside, no allocation needed)
+ */
+typedef struct {
+	uint16_t fs;							/*!< Sample frequency (Hz) */
+	uint32_t n;								/*!< Samples processed */
+	dsp_biquad_coeffs_t bp_coeffs[2];		/*!< Band-pass (high-pass + low-pass) */
+	dsp_biquad_state_t bp_state[2];			/*!< Band-pass state */
+	dsp_biquad_t bp;						/*!< Band-pass filter */
+	q15_t der[4];							/*!< Derivative delay line */
+	q15_t bp_hist[QRS_MWI_MAX];				/*!< Band-pass output history (R wave location) */
+	uint32_t sq_hist[QRS_MWI_MAX];			/*!< Squared signal history (integration window) */
+	uint16_t mwi_len;						/*!< Integration window length */
+	uint16_t hist_pos;						/*!< History write position */
+	uint32_t mwi_sum;						/*!< Integration window sum */
+	uint32_t mwi_prev;						/*!< Previous integrated value */
+	uint32_t peak;							/*!< Current integrated peak */
+	uint32_t r_n;							/*!< R wave sample index for current peak */
+	uint32_t spki;							/*!< Signal peak level */
+	uint32_t npki;							/*!< Noise peak level */
+	uint32_t th1;							/*!< Primary threshold */
+	uint32_t th2;							/*!< Search-back threshold */
+	uint32_t sb_peak;						/*!< Largest rejected peak since last beat */
+	uint32_t sb_r_n;						/*!< R wave index for sb_peak */
+	uint32_t last_beat_n;					/*!< Sample index of last beat */
+	uint16_t rr[QRS_RR_AVG_LEN];			/*!< Last RR intervals (samples) */
+	uint8_t rr_pos;							/*!< RR write position */
+	uint8_t rr_count;						/*!< Valid RR intervals */
+	uint32_t rr_sum;						/*!< Sum of valid RR intervals */
+	uint32_t beats;							/*!< Beats detected */
+} qrs_detector_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief QRS detector initialization
+ * 
+ * @note Uses floating point to design the band-pass filter (init only).
+ * 
+ * @param qrs Detector instance
+ * @param fs Sample frequency (Hz), from 100Hz to 1000Hz
+ */
+void QrsInit(qrs_detector_t *qrs, uint16_t fs);
+
+/**
+ * @brief Process a block of Q15 ECG samples
+ * 
+ * @param qrs Detector instance
+ * @param in ECG samples (Q15)
+ * @param len Number of samples
+ * @param beats Array where detected beats are stored
+ * @param max_beats Size of beats array
+ * @return uint8_t Number of beats detected in this block
+ */
+uint8_t QrsProcessQ15(qrs_detector_t *qrs, const q15_t *in, uint32_t len, qrs_beat_t *beats, uint8_t max_beats);
+
+/**
+ * @brief Process a block of raw ADC samples (12 bits, as read from analog_io_mcu)
+ * 
+ * @param qrs Detector instance
+ * @param raw Raw ADC samples
+ * @param len Number of samples
+ * @param beats Array where detected beats are stored
+ * @param max_beats Size of beats array
+ * @return uint8_t Number of beats detected in this block
+ */
+uint8_t QrsProcessRaw(qrs_detector_t *qrs, const uint16_t *raw, uint32_t len, qrs_beat_t *beats, uint8_t max_beats);
+
+/**
+ * @brief Current heart rate
+ * 
+ * @param qrs Detector instance
+ * @return uint16_t Heart rate in beats per minute (0 until two beats are detected)
+ */
+uint16_t QrsHeartRate(qrs_detector_t *qrs);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef QRS_DETECTOR_H */
+
+/*==================[end of file]============================================*/
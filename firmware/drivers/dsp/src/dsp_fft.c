@@ -0,0 +1,196 @@
+/**
+ * @file dsp_fft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "dsp_fft.h"
+#include <math.h>
+/*==================[macros and definitions]=================================*/
+#define FFT_FULL_SCALE_LOG2	30		/*!< log2 of the magnitude of a full scale sine */
+#define FFT_DB_STEPS		3083	/*!< 2 * 20 * log10(2) in Q8: log2 (Q8) to 0.5dB steps (Q16) */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static int32_t fft_log2_q8(uint32_t x);
+/*==================[internal data definition]===============================*/
+static dsp_cq31_t fft_twiddle[DSP_FFT_MAX_SIZE / 2];	/*!< cos and sin of 2*pi*k/DSP_FFT_MAX_SIZE */
+static bool fft_twiddle_ready = false;
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Base 2 logarithm with 8 fractional bits (x > 0)
+ */
+static int32_t fft_log2_q8(uint32_t x){
+	int32_t e = 31 - __builtin_clz(x);
+	/* Mantissa in [1, 2) as Q30 */
+	uint32_t m = (e > 30) ? x >> (e - 30) : x << (30 - e);
+	int32_t res = e << 8;
+	/* Each squaring of the mantissa gives one more fractional bit */
+	for(int8_t i = 7; i >= 0; i--){
+		m = ((uint64_t)m * m) >> 30;
+		if(m >= (2UL << 30)){
+			m >>= 1;
+			res |= 1 << i;
+		}
+	}
+	return res;
+}
+
+/*==================[external functions definition]==========================*/
+bool DspFftInit(dsp_fft_t *fft, uint16_t n, dsp_window_t window){
+	if(n < DSP_FFT_MIN_SIZE || n > DSP_FFT_MAX_SIZE || (n & (n - 1)) != 0){
+		return false;
+	}
+	if(!fft_twiddle_ready){
+		for(uint16_t k = 0; k < DSP_FFT_MAX_SIZE / 2; k++){
+			double ph = 2 * M_PI * k / DSP_FFT_MAX_SIZE;
+			fft_twiddle[k].re = DspSat32(llround(cos(ph) * Q31_ONE));
+			fft_twiddle[k].im = DspSat32(llround(sin(ph) * Q31_ONE));
+		}
+		fft_twiddle_ready = true;
+	}
+	fft->n = n;
+	fft->log2n = 31 - __builtin_clz(n);
+	double sum = 0;
+	for(uint16_t i = 0; i < n / 2; i++){
+		double w;
+		switch(window){
+		case DSP_WINDOW_HANN:
+			w = 0.5 - 0.5 * cos(2 * M_PI * i / (n - 1));
+			break;
+		case DSP_WINDOW_HAMMING:
+			w = 0.54 - 0.46 * cos(2 * M_PI * i / (n - 1));
+			break;
+		default:
+			w = 1.0;
+			break;
+		}
+		fft->window[i] = Q15(w);
+		sum += 2 * w;
+	}
+	fft->gain = Q15(sum / n);
+	return true;
+}
+
+void DspFft(dsp_fft_t *fft, dsp_cq31_t *buf){
+	const uint16_t n = fft->n;
+	/* Bit reversed reordering */
+	for(uint16_t i = 1, j = 0; i < n; i++){
+		uint16_t bit = n >> 1;
+		for(; j & bit; bit >>= 1){
+			j ^= bit;
+		}
+		j ^= bit;
+		if(i < j){
+			dsp_cq31_t tmp = buf[i];
+			buf[i] = buf[j];
+			buf[j] = tmp;
+		}
+	}
+	/* Butterflies, mulh by a Q31 twiddle halves the product and a is halved 
+	 * explicitly, so every stage scales by 1/2 and can not overflow */
+	for(uint16_t len = 2; len <= n; len <<= 1){
+		const uint16_t half = len >> 1;
+		const uint16_t step = DSP_FFT_MAX_SIZE / len;
+		for(uint16_t k = 0; k < half; k++){
+			const dsp_cq31_t w = fft_twiddle[k * step];
+			for(uint16_t i = k; i < n; i += len){
+				dsp_cq31_t *a = &buf[i];
+				dsp_cq31_t *b = &buf[i + half];
+				/* b * (cos - j sin) */
+				int32_t tr = DspMulh(b->re, w.re) + DspMulh(b->im, w.im);
+				int32_t ti = DspMulh(b->im, w.re) - DspMulh(b->re, w.im);
+				int32_t ar = a->re >> 1;
+				int32_t ai = a->im >> 1;
+				a->re = ar + tr;
+				a->im = ai + ti;
+				b->re = ar - tr;
+				b->im = ai - ti;
+			}
+		}
+	}
+}
+
+void DspFftRaw(dsp_fft_t *fft, const uint16_t *raw, dsp_cq31_t *buf){
+	const uint16_t n = fft->n;
+	for(uint16_t i = 0; i < n / 2; i++){
+		int32_t w = (int32_t)fft->window[i] << 16;
+		buf[i].re = DspMulh((int32_t)DspAdcToQ15(raw[i]) << 16, w) << 1;
+		buf[i].im = 0;
+		buf[n - 1 - i].re = DspMulh((int32_t)DspAdcToQ15(raw[n - 1 - i]) << 16, w) << 1;
+		buf[n - 1 - i].im = 0;
+	}
+	DspFft(fft, buf);
+}
+
+void DspFftQ15(dsp_fft_t *fft, const q15_t *in, dsp_cq31_t *buf){
+	const uint16_t n = fft->n;
+	for(uint16_t i = 0; i < n / 2; i++){
+		int32_t w = (int32_t)fft->window[i] << 16;
+		buf[i].re = DspMulh((int32_t)in[i] << 16, w) << 1;
+		buf[i].im = 0;
+		buf[n - 1 - i].re = DspMulh((int32_t)in[n - 1 - i] << 16, w) << 1;
+		buf[n - 1 - i].im = 0;
+	}
+	DspFft(fft, buf);
+}
+
+void DspFftMagnitude(dsp_fft_t *fft, const dsp_cq31_t *buf, uint32_t *mag){
+	for(uint16_t k = 0; k < fft->n / 2; k++){
+		uint64_t p = (int64_t)buf[k].re * buf[k].re + (int64_t)buf[k].im * buf[k].im;
+		uint64_t m = ((uint64_t)DspSqrt64(p) << 15) / fft->gain;
+		mag[k] = (m > UINT32_MAX) ? UINT32_MAX : m;
+	}
+}
+
+uint32_t DspFftDominant(dsp_fft_t *fft, const uint32_t *mag, uint32_t fs){
+	const uint16_t bins = fft->n / 2;
+	uint16_t k = 1;
+	for(uint16_t i = 2; i < bins; i++){
+		if(mag[i] > mag[k]){
+			k = i;
+		}
+	}
+	/* Fractional offset of the peak (Q16). The vertex is computed apart from 
+	 * the scaling: the curvature reaches 2^32 for a full scale tone */
+	int64_t frac_q16 = 0;
+	if(k < bins - 1){
+		/* Vertex of the parabola through the peak and its neighbours */
+		int64_t l = mag[k - 1], c = mag[k], r = mag[k + 1];
+		int64_t den = 2 * (2 * c - l - r);
+		if(den != 0){
+			frac_q16 = ((r - l) * 65536) / den;
+		}
+	}
+	return ((((int64_t)k << 16) + frac_q16) * fs * 1000) / ((int64_t)fft->n << 16);
+}
+
+uint16_t DspFftPack(dsp_fft_t *fft, const uint32_t *mag, uint32_t fs, uint8_t *out){
+	const uint16_t bins = fft->n / 2;
+	out[0] = 'S';
+	out[1] = 'P';
+	out[2] = bins & 0xFF;
+	out[3] = bins >> 8;
+	out[4] = fs & 0xFF;
+	out[5] = (fs >> 8) & 0xFF;
+	out[6] = (fs >> 16) & 0xFF;
+	out[7] = fs >> 24;
+	for(uint16_t k = 0; k < bins; k++){
+		int32_t steps = 255;
+		if(mag[k] != 0){
+			steps = (((FFT_FULL_SCALE_LOG2 << 8) - fft_log2_q8(mag[k])) * FFT_DB_STEPS) >> 16;
+		}
+		out[DSP_FFT_PACK_HEADER + k] = (steps < 0) ? 0 : (steps > 255) ? 255 : steps;
+	}
+	return DSP_FFT_PACK_HEADER + bins;
+}
+
+/*==================[end of file]============================================*/
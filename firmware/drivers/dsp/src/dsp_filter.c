@@ -0,0 +1,228 @@
+/**
+ * @file dsp_filter.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "dsp_filter.h"
+#include <string.h>
+#include <math.h>
+/*==================[macros and definitions]=================================*/
+#define BIQUAD_COEF_SHIFT	2		/*!< Q30 coefficients x Q31 data with mulh gives Q29 */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static void biquad_set(dsp_biquad_coeffs_t *coeffs, double b0, double b1, double b2, double a0, double a1, double a2);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Normalize (by a0) and quantize biquad coefficients to Q30
+ */
+static void biquad_set(dsp_biquad_coeffs_t *coeffs, double b0, double b1, double b2, double a0, double a1, double a2){
+	coeffs->b0 = DSP_BIQUAD_COEF(b0 / a0);
+	coeffs->b1 = DSP_BIQUAD_COEF(b1 / a0);
+	coeffs->b2 = DSP_BIQUAD_COEF(b2 / a0);
+	coeffs->a1 = DSP_BIQUAD_COEF(a1 / a0);
+	coeffs->a2 = DSP_BIQUAD_COEF(a2 / a0);
+}
+
+/*==================[external functions definition]==========================*/
+void DspFirQ15Init(dsp_fir_q15_t *fir, const q15_t *coeffs, uint16_t taps, q15_t *state){
+	fir->coeffs = coeffs;
+	fir->state = state;
+	fir->taps = taps;
+	fir->pos = 0;
+	memset(state, 0, 2 * taps * sizeof(q15_t));
+}
+
+void DspFirQ15(dsp_fir_q15_t *fir, const q15_t *in, q15_t *out, uint32_t len){
+	const uint16_t taps = fir->taps;
+	q15_t *state = fir->state;
+	uint16_t pos = fir->pos;
+	for(uint32_t n = 0; n < len; n++){
+		/* Each sample is stored twice, so the last taps samples are always 
+		 * contiguous (newest at state[pos + taps]) and no wrap-around is needed */
+		state[pos] = in[n];
+		state[pos + taps] = in[n];
+		const q15_t *h = fir->coeffs;
+		const q15_t *x = &state[pos + taps];
+		int32_t acc = 1 << 14;		/* rounding */
+		uint16_t k = taps >> 2;
+		while(k--){
+			acc += h[0] * x[0];
+			acc += h[1] * x[-1];
+			acc += h[2] * x[-2];
+			acc += h[3] * x[-3];
+			h += 4;
+			x -= 4;
+		}
+		k = taps & 3;
+		while(k--){
+			acc += *h++ * *x--;
+		}
+		out[n] = DspSat16(acc >> 15);
+		if(++pos == taps){
+			pos = 0;
+		}
+	}
+	fir->pos = pos;
+}
+
+void DspFirQ31Init(dsp_fir_q31_t *fir, const q31_t *coeffs, uint16_t taps, q31_t *state){
+	fir->coeffs = coeffs;
+	fir->state = state;
+	fir->taps = taps;
+	fir->pos = 0;
+	memset(state, 0, 2 * taps * sizeof(q31_t));
+}
+
+void DspFirQ31(dsp_fir_q31_t *fir, const q31_t *in, q31_t *out, uint32_t len){
+	const uint16_t taps = fir->taps;
+	q31_t *state = fir->state;
+	uint16_t pos = fir->pos;
+	for(uint32_t n = 0; n < len; n++){
+		state[pos] = in[n];
+		state[pos + taps] = in[n];
+		const q31_t *h = fir->coeffs;
+		const q31_t *x = &state[pos + taps];
+		/* Q30 accumulator, wrap-around in partial sums is harmless */
+		uint32_t acc = 0;
+		uint16_t k = taps >> 2;
+		while(k--){
+			acc += DspMulh(h[0], x[0]);
+			acc += DspMulh(h[1], x[-1]);
+			acc += DspMulh(h[2], x[-2]);
+			acc += DspMulh(h[3], x[-3]);
+			h += 4;
+			x -= 4;
+		}
+		k = taps & 3;
+		while(k--){
+			acc += DspMulh(*h++, *x--);
+		}
+		out[n] = DspSat32((int64_t)(int32_t)acc << 1);
+		if(++pos == taps){
+			pos = 0;
+		}
+	}
+	fir->pos = pos;
+}
+
+void DspBiquadInit(dsp_biquad_t *bq, const dsp_biquad_coeffs_t *coeffs, uint8_t stages, dsp_biquad_state_t *state){
+	bq->coeffs = coeffs;
+	bq->state = state;
+	bq->stages = stages;
+	memset(state, 0, stages * sizeof(dsp_biquad_state_t));
+}
+
+void DspBiquadQ31(dsp_biquad_t *bq, const q31_t *in, q31_t *out, uint32_t len){
+	const q31_t *src = in;
+	for(uint8_t s = 0; s < bq->stages; s++){
+		const dsp_biquad_coeffs_t c = bq->coeffs[s];
+		dsp_biquad_state_t *st = &bq->state[s];
+		q31_t x1 = st->x1, x2 = st->x2, y1 = st->y1, y2 = st->y2;
+		for(uint32_t n = 0; n < len; n++){
+			q31_t x0 = src[n];
+			uint32_t acc = DspMulh(c.b0, x0);
+			acc += DspMulh(c.b1, x1);
+			acc += DspMulh(c.b2, x2);
+			acc -= DspMulh(c.a1, y1);
+			acc -= DspMulh(c.a2, y2);
+			q31_t y0 = DspSat32((int64_t)(int32_t)acc << BIQUAD_COEF_SHIFT);
+			x2 = x1;
+			x1 = x0;
+			y2 = y1;
+			y1 = y0;
+			out[n] = y0;
+		}
+		st->x1 = x1;
+		st->x2 = x2;
+		st->y1 = y1;
+		st->y2 = y2;
+		/* Next stages work in-place on the output */
+		src = out;
+	}
+}
+
+void DspBiquadQ15(dsp_biquad_t *bq, const q15_t *in, q15_t *out, uint32_t len){
+	for(uint32_t n = 0; n < len; n++){
+		q31_t x = (q31_t)in[n] << 16;
+		for(uint8_t s = 0; s < bq->stages; s++){
+			const dsp_biquad_coeffs_t *c = &bq->coeffs[s];
+			dsp_biquad_state_t *st = &bq->state[s];
+			uint32_t acc = DspMulh(c->b0, x);
+			acc += DspMulh(c->b1, st->x1);
+			acc += DspMulh(c->b2, st->x2);
+			acc -= DspMulh(c->a1, st->y1);
+			acc -= DspMulh(c->a2, st->y2);
+			q31_t y = DspSat32((int64_t)(int32_t)acc << BIQUAD_COEF_SHIFT);
+			st->x2 = st->x1;
+			st->x1 = x;
+			st->y2 = st->y1;
+			st->y1 = y;
+			x = y;
+		}
+		out[n] = DspSat16(((int64_t)x + (1 << 15)) >> 16);
+	}
+}
+
+void DspBiquadLowpass(dsp_biquad_coeffs_t *coeffs, float fc, float fs, float q){
+	double w0 = 2 * M_PI * fc / fs;
+	double alpha = sin(w0) / (2 * q);
+	double cw = cos(w0);
+	biquad_set(coeffs, (1 - cw) / 2, 1 - cw, (1 - cw) / 2, 1 + alpha, -2 * cw, 1 - alpha);
+}
+
+void DspBiquadHighpass(dsp_biquad_coeffs_t *coeffs, float fc, float fs, float q){
+	double w0 = 2 * M_PI * fc / fs;
+	double alpha = sin(w0) / (2 * q);
+	double cw = cos(w0);
+	biquad_set(coeffs, (1 + cw) / 2, -(1 + cw), (1 + cw) / 2, 1 + alpha, -2 * cw, 1 - alpha);
+}
+
+void DspBiquadNotch(dsp_biquad_coeffs_t *coeffs, float f0, float fs, float q){
+	double w0 = 2 * M_PI * f0 / fs;
+	double alpha = sin(w0) / (2 * q);
+	double cw = cos(w0);
+	biquad_set(coeffs, 1, -2 * cw, 1, 1 + alpha, -2 * cw, 1 - alpha);
+}
+
+void DspDcBlockInit(dsp_dc_block_t *dc, q15_t r){
+	dc->r = r;
+	dc->x1 = 0;
+	dc->y1 = 0;
+}
+
+void DspDcBlockQ15(dsp_dc_block_t *dc, const q15_t *in, q15_t *out, uint32_t len){
+	q15_t x1 = dc->x1;
+	int32_t y1 = dc->y1;
+	for(uint32_t n = 0; n < len; n++){
+		q15_t x0 = in[n];
+		/* y in Q30: (x0 - x1) << 15 + r * y1 */
+		int64_t acc = ((int64_t)(x0 - x1) << 15) + (((int64_t)dc->r * y1) >> 15);
+		y1 = DspSat32(acc);
+		if(y1 > (INT16_MAX << 15)){
+			y1 = INT16_MAX << 15;
+		} else if(y1 < (INT16_MIN * (1 << 15))){
+			y1 = INT16_MIN * (1 << 15);
+		}
+		x1 = x0;
+		out[n] = (y1 + (1 << 14)) >> 15;
+	}
+	dc->x1 = x1;
+	dc->y1 = y1;
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
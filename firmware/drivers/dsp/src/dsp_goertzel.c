@@ -0,0 +1,160 @@
+/**
+ * @file dsp_goertzel.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "dsp_goertzel.h"
+#include <string.h>
+#include <math.h>
+/*==================[macros and definitions]=================================*/
+#define GOERTZEL_COEF_SHIFT	30		/*!< Coefficient fractional bits */
+#define GOERTZEL_CHUNK		32		/*!< Raw samples converted per step */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static void goertzel_window(dsp_goertzel_t *g);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Close an analysis window: tone amplitude and power ratio, smoothing 
+ * and detection, then clear the state for the next window
+ */
+static void goertzel_window(dsp_goertzel_t *g){
+	const uint32_t n = g->n;
+	/* n^2 times the signal variance (DC removed) */
+	int64_t var = (int64_t)n * g->energy - (int64_t)g->sum * g->sum;
+	for(uint8_t t = 0; t < g->tones; t++){
+		dsp_goertzel_tone_t *tone = &g->tone[t];
+		/* |X|^2 = s1^2 + s2^2 - 2cos(w) s1 s2 */
+		int64_t p = (int64_t)tone->s1 * tone->s1 + (int64_t)tone->s2 * tone->s2
+			- (((int64_t)tone->coeff * tone->s1) >> GOERTZEL_COEF_SHIFT) * tone->s2;
+		if(p < 0){
+			p = 0;
+		}
+		/* A sine of amplitude A gives |X| = A n / 2 */
+		int32_t amplitude = (2 * DspSqrt64(p)) / n;
+		/* Sine power (A^2 / 2) over signal variance */
+		int32_t ratio = 0;
+		if((var >> 15) > 0){
+			int64_t r = (2 * p) / (var >> 15);
+			ratio = (r > INT16_MAX) ? INT16_MAX : r;
+		}
+		amplitude = DspSat16(amplitude);
+		tone->amplitude += ((amplitude - tone->amplitude) * g->alpha) >> 15;
+		tone->ratio += ((ratio - tone->ratio) * g->alpha) >> 15;
+		if(g->windows == 0){
+			tone->amplitude = amplitude;
+			tone->ratio = ratio;
+		}
+		if(tone->ratio >= g->on){
+			tone->detected = true;
+		}
+		else if(tone->ratio < g->off){
+			tone->detected = false;
+		}
+		tone->s1 = 0;
+		tone->s2 = 0;
+	}
+	g->count = 0;
+	g->sum = 0;
+	g->energy = 0;
+	g->windows++;
+}
+
+/*==================[external functions definition]==========================*/
+void DspGoertzelInit(dsp_goertzel_t *g, const float *frec, uint8_t tones, float fs, uint16_t n, q15_t alpha){
+	memset(g, 0, sizeof(dsp_goertzel_t));
+	if(tones > DSP_GOERTZEL_MAX_TONES){
+		tones = DSP_GOERTZEL_MAX_TONES;
+	}
+	if(n > DSP_GOERTZEL_MAX_N){
+		n = DSP_GOERTZEL_MAX_N;
+	}
+	for(uint8_t t = 0; t < tones; t++){
+		double c = 2 * cos(2 * M_PI * frec[t] / fs);
+		g->tone[t].coeff = DspSat32(llround(c * (1 << GOERTZEL_COEF_SHIFT)));
+	}
+	g->tones = tones;
+	g->n = n;
+	g->alpha = alpha;
+	g->on = INT16_MAX;
+	g->off = INT16_MAX;
+}
+
+void DspGoertzelDetection(dsp_goertzel_t *g, q15_t on, q15_t off){
+	g->on = on;
+	g->off = off;
+}
+
+uint8_t DspGoertzelQ15(dsp_goertzel_t *g, const q15_t *in, uint32_t len){
+	uint8_t windows = 0;
+	while(len > 0){
+		uint32_t chunk = g->n - g->count;
+		if(chunk > len){
+			chunk = len;
+		}
+		for(uint8_t t = 0; t < g->tones; t++){
+			dsp_goertzel_tone_t *tone = &g->tone[t];
+			const int32_t c = tone->coeff;
+			int32_t s1 = tone->s1, s2 = tone->s2;
+			for(uint32_t i = 0; i < chunk; i++){
+				int32_t s0 = in[i] + (int32_t)(((int64_t)c * s1) >> GOERTZEL_COEF_SHIFT) - s2;
+				s2 = s1;
+				s1 = s0;
+			}
+			tone->s1 = s1;
+			tone->s2 = s2;
+		}
+		for(uint32_t i = 0; i < chunk; i++){
+			g->sum += in[i];
+			g->energy += (int32_t)in[i] * in[i];
+		}
+		g->count += chunk;
+		in += chunk;
+		len -= chunk;
+		if(g->count == g->n){
+			goertzel_window(g);
+			windows++;
+		}
+	}
+	return windows;
+}
+
+uint8_t DspGoertzelRaw(dsp_goertzel_t *g, const uint16_t *raw, uint32_t len){
+	q15_t in[GOERTZEL_CHUNK];
+	uint8_t windows = 0;
+	while(len > 0){
+		uint32_t chunk = (len > GOERTZEL_CHUNK) ? GOERTZEL_CHUNK : len;
+		for(uint32_t i = 0; i < chunk; i++){
+			in[i] = DspAdcToQ15(raw[i]);
+		}
+		windows += DspGoertzelQ15(g, in, chunk);
+		raw += chunk;
+		len -= chunk;
+	}
+	return windows;
+}
+
+q15_t DspGoertzelAmplitude(dsp_goertzel_t *g, uint8_t tone){
+	return g->tone[tone].amplitude;
+}
+
+q15_t DspGoertzelRatio(dsp_goertzel_t *g, uint8_t tone){
+	return g->tone[tone].ratio;
+}
+
+bool DspGoertzelDetected(dsp_goertzel_t *g, uint8_t tone){
+	return g->tone[tone].detected;
+}
+
+/*==================[end of file]============================================*/
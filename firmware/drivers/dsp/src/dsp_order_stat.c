@@ -0,0 +1,282 @@
+/**
+ * @file dsp_order_stat.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "dsp_order_stat.h"
+#include <stdbool.h>
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define SPLIT_HI	0x80		/*!< Position flag: slot is in the hi heap */
+#define SPLIT_IDX	0x7F		/*!< Position mask: index inside the heap */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static void split_place(dsp_order_split_t *s, bool hi, uint8_t idx, uint8_t slot);
+static void split_sift(const int32_t *v, dsp_order_split_t *s, bool hi, uint8_t idx);
+static void split_push(const int32_t *v, dsp_order_split_t *s, bool hi, uint8_t slot);
+static uint8_t split_pop(const int32_t *v, dsp_order_split_t *s, bool hi);
+static void split_balance(const int32_t *v, dsp_order_split_t *s, uint8_t target);
+static void split_insert(const int32_t *v, dsp_order_split_t *s, uint8_t slot, uint8_t target);
+static void split_replace(const int32_t *v, dsp_order_split_t *s, uint8_t slot, int32_t old, uint8_t target);
+static uint8_t order_slot(const dsp_order_stat_t *f, uint32_t q);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Store a slot at a heap position
+ */
+static void split_place(dsp_order_split_t *s, bool hi, uint8_t idx, uint8_t slot){
+	if(hi){
+		s->hi[idx] = slot;
+		s->pos[slot] = idx | SPLIT_HI;
+	}
+	else{
+		s->lo[idx] = slot;
+		s->pos[slot] = idx;
+	}
+}
+
+/**
+ * @brief Move a heap entry up or down to its place (lo: max-heap, hi: min-heap)
+ */
+static void split_sift(const int32_t *v, dsp_order_split_t *s, bool hi, uint8_t idx){
+	uint8_t *heap = hi ? s->hi : s->lo;
+	uint16_t len = hi ? s->hi_len : s->lo_len;
+	uint8_t slot = heap[idx];
+	int32_t x = v[slot];
+	while(idx > 0){
+		uint8_t parent = (idx - 1) >> 1;
+		int32_t p = v[heap[parent]];
+		if(hi ? (x >= p) : (x <= p)){
+			break;
+		}
+		split_place(s, hi, idx, heap[parent]);
+		idx = parent;
+	}
+	while(1){
+		uint16_t child = 2 * idx + 1;
+		if(child >= len){
+			break;
+		}
+		if(child + 1 < len && (hi ? (v[heap[child + 1]] < v[heap[child]]) : (v[heap[child + 1]] > v[heap[child]]))){
+			child++;
+		}
+		int32_t c = v[heap[child]];
+		if(hi ? (c >= x) : (c <= x)){
+			break;
+		}
+		split_place(s, hi, idx, heap[child]);
+		idx = child;
+	}
+	split_place(s, hi, idx, slot);
+}
+
+/**
+ * @brief Add a slot to a heap
+ */
+static void split_push(const int32_t *v, dsp_order_split_t *s, bool hi, uint8_t slot){
+	uint8_t idx;
+	if(hi){
+		idx = s->hi_len++;
+	}
+	else{
+		idx = s->lo_len++;
+		s->lo_sum += v[slot];
+	}
+	split_place(s, hi, idx, slot);
+	split_sift(v, s, hi, idx);
+}
+
+/**
+ * @brief Remove the top slot of a heap
+ */
+static uint8_t split_pop(const int32_t *v, dsp_order_split_t *s, bool hi){
+	uint8_t *heap = hi ? s->hi : s->lo;
+	uint8_t top = heap[0];
+	uint8_t len;
+	if(hi){
+		len = --s->hi_len;
+	}
+	else{
+		len = --s->lo_len;
+		s->lo_sum -= v[top];
+	}
+	if(len > 0){
+		split_place(s, hi, 0, heap[len]);
+		split_sift(v, s, hi, 0);
+	}
+	return top;
+}
+
+/**
+ * @brief Restore lo size to target and every lo value <= every hi value
+ */
+static void split_balance(const int32_t *v, dsp_order_split_t *s, uint8_t target){
+	while(s->lo_len > target){
+		split_push(v, s, true, split_pop(v, s, false));
+	}
+	while(s->lo_len < target && s->hi_len > 0){
+		split_push(v, s, false, split_pop(v, s, true));
+	}
+	while(s->lo_len > 0 && s->hi_len > 0 && v[s->lo[0]] > v[s->hi[0]]){
+		uint8_t a = s->lo[0];
+		uint8_t b = s->hi[0];
+		s->lo_sum += (int64_t)v[b] - v[a];
+		split_place(s, false, 0, b);
+		split_place(s, true, 0, a);
+		split_sift(v, s, false, 0);
+		split_sift(v, s, true, 0);
+	}
+}
+
+/**
+ * @brief Add a new slot (window not full yet)
+ */
+static void split_insert(const int32_t *v, dsp_order_split_t *s, uint8_t slot, uint8_t target){
+	bool hi = !(s->lo_len > 0 && v[slot] <= v[s->lo[0]]);
+	split_push(v, s, hi, slot);
+	split_balance(v, s, target);
+}
+
+/**
+ * @brief A slot changed its value (oldest sample replaced by the new one)
+ */
+static void split_replace(const int32_t *v, dsp_order_split_t *s, uint8_t slot, int32_t old, uint8_t target){
+	bool hi = (s->pos[slot] & SPLIT_HI) != 0;
+	if(!hi){
+		s->lo_sum += (int64_t)v[slot] - old;
+	}
+	split_sift(v, s, hi, s->pos[slot] & SPLIT_IDX);
+	split_balance(v, s, target);
+}
+
+/**
+ * @brief Window slot of a sample still in the window, from its sample number 
+ * (the difference with seq is wrap safe, the sample number itself is not a slot)
+ */
+static uint8_t order_slot(const dsp_order_stat_t *f, uint32_t q){
+	uint8_t age = f->seq - q;
+	return (f->slot >= age) ? f->slot - age : f->slot + f->window - age;
+}
+
+/*==================[external functions definition]==========================*/
+void DspOrderStatInit(dsp_order_stat_t *f, uint8_t window, uint8_t trim){
+	memset(f, 0, sizeof(dsp_order_stat_t));
+	if(window > DSP_ORDER_MAX_WINDOW){
+		window = DSP_ORDER_MAX_WINDOW;
+	}
+	if(window == 0){
+		window = 1;
+	}
+	if(2 * trim >= window){
+		trim = (window - 1) / 2;
+	}
+	f->window = window;
+	f->trim = trim;
+}
+
+void DspOrderStatUpdate(dsp_order_stat_t *f, int32_t x){
+	const uint8_t window = f->window;
+	const uint8_t slot = f->slot;
+	int32_t old = f->values[slot];
+	bool full = (f->count == window);
+	/* Drop samples leaving the window from min/max queues */
+	if(f->min_len > 0 && f->seq - f->min_q[f->min_head] >= window){
+		f->min_head = (f->min_head + 1) % window;
+		f->min_len--;
+	}
+	if(f->max_len > 0 && f->seq - f->max_q[f->max_head] >= window){
+		f->max_head = (f->max_head + 1) % window;
+		f->max_len--;
+	}
+	f->values[slot] = x;
+	f->sum += x;
+	if(full){
+		f->sum -= old;
+	}
+	else{
+		f->count++;
+	}
+	const uint8_t count = f->count;
+	const uint8_t k = (f->trim * count) / window;
+	if(full){
+		split_replace(f->values, &f->median, slot, old, count / 2);
+		if(f->trim > 0){
+			split_replace(f->values, &f->trim_lo, slot, old, k);
+			split_replace(f->values, &f->trim_hi, slot, old, count - k);
+		}
+	}
+	else{
+		split_insert(f->values, &f->median, slot, count / 2);
+		if(f->trim > 0){
+			split_insert(f->values, &f->trim_lo, slot, k);
+			split_insert(f->values, &f->trim_hi, slot, count - k);
+		}
+	}
+	/* Monotonic queues: values that can never be the min (max) again are dropped */
+	while(f->min_len > 0 && f->values[order_slot(f, f->min_q[(f->min_head + f->min_len - 1) % window])] >= x){
+		f->min_len--;
+	}
+	f->min_q[(f->min_head + f->min_len++) % window] = f->seq;
+	while(f->max_len > 0 && f->values[order_slot(f, f->max_q[(f->max_head + f->max_len - 1) % window])] <= x){
+		f->max_len--;
+	}
+	f->max_q[(f->max_head + f->max_len++) % window] = f->seq;
+	f->seq++;
+	f->slot = (slot + 1 == window) ? 0 : slot + 1;
+}
+
+void DspOrderStatMedianRaw(dsp_order_stat_t *f, const uint16_t *in, uint16_t *out, uint32_t len){
+	for(uint32_t i = 0; i < len; i++){
+		DspOrderStatUpdate(f, in[i]);
+		out[i] = DspOrderStatMedian(f);
+	}
+}
+
+int32_t DspOrderStatMedian(dsp_order_stat_t *f){
+	const dsp_order_split_t *s = &f->median;
+	if(f->count == 0){
+		return 0;
+	}
+	if(f->count & 1){
+		return f->values[s->hi[0]];
+	}
+	return ((int64_t)f->values[s->lo[0]] + f->values[s->hi[0]]) / 2;
+}
+
+int32_t DspOrderStatTrimmedMean(dsp_order_stat_t *f){
+	if(f->count == 0){
+		return 0;
+	}
+	if(f->trim == 0){
+		return f->sum / f->count;
+	}
+	const uint8_t k = (f->trim * f->count) / f->window;
+	return (f->trim_hi.lo_sum - f->trim_lo.lo_sum) / (f->count - 2 * k);
+}
+
+int32_t DspOrderStatMin(dsp_order_stat_t *f){
+	if(f->min_len == 0){
+		return 0;
+	}
+	return f->values[order_slot(f, f->min_q[f->min_head])];
+}
+
+int32_t DspOrderStatMax(dsp_order_stat_t *f){
+	if(f->max_len == 0){
+		return 0;
+	}
+	return f->values[order_slot(f, f->max_q[f->max_head])];
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,222 @@
+/**
+ * @file qrs_detector.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "qrs_detector.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define QRS_BP_LOW			5		/*!< Band-pass low cut-off (Hz) */
+#define QRS_BP_HIGH			15		/*!< Band-pass high cut-off (Hz) */
+#define QRS_MWI_MS			150		/*!< Integration window (ms) */
+#define QRS_REFRACTORY_MS	200		/*!< No beats closer than this (ms) */
+#define QRS_LEARN_S			2		/*!< Learning phase (s) */
+#define QRS_BP_DELAY_MS		35		/*!< Approximate band-pass group delay (ms) */
+#define QRS_SQ_SHIFT		6		/*!< Squared derivative scaling, keeps the window sum in 32 bits */
+#define QRS_CHUNK			32		/*!< Samples filtered per call to the band-pass */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static void qrs_thresholds(qrs_detector_t *qrs);
+static void qrs_beat(qrs_detector_t *qrs, uint32_t r_n, qrs_beat_t *beat);
+static uint32_t qrs_r_location(qrs_detector_t *qrs);
+static uint8_t qrs_sample(qrs_detector_t *qrs, q15_t x, qrs_beat_t *beat);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Update detection thresholds from signal and noise levels
+ */
+static void qrs_thresholds(qrs_detector_t *qrs){
+	qrs->th1 = qrs->npki + ((qrs->spki - qrs->npki) >> 2);
+	qrs->th2 = qrs->th1 >> 1;
+}
+
+/**
+ * @brief Register a beat at sample r_n and fill its report
+ */
+static void qrs_beat(qrs_detector_t *qrs, uint32_t r_n, qrs_beat_t *beat){
+	uint32_t rr = 0;
+	if(qrs->beats > 0){
+		rr = r_n - qrs->last_beat_n;
+		if(rr > UINT16_MAX){
+			rr = UINT16_MAX;
+		}
+		if(qrs->rr_count == QRS_RR_AVG_LEN){
+			qrs->rr_sum -= qrs->rr[qrs->rr_pos];
+		}
+		else{
+			qrs->rr_count++;
+		}
+		qrs->rr[qrs->rr_pos] = rr;
+		qrs->rr_sum += rr;
+		qrs->rr_pos = (qrs->rr_pos + 1) % QRS_RR_AVG_LEN;
+	}
+	qrs->beats++;
+	qrs->last_beat_n = r_n;
+	qrs->sb_peak = 0;
+	beat->sample = r_n;
+	beat->time_ms = ((uint64_t)r_n * 1000) / qrs->fs;
+	beat->rr_ms = (rr * 1000) / qrs->fs;
+	beat->hr_bpm = QrsHeartRate(qrs);
+}
+
+/**
+ * @brief Sample index of the largest band-pass value inside the integration window
+ */
+static uint32_t qrs_r_location(qrs_detector_t *qrs){
+	uint16_t max = 0;
+	uint16_t age = 0;
+	uint16_t pos = qrs->hist_pos;
+	/* Walk from newest to oldest, hist_pos is the next (oldest) position */
+	for(uint16_t i = 0; i < qrs->mwi_len; i++){
+		pos = (pos == 0) ? qrs->mwi_len - 1 : pos - 1;
+		int16_t v = qrs->bp_hist[pos];
+		uint16_t a = (v < 0) ? -(int32_t)v : v;
+		if(a > max){
+			max = a;
+			age = i;
+		}
+	}
+	return qrs->n - age - (QRS_BP_DELAY_MS * qrs->fs) / 1000;
+}
+
+/**
+ * @brief Process one band-passed sample, returns 1 if a beat was detected
+ */
+static uint8_t qrs_sample(qrs_detector_t *qrs, q15_t x, qrs_beat_t *beat){
+	uint8_t found = 0;
+	/* Five point derivative: (2x[n] + x[n-1] - x[n-3] - 2x[n-4]) / 8 */
+	int32_t d = (2 * x + qrs->der[0] - qrs->der[2] - 2 * qrs->der[3]) >> 3;
+	qrs->der[3] = qrs->der[2];
+	qrs->der[2] = qrs->der[1];
+	qrs->der[1] = qrs->der[0];
+	qrs->der[0] = x;
+	uint32_t sq = ((uint32_t)(d * d)) >> QRS_SQ_SHIFT;
+	/* Moving window integration */
+	qrs->mwi_sum += sq - qrs->sq_hist[qrs->hist_pos];
+	qrs->sq_hist[qrs->hist_pos] = sq;
+	qrs->bp_hist[qrs->hist_pos] = x;
+	if(++qrs->hist_pos == qrs->mwi_len){
+		qrs->hist_pos = 0;
+	}
+	uint32_t m = qrs->mwi_sum;
+	uint32_t learn_n = QRS_LEARN_S * qrs->fs;
+
+	if(qrs->n < learn_n){
+		if(m > qrs->spki){
+			qrs->spki = m;
+		}
+		if(qrs->n == learn_n - 1){
+			/* Signal level from the largest peak, noise a fraction of it */
+			qrs->npki = qrs->spki >> 3;
+			qrs->spki = qrs->spki / 3;
+			qrs_thresholds(qrs);
+		}
+	}
+	else{
+		uint32_t refractory = (QRS_REFRACTORY_MS * qrs->fs) / 1000;
+		/* Peak tracking: start on a rising sample, end when it falls to half */
+		if(m > qrs->peak && (qrs->peak != 0 || m > qrs->mwi_prev)){
+			qrs->peak = m;
+			qrs->r_n = qrs_r_location(qrs);
+		}
+		else if(qrs->peak != 0 && m < (qrs->peak >> 1)){
+			uint32_t dist = qrs->r_n - qrs->last_beat_n;
+			if(qrs->peak > qrs->th1 && (qrs->beats == 0 || dist > refractory)){
+				qrs->spki = (qrs->peak + 7 * qrs->spki) >> 3;
+				qrs_beat(qrs, qrs->r_n, beat);
+				found = 1;
+			}
+			else{
+				qrs->npki = (qrs->peak + 7 * qrs->npki) >> 3;
+				if(qrs->peak > qrs->sb_peak && (qrs->beats == 0 || dist > refractory)){
+					qrs->sb_peak = qrs->peak;
+					qrs->sb_r_n = qrs->r_n;
+				}
+			}
+			qrs_thresholds(qrs);
+			qrs->peak = 0;
+		}
+		/* Search-back: no beat for 166% of the mean RR, take the largest rejected peak */
+		if(!found && qrs->rr_count > 0 && qrs->sb_peak > qrs->th2){
+			uint32_t rr_avg = qrs->rr_sum / qrs->rr_count;
+			if(qrs->n - qrs->last_beat_n > (rr_avg * 166) / 100){
+				qrs->spki = (qrs->sb_peak + 3 * qrs->spki) >> 2;
+				qrs_thresholds(qrs);
+				qrs_beat(qrs, qrs->sb_r_n, beat);
+				found = 1;
+			}
+		}
+	}
+	qrs->mwi_prev = m;
+	qrs->n++;
+	return found;
+}
+
+/*==================[external functions definition]==========================*/
+void QrsInit(qrs_detector_t *qrs, uint16_t fs){
+	memset(qrs, 0, sizeof(qrs_detector_t));
+	qrs->fs = fs;
+	DspBiquadHighpass(&qrs->bp_coeffs[0], QRS_BP_LOW, fs, 0.7071f);
+	DspBiquadLowpass(&qrs->bp_coeffs[1], QRS_BP_HIGH, fs, 0.7071f);
+	DspBiquadInit(&qrs->bp, qrs->bp_coeffs, 2, qrs->bp_state);
+	qrs->mwi_len = (QRS_MWI_MS * fs) / 1000;
+	if(qrs->mwi_len > QRS_MWI_MAX){
+		qrs->mwi_len = QRS_MWI_MAX;
+	}
+	if(qrs->mwi_len == 0){
+		qrs->mwi_len = 1;
+	}
+}
+
+uint8_t QrsProcessQ15(qrs_detector_t *qrs, const q15_t *in, uint32_t len, qrs_beat_t *beats, uint8_t max_beats){
+	q15_t bp[QRS_CHUNK];
+	qrs_beat_t beat;
+	uint8_t count = 0;
+	while(len > 0){
+		uint32_t chunk = (len > QRS_CHUNK) ? QRS_CHUNK : len;
+		DspBiquadQ15(&qrs->bp, in, bp, chunk);
+		for(uint32_t i = 0; i < chunk; i++){
+			if(qrs_sample(qrs, bp[i], &beat) && count < max_beats){
+				beats[count++] = beat;
+			}
+		}
+		in += chunk;
+		len -= chunk;
+	}
+	return count;
+}
+
+uint8_t QrsProcessRaw(qrs_detector_t *qrs, const uint16_t *raw, uint32_t len, qrs_beat_t *beats, uint8_t max_beats){
+	q15_t in[QRS_CHUNK];
+	uint8_t count = 0;
+	while(len > 0){
+		uint32_t chunk = (len > QRS_CHUNK) ? QRS_CHUNK : len;
+		for(uint32_t i = 0; i < chunk; i++){
+			in[i] = DspAdcToQ15(raw[i]);
+		}
+		count += QrsProcessQ15(qrs, in, chunk, &beats[count], max_beats - count);
+		raw += chunk;
+		len -= chunk;
+	}
+	return count;
+}
+
+uint16_t QrsHeartRate(qrs_detector_t *qrs){
+	if(qrs->rr_count == 0 || qrs->rr_sum == 0){
+		return 0;
+	}
+	return (60UL * qrs->fs * qrs->rr_count) / qrs->rr_sum;
+}
+
+/*==================[end of file]============================================*/
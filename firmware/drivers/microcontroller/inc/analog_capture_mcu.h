@@ -0,0 +1,156 @@
+#ifndef ANALOG_CAPTURE_MCU_H
+#define ANALOG_CAPTURE_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Analog_Capture Analog Capture
+ ** @{ */
+
+/** \brief Triggered capture (oscilloscope mode) for the ESP-EDU analog inputs.
+ *
+ * Watches the blocks produced by the ADC in continuous mode and captures a 
+ * record around a trigger event: pre samples before the trigger and post 
+ * samples from the trigger on. Blocks are processed in the ADC acquisition 
+ * task, so no user task is involved until the record is complete. The record 
+ * is delivered as a single contiguous, time ordered buffer (the trigger 
+ * sample is at index pre), ready to be sent over UART or drawn.
+ * 
+ * Triggers:
+ * - Rising: signal goes below level - hysteresis and then reaches level.
+ * - Falling: signal goes above level + hysteresis and then drops to level.
+ * - High/Low: signal is at or above/below level. After a capture it must 
+ * leave the level by the hysteresis before triggering again.
+ * 
+ * Example (1kHz, 100 samples before and 400 after a rising edge at mid-scale):
+ * @code
+ * static uint16_t record[500];
+ * analog_capture_config_t capture = {
+ * 	.trigger = CAPTURE_RISING, .level = 2048, .hysteresis = 50,
+ * 	.mode = CAPTURE_NORMAL, .buffer = record, .pre = 100, .post = 400,
+ * 	.func_p = SendRecord, .param_p = NULL};
+ * AnalogInputInit(&adc_config);
+ * AnalogCaptureInit(&capture);
+ * AnalogStartContinuous(CH1);
+ * AnalogCaptureArm();
+ * @endcode
+ * 
+ * @note Captures use the channel running in continuous mode (see AnalogStartContinuous()).
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * | 19/10/2026 | Trigger timestamp (AnalogCaptureTime())          						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Trigger condition
+ */
+typedef enum capture_trigger {
+	CAPTURE_RISING,			/*!< Rising edge through level */
+	CAPTURE_FALLING,		/*!< Falling edge through level */
+	CAPTURE_HIGH,			/*!< Signal at or above level */
+	CAPTURE_LOW,			/*!< Signal at or below level */
+} capture_trigger_t;
+
+/**
+ * @brief Re-arm mode
+ */
+typedef enum capture_mode {
+	CAPTURE_SINGLE,			/*!< One capture, then wait for AnalogCaptureArm() */
+	CAPTURE_NORMAL,			/*!< Re-arm after every capture */
+} capture_mode_t;
+
+/**
+ * @brief Capture engine state
+ */
+typedef enum capture_state {
+	CAPTURE_IDLE,			/*!< Not armed */
+	CAPTURE_FILLING,		/*!< Armed, collecting pre-trigger samples */
+	CAPTURE_ARMED,			/*!< Waiting for trigger */
+	CAPTURE_TRIGGERED,		/*!< Collecting post-trigger samples */
+	CAPTURE_DONE,			/*!< Record complete (single mode) */
+} capture_state_t;
+
+/**
+ * @brief Capture configuration structure
+ */
+typedef struct {
+	capture_trigger_t trigger;	/*!< Trigger condition */
+	uint16_t level;				/*!< Trigger level (raw ADC value) */
+	uint16_t hysteresis;		/*!< Trigger hysteresis (raw ADC counts) */
+	capture_mode_t mode;		/*!< Re-arm mode */
+	uint16_t *buffer;			/*!< Record buffer (pre + post values) */
+	uint16_t pre;				/*!< Samples before the trigger */
+	uint16_t post;				/*!< Samples from the trigger on (at least 1) */
+	void (*func_p)(const uint16_t *record, uint16_t len, void *param);	/*!< Record complete callback (can be NULL) */
+	void *param_p;				/*!< Parameter for func_p */
+} analog_capture_config_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Capture engine initialization, leaves it idle
+ * 
+ * @note func_p runs in the ADC acquisition task: the record must be sent or 
+ * copied before it returns (in normal mode the buffer is reused right after).
+ * 
+ * @param config Capture configuration
+ */
+void AnalogCaptureInit(analog_capture_config_t *config);
+
+/**
+ * @brief Start waiting for a trigger (discards any previous record)
+ */
+void AnalogCaptureArm(void);
+
+/**
+ * @brief Stop capturing
+ */
+void AnalogCaptureStop(void);
+
+/**
+ * @brief Trigger on the next sample, once the pre-trigger samples are collected
+ */
+void AnalogCaptureForce(void);
+
+/**
+ * @brief Capture engine state
+ * 
+ * @return capture_state_t Current state, in single mode the record is in the 
+ * buffer once CAPTURE_DONE is reached
+ */
+capture_state_t AnalogCaptureState(void);
+
+/**
+ * @brief Number of records captured since AnalogCaptureInit()
+ * 
+ * @return uint32_t Records captured
+ */
+uint32_t AnalogCaptureCount(void);
+
+/**
+ * @brief Time of the trigger sample (index pre) of the last record. The time 
+ * of sample k of the record is this value plus (k - pre) sampling periods.
+ * 
+ * @return uint64_t Timestamp in us (see timestamp_mcu.h)
+ */
+uint64_t AnalogCaptureTime(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef ANALOG_CAPTURE_MCU_H */
+
+/*==================[end of file]============================================*/
@@ -13,6 +13,10 @@
  * 
  * @note The ESP-EDU have 4 analog inputs and 1 analog output, but the designated pin for 
  * the latter is shared with analog output 0 (CH0).
+ * 
+ * @warning Analog output playback and streaming take one of the two ESP32-C6 
+ * gptimers on their first init and keep it for good, so it is not available 
+ * for TimerInit(), the soft timers (delays, jobs) or EtmPulseInit() afterwards.
  *
  * @author Albano Peñalva
  *
@@ -21,11 +25,20 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 24/02/2024 | Document creation		                         						|
+ * | 19/10/2026 | Raw to mV lookup table and buffer conversion     						|
+ * | 19/10/2026 | Continuous mode with oversampling and decimation 						|
+ * | 19/10/2026 | Timer driven playback for analog output          						|
+ * | 19/10/2026 | Block listener for continuous mode               						|
+ * | 19/10/2026 | Block timestamps for continuous mode             						|
+ * | 19/10/2026 | AnalogRaw2mV() takes the channel                 						|
+ * | 19/10/2026 | Lookup tables allocated at AnalogInputInit()     						|
+ * | 19/10/2026 | Playback and streaming report a missing gptimer  						|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include <stdbool.h>
 /*==================[macros]=================================================*/
 typedef enum adc_ch {
 	CH0 = 0,				/*!< Channel 0 */
@@ -39,7 +52,15 @@ typedef enum adc_mode {
 	ADC_CONTINUOUS,			/*!< Continuous read */
 } adc_mode_t;
 
+typedef enum adc_decim {
+	ADC_DECIM_BOXCAR,		/*!< Average of consecutive samples */
+	ADC_DECIM_CIC,			/*!< 3rd order CIC filter (better alias rejection) */
+} adc_decim_t;
+
 #define DAC	0    			/*!< DAC pin. Override CH0 declaration*/
+#define ADC_BLOCK_SIZE	64	/*!< Values delivered per block in continuous mode */
+#define ADC_MAX_LOG2_OVERSAMPLING		8	/*!< Max oversampling ratio: 256 (boxcar) */
+#define ADC_MAX_LOG2_OVERSAMPLING_CIC	6	/*!< Max oversampling ratio: 64 (CIC) */
 /*==================[typedef]================================================*/
 /**
  * @brief Analog inputs config structure
@@ -50,9 +71,33 @@ typedef struct {
 	adc_mode_t mode;		/*!< Mode: single read or continuous read */
 	void *func_p;			/*!< Pointer to callback function for convertion end (only for continuous mode) */
 	void *param_p;			/*!< Pointer to callback function parameters (only for continuous mode) */
-	uint16_t sample_frec;	/*!< Sample frequency min: 20kHz - max: 2MHz (only for continuous mode)  */
+	uint32_t sample_frec;	/*!< Output frequency in Hz. sample_frec * oversampling must be between 611Hz and 83kHz (only for continuous mode)  */
+	uint16_t oversampling;	/*!< Samples captured per output value, rounded down to a power of 2 (0 or 1: no oversampling) (only for continuous mode) */
+	adc_decim_t decimation;	/*!< Decimation filter used when oversampling (only for continuous mode) */
 } analog_input_config_t;	
 
+/**
+ * @brief Analog output playback config structure
+ */
+typedef struct {
+	const uint8_t *table;	/*!< Samples to play (from 0 to 255, as in AnalogOutputWrite) */
+	uint16_t len;			/*!< Number of samples in table */
+	uint32_t sample_frec;	/*!< Table sample frequency (Hz) */
+	uint32_t update_frec;	/*!< DAC update frequency (Hz), up to 100kHz (0: same as sample_frec) */
+	bool loop;				/*!< true: restart table at the end - false: hold last sample */
+	bool interpolate;		/*!< Linear interpolation between samples (useful when update_frec > sample_frec) */
+	uint16_t gain;			/*!< Amplitude scale around mid-scale (128), 256 = x1 (0: x1) */
+} analog_output_play_t;
+
+/**
+ * @brief Analog output update timing, measured in the update ISR
+ */
+typedef struct {
+	uint32_t updates;		/*!< DAC updates since start */
+	uint32_t period_min;	/*!< Minimum time between updates (ns) */
+	uint32_t period_max;	/*!< Maximum time between updates (ns) */
+} analog_output_stats_t;
+
 /*==================[external data declaration]==============================*/
 
 /*==================[external functions declaration]=========================*/
@@ -83,6 +128,20 @@ void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value);
 /**
  * @brief Start convertion for ADC module in continuous mode
  * 
+ * Conversions are timed by the ADC hardware at sample_frec * oversampling. Every
+ * oversampling samples are decimated into one value of 12 + log2(oversampling)/2 
+ * bits. Each time ADC_BLOCK_SIZE values are ready the callback function is called 
+ * (from the driver task, not from an ISR).
+ * 
+ * The effective resolution only grows if the input noise is white and of 
+ * about 1 LSB or more. Then the boxcar filter adds 0.5 bits per doubling of 
+ * the oversampling, and the CIC filter about 0.4 bits more than the boxcar at 
+ * the same ratio (host test test_adc, with simulated noise). Check it on the 
+ * board with AnalogInputEnob().
+ * 
+ * @note Only one channel can be converted in continuous mode at a time, and 
+ * single reads are not available while it runs.
+ * 
  * @param channel Channel selected
  */
 void AnalogStartContinuous(adc_ch_t channel);
@@ -95,20 +154,76 @@ void AnalogStartContinuous(adc_ch_t channel);
 void AnalogStopContinuous(adc_ch_t channel);
 
 /**
- * @brief 
+ * @brief Read the last complete block of a channel in continuous mode.
  * 
  * @param channel Channel selected.
- * @param values Read variable array
+ * @param values Read variable array (ADC_BLOCK_SIZE values)
  */
 void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values);
 
 /**
- * @brief Convert raw value from ADC to mV, using a calibration curve.
+ * @brief Register a function that receives every complete block in continuous 
+ * mode, before the user callback. Used by modules that process the stream 
+ * (e.g. analog_capture_mcu) without copying it.
+ * 
+ * @note The listener runs in the acquisition task and must not block.
+ * 
+ * @param listener Function called with the block and its length (NULL to remove)
+ */
+void AnalogInputBlockListener(void (*listener)(const uint16_t *block, uint16_t len));
+
+/**
+ * @brief Time of a sample of the last complete block in continuous mode (the 
+ * one passed to the listener or returned by AnalogInputReadContinuous()). 
+ * Derived from the time the DMA frame holding the block end was completed and 
+ * the sampling rate, so it does not depend on when the task runs.
+ * 
+ * @param index Sample index in the block (0: first sample)
+ * @return uint64_t Timestamp in us (see timestamp_mcu.h)
+ */
+uint64_t AnalogInputBlockTime(uint16_t index);
+
+/**
+ * @brief Convert raw value from ADC to mV, using the calibration curve of the 
+ * channel it was read from.
  * 
+ * @note The calibration curve of each channel is evaluated once at 
+ * AnalogInputInit() into a lookup table, allocated from the heap (8KB per 
+ * channel) the first time the channel is initialized. If there is not enough 
+ * memory, the curve is evaluated on every conversion instead.
+ * 
+ * @param channel Channel the value was read from (must be initialized)
  * @param value Raw value from ADC.
  * @return uint16_t Calibrated value from ADC in mV.
  */
-uint16_t AnalogRaw2mV(uint16_t value);
+uint16_t AnalogRaw2mV(adc_ch_t channel, uint16_t value);
+
+/**
+ * @brief Convert a buffer of raw values from ADC to mV, using the calibration 
+ * lookup table of the selected channel.
+ * 
+ * @note values and mv can point to the same buffer (in-place conversion).
+ * 
+ * @param channel Channel the values were read from (must be initialized)
+ * @param values Raw values from ADC
+ * @param mv Calibrated values in mV
+ * @param len Number of values to convert
+ */
+void AnalogRaw2mVBuffer(adc_ch_t channel, const uint16_t *values, uint16_t *mv, uint32_t len);
+
+/**
+ * @brief Effective number of bits of a record taken with a constant input.
+ * 
+ * Compares the noise of the record with the quantization noise of an ideal 
+ * converter of the same resolution. Used to measure the resolution gained 
+ * with oversampling.
+ * 
+ * @param values Recorded values
+ * @param len Number of values
+ * @param bits Nominal resolution of the values (12 + log2(oversampling)/2)
+ * @return float Effective number of bits
+ */
+float AnalogInputEnob(const uint16_t *values, uint32_t len, uint8_t bits);
 
 /**
  * @brief Digital-to-Analog convert.
@@ -117,6 +232,78 @@ uint16_t AnalogRaw2mV(uint16_t value);
  */
 void AnalogOutputWrite(uint8_t value);
 
+/**
+ * @brief Configure the playback engine, that streams a sample table to the 
+ * analog output from a timer ISR (no task involved per sample).
+ * 
+ * @note AnalogOutputInit() must be called first. Playback is stopped after init.
+ * 
+ * @param config Playback config structure
+ * @return true if configured, false if no gptimer is free for the DAC timer
+ */
+bool AnalogOutputPlayInit(analog_output_play_t *config);
+
+/**
+ * @brief Start (or resume) playback. Timing statistics are restarted.
+ */
+void AnalogOutputPlayStart(void);
+
+/**
+ * @brief Stop playback. The output holds the last sample.
+ */
+void AnalogOutputPlayStop(void);
+
+/**
+ * @brief Queue a new table, that replaces the current one when it reaches its 
+ * end (so the waveform is not cut in the middle).
+ * 
+ * @note The current table must not be modified until the swap happens. 
+ * 
+ * @param table Samples to play
+ * @param len Number of samples in table
+ */
+void AnalogOutputPlaySwap(const uint8_t *table, uint16_t len);
+
+/**
+ * @brief Change playback amplitude
+ * 
+ * @param gain Amplitude scale around mid-scale (128), 256 = x1
+ */
+void AnalogOutputPlayGain(uint16_t gain);
+
+/**
+ * @brief Check if a non looping table has been completely played
+ * 
+ * @return true Playback reached the end of the table
+ */
+bool AnalogOutputPlayDone(void);
+
+/**
+ * @brief Stream samples produced by a function to the analog output. The 
+ * function is called from the DAC timer ISR on every update, so it must be 
+ * short and placed in IRAM. Replaces playback while running.
+ * 
+ * @note AnalogOutputInit() must be called first.
+ * 
+ * @param update_frec DAC update frequency (Hz), up to 100kHz
+ * @param source Function returning the next sample (from 0 to 255)
+ * @param param Parameter passed to source
+ * @return true if started, false if no gptimer is free for the DAC timer
+ */
+bool AnalogOutputStreamStart(uint32_t update_frec, uint8_t (*source)(void*), void *param);
+
+/**
+ * @brief Stop streaming. The output holds the last sample.
+ */
+void AnalogOutputStreamStop(void);
+
+/**
+ * @brief Get analog output update timing. Jitter is period_max - period_min.
+ * 
+ * @param stats Pointer to stats structure
+ */
+void AnalogOutputStats(analog_output_stats_t *stats);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
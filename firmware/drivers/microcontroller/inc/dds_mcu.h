@@ -0,0 +1,120 @@
+#ifndef DDS_MCU_H
+#define DDS_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup DDS DDS
+ ** @{ */
+
+/** \brief Direct digital synthesis test signal generator for the ESP-EDU analog output.
+ *
+ * Generates sine, square, triangle, sawtooth and chirp signals on the analog 
+ * output (DAC), computed sample by sample in the DAC timer ISR. Each tone uses a 
+ * 32 bit phase accumulator, so frequency resolution is update_frec / 2^32 
+ * (about 5uHz at 20kHz), and frequency changes keep the phase continuous.
+ * Up to DDS_TONES_QTY tones are summed.
+ * 
+ * @note AnalogOutputInit() must be called before DdsStart(). DDS and 
+ * AnalogOutputPlay functions share the analog output, only one can run at a time.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define DDS_TONES_QTY	4		/*!< Number of tones that can be summed */
+#define DDS_HZ(f)		((uint32_t)(f) * 1000)	/*!< Frequency in Hz to mHz */
+/*==================[typedef]================================================*/
+/**
+ * @brief Waveforms available for each tone
+ */
+typedef enum dds_wave {
+	DDS_OFF,				/*!< Tone disabled */
+	DDS_SINE,				/*!< Sine */
+	DDS_SQUARE,				/*!< Square (50% duty cycle) */
+	DDS_TRIANGLE,			/*!< Triangle */
+	DDS_SAWTOOTH,			/*!< Rising sawtooth */
+} dds_wave_t;
+
+/**
+ * @brief Tone configuration structure
+ */
+typedef struct {
+	dds_wave_t wave;		/*!< Waveform */
+	uint32_t frec;			/*!< Frequency (in mHz, see DDS_HZ()) */
+	uint8_t amplitude;		/*!< Peak amplitude in DAC counts (0 to 127) */
+	uint32_t frec_end;		/*!< Chirp final frequency (in mHz) (0: no chirp) */
+	uint32_t sweep_ms;		/*!< Chirp sweep duration (in ms), restarts from frec when finished */
+} dds_tone_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief DDS initialization. All tones are disabled.
+ * 
+ * @param update_frec DAC update frequency (Hz), up to 100kHz
+ * @param offset Output value for 0 (128: mid-scale)
+ */
+void DdsInit(uint32_t update_frec, uint8_t offset);
+
+/**
+ * @brief Configure a tone. Phase is reset to 0.
+ * 
+ * @param tone Tone number (0 to DDS_TONES_QTY - 1)
+ * @param config Tone configuration
+ */
+void DdsSetTone(uint8_t tone, dds_tone_t *config);
+
+/**
+ * @brief Change a tone frequency without phase jump (stops its chirp).
+ * 
+ * @param tone Tone number (0 to DDS_TONES_QTY - 1)
+ * @param frec New frequency (in mHz)
+ */
+void DdsSetFrequency(uint8_t tone, uint32_t frec);
+
+/**
+ * @brief Change a tone amplitude
+ * 
+ * @param tone Tone number (0 to DDS_TONES_QTY - 1)
+ * @param amplitude Peak amplitude in DAC counts (0 to 127)
+ */
+void DdsSetAmplitude(uint8_t tone, uint8_t amplitude);
+
+/**
+ * @brief Start signal generation on the analog output
+ * 
+ * @return true if started, false if no gptimer is free for the DAC timer
+ */
+bool DdsStart(void);
+
+/**
+ * @brief Stop signal generation. The output holds the last sample.
+ */
+void DdsStop(void);
+
+/**
+ * @brief Compute next output sample. Called from the DAC timer ISR, exposed 
+ * for testing.
+ * 
+ * @param param Not used
+ * @return uint8_t Output value (0 to 255)
+ */
+uint8_t DdsNextSample(void *param);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef DDS_MCU_H */
+
+/*==================[end of file]============================================*/
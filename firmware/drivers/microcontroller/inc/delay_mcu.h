@@ -10,9 +10,16 @@
 /** \brief Functions to generate delays.
  *
  * This driver provide functions to generate delays FreeRTOS friendly, using one timer.
+ * Delays are one-shot soft timers (see soft_timer_mcu.h), so nothing is created 
+ * per call and several tasks can be in a delay at the same time.
  * 
  * @note All delays will block the current RTOS task, with the exception of 
  * DelayUs with usec < 50.
+ * 
+ * @warning The first delay of 50us or more initializes the soft timer service, 
+ * which keeps one of the two ESP32-C6 gptimers for good (initialize other 
+ * gptimer users, e.g. TimerInit() or EtmPulseInit(), before it). If no gptimer 
+ * is free, delays block for whole RTOS ticks and busy wait the rest.
  *
  * @author Albano Peñalva
  *
@@ -21,6 +28,8 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Delays based on soft timers (reentrant)          						|
+ * | 19/10/2026 | Tick delay fallback without a free gptimer       						|
  * 
  **/
 
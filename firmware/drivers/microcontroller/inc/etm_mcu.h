@@ -0,0 +1,149 @@
+#ifndef ETM_MCU_H
+#define ETM_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup ETM ETM
+ ** @{ */
+
+/** \brief Event Task Matrix: peripheral events that trigger peripheral tasks in hardware.
+ *
+ * Links a timer alarm to a GPIO action, or a GPIO edge to a timer action, 
+ * without going through an ISR or a task, so the action happens a fixed number 
+ * of clock cycles after the event (no jitter). Uses:
+ * - Sampling strobes: a timer toggles a pin on every alarm.
+ * - Pulses: EtmPulseInit() generates a periodic pulse of fixed width (e.g. the 
+ *   10us HC-SR04 trigger) entirely in hardware.
+ * - Time measurement: a GPIO edge captures or restarts a timer count.
+ * 
+ * EtmTimerToGpio() and EtmGpioToTimer() link timers initialized with 
+ * TimerInit() (func_p can be NULL). Their alarm ISR still runs to re-enable the 
+ * alarm, but it does not affect the timing of the linked actions.
+ * 
+ * The pulse generator allocates its own two gptimers, with no ISR: each alarm 
+ * re-enables itself through an ETM task, so once started no CPU is involved. 
+ * The pin is driven by a single toggle task, raised by the period alarm and 
+ * lowered by the width alarm (a GPIO can be bound to only one ETM task).
+ * 
+ * @warning The ESP32-C6 has only two gptimers, and EtmPulseInit() takes both 
+ * until EtmPulseDeinit(). Meanwhile TimerInit() and the soft timer service 
+ * cannot get a timer, and so neither can DelayMs(), DelaySec(), DelayUs() over 
+ * 50us, jobs or the DAC/ADC timed modes; initialize those first and the pulse 
+ * generator fails instead (ESP_ERR_NOT_FOUND).
+ * 
+ * @note Functions return the first ESP-IDF error found (ESP_OK on success), 
+ * and release whatever they allocated before it.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * | 19/10/2026 | Pulse generator with its own ISR free timers, errors propagated		|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "gpio_mcu.h"
+#include "timer_mcu.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief GPIO actions
+ */
+typedef enum {
+	ETM_GPIO_SET,		/*!< Output high */
+	ETM_GPIO_CLEAR,		/*!< Output low */
+	ETM_GPIO_TOGGLE,	/*!< Invert output */
+} etm_gpio_action_t;
+
+/**
+ * @brief Timer actions
+ */
+typedef enum {
+	ETM_TIMER_START,	/*!< Start counting */
+	ETM_TIMER_STOP,		/*!< Stop counting */
+	ETM_TIMER_RELOAD,	/*!< Reload count (to 0) */
+	ETM_TIMER_CAPTURE,	/*!< Capture count (read with TimerGetCapture()) */
+} etm_timer_action_t;
+
+/**
+ * @brief GPIO edges
+ */
+typedef enum {
+	ETM_EDGE_RISING,	/*!< Rising edge */
+	ETM_EDGE_FALLING,	/*!< Falling edge */
+	ETM_EDGE_ANY,		/*!< Both edges */
+} etm_edge_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Perform a GPIO action on every alarm of a timer
+ * 
+ * @param timer Timer (initialized with TimerInit())
+ * @param pin GPIO (configured as output, not bound to another ETM task)
+ * @param action Action
+ * @return esp_err_t ESP_OK if the link was created
+ */
+esp_err_t EtmTimerToGpio(timer_mcu_t timer, gpio_t pin, etm_gpio_action_t action);
+
+/**
+ * @brief Perform a timer action on every edge of a GPIO
+ * 
+ * @param pin GPIO (configured as input)
+ * @param edge Edge
+ * @param timer Timer (initialized with TimerInit())
+ * @param action Action
+ * @return esp_err_t ESP_OK if the link was created
+ */
+esp_err_t EtmGpioToTimer(gpio_t pin, etm_edge_t edge, timer_mcu_t timer, etm_timer_action_t action);
+
+/**
+ * @brief Configure a periodic pulse generated in hardware. The period timer 
+ * alarm raises the pin and starts the width timer, whose alarm lowers the pin 
+ * and stops it. Takes both gptimers (see the warning above).
+ * 
+ * @param pin GPIO (initialized here as output, low)
+ * @param period Period (us)
+ * @param width Pulse width (us), less than period
+ * @return esp_err_t ESP_OK if the generator was created, ESP_ERR_INVALID_ARG 
+ * for a wrong width, ESP_ERR_INVALID_STATE if already created
+ */
+esp_err_t EtmPulseInit(gpio_t pin, uint32_t period, uint32_t width);
+
+/**
+ * @brief Start the pulses (first one a period after the call)
+ * 
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t EtmPulseStart(void);
+
+/**
+ * @brief Stop the pulses. A pulse in progress ends normally.
+ * 
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_STATE if not running
+ */
+esp_err_t EtmPulseStop(void);
+
+/**
+ * @brief Stop the pulses (pin low) and release both gptimers and the ETM 
+ * channels
+ * 
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_STATE if not initialized
+ */
+esp_err_t EtmPulseDeinit(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef ETM_MCU_H */
+
+/*==================[end of file]============================================*/
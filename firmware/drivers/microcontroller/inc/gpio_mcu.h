@@ -26,6 +26,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 23/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Task notification binding (GPIONotifyTask())     						|
  * 
  **/
 
@@ -35,6 +36,7 @@
 /*==================[macros]=================================================*/
 
 /*==================[typedef]================================================*/
+typedef struct isr_notify isr_notify_t;	/*!< Task binding (see isr_notify_mcu.h) */
 /**
  * @brief GPIO direction (input or output).
  * 
@@ -134,6 +136,16 @@ bool GPIORead(gpio_t pin);
  */
 void GPIOActivInt(gpio_t pin, void *ptr_int_func, bool edge, void *args);
 
+/**
+ * @brief Configure a GPIO input interruption that notifies a task (and switches 
+ * to it right away if it has higher priority)
+ * 
+ * @param pin GPIO number
+ * @param edge true: positive edge - false: negative edge
+ * @param notify Binding (see isr_notify_mcu.h)
+ */
+void GPIONotifyTask(gpio_t pin, bool edge, isr_notify_t *notify);
+
 /**
  * @brief Configure an input glitch filter to a GPIO
  * 
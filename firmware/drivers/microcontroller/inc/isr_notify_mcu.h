@@ -0,0 +1,117 @@
+#ifndef ISR_NOTIFY_MCU_H
+#define ISR_NOTIFY_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup ISR_Notify ISR notify
+ ** @{ */
+
+/** \brief Wake a task from a driver interrupt, with a latency probe.
+ *
+ * Replaces the usual "callback that calls vTaskNotifyGiveFromISR()" pattern. 
+ * The task is bound to a timer (TimerNotifyTask()), a GPIO (GPIONotifyTask()) 
+ * or a SPI device (SpiNotifyTask()), and the driver ISR gives the notification 
+ * and requests a context switch only when the woken task has higher priority 
+ * than the interrupted one, so the task runs as soon as the ISR ends instead of 
+ * at the next tick.
+ * 
+ * The ISR stores the CPU cycle count when it notifies, and IsrNotifyTake() 
+ * measures the time until the task runs again (ISR to task latency).
+ * 
+ * Example:
+ * @code
+ * static isr_notify_t medir_notify;
+ * static void MedirTask(void *param){
+ *     while(1){
+ *         IsrNotifyTake(&medir_notify, portMAX_DELAY);
+ *         ...
+ *     }
+ * }
+ * ...
+ * xTaskCreate(&MedirTask, "Medir", 2048, NULL, 5, &medir_handle);
+ * IsrNotifyInit(&medir_notify, medir_handle);
+ * TimerNotifyTask(TIMER_A, &medir_notify);
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+/*==================[macros]=================================================*/
+
+/*==================[typedef]================================================*/
+/**
+ * @brief Task binding. Allocated by the caller (static or global), fields are internal.
+ */
+typedef struct isr_notify {
+	TaskHandle_t task;				/*!< Task to notify */
+	volatile uint32_t isr_cycles;	/*!< CPU cycle count at the last notification */
+	volatile uint32_t notifications;	/*!< Notifications given */
+	uint32_t takes;					/*!< Notifications taken by the task */
+	uint32_t last_cycles;			/*!< Last ISR to task latency (CPU cycles) */
+	uint32_t max_cycles;			/*!< Worst ISR to task latency (CPU cycles) */
+} isr_notify_t;
+
+/**
+ * @brief Latency probe results
+ */
+typedef struct {
+	uint32_t notifications;			/*!< Notifications given by the ISR */
+	uint32_t takes;					/*!< Times the task woke up (less than notifications if it fell behind) */
+	uint32_t last_latency_ns;		/*!< Last ISR to task latency */
+	uint32_t max_latency_ns;		/*!< Worst ISR to task latency */
+} isr_notify_stats_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize a binding
+ * 
+ * @param notify Binding
+ * @param task Task to wake up
+ */
+void IsrNotifyInit(isr_notify_t *notify, TaskHandle_t task);
+
+/**
+ * @brief Notify the bound task. Called by the drivers from their ISRs.
+ * 
+ * @param notify Binding
+ * @return true if a context switch is needed at the end of the ISR
+ */
+bool IsrNotifyFromISR(isr_notify_t *notify);
+
+/**
+ * @brief Wait for a notification (from the bound task) and measure the latency
+ * 
+ * @param notify Binding
+ * @param ticks Maximum wait
+ * @return uint32_t Notifications pending (0: timeout)
+ */
+uint32_t IsrNotifyTake(isr_notify_t *notify, TickType_t ticks);
+
+/**
+ * @brief Read the latency probe
+ * 
+ * @param notify Binding
+ * @param stats Results since IsrNotifyInit()
+ */
+void IsrNotifyGetStats(isr_notify_t *notify, isr_notify_stats_t *stats);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef ISR_NOTIFY_MCU_H */
+
+/*==================[end of file]============================================*/
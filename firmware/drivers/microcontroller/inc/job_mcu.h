@@ -0,0 +1,160 @@
+#ifndef JOB_MCU_H
+#define JOB_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Job Periodic jobs
+ ** @{ */
+
+/** \brief Periodic jobs with deadline monitoring.
+ *
+ * Replaces the "timer callback + vTaskNotifyGiveFromISR() + task looping on 
+ * ulTaskNotifyTake()" pattern. A job is declared with its period, deadline, 
+ * priority and stack, and its function is called once per period from its own 
+ * task. All jobs are released by soft timers (see soft_timer_mcu.h), so they 
+ * share a single hardware timer.
+ * 
+ * For each job the framework counts overruns (a release arrives while the 
+ * previous one has not finished, that release is skipped) and deadline misses 
+ * (the function ends later than the deadline after its release), and measures 
+ * response time (wall time from release to end), execution time and CPU load.
+ * 
+ * Execution time and CPU load are CPU time of the job task, read from the 
+ * FreeRTOS run-time counter, so the time the job is preempted is not counted. 
+ * They need CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS with the default esp_timer 
+ * clock (menuconfig: Component config > FreeRTOS > Kernel) and ESP-IDF 5.2 or 
+ * later; otherwise they read 0.
+ * 
+ * Example:
+ * @code
+ * static job_t medir;
+ * static const job_config_t medir_cfg = {
+ *     .name = "medir", .func_p = Medir, .period = 2000, .priority = 5, .stack = 2048,
+ * };
+ * JobCreate(&medir, &medir_cfg);
+ * JobStartAll();
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * | 19/10/2026 | Execution time and load from the run-time counter						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "soft_timer_mcu.h"
+/*==================[macros]=================================================*/
+#define JOB_MAX		16		/*!< Most jobs created */
+/*==================[typedef]================================================*/
+/**
+ * @brief Job declaration
+ */
+typedef struct {
+	const char *name;		/*!< Name (task name) */
+	void (*func_p)(void*);	/*!< Function called once per period */
+	void *param_p;			/*!< Function parameter */
+	uint32_t period;		/*!< Period (us) */
+	uint32_t deadline;		/*!< Time from release to end of the function (us) (0: period) */
+	uint32_t offset;		/*!< First release after JobStart() (us) (0: one period) */
+	UBaseType_t priority;	/*!< Task priority */
+	uint32_t stack;			/*!< Task stack (bytes) */
+} job_config_t;
+
+/**
+ * @brief Job statistics
+ */
+typedef struct {
+	uint32_t releases;		/*!< Releases (timer expirations) */
+	uint32_t runs;			/*!< Function calls completed */
+	uint32_t overruns;		/*!< Releases skipped because the previous one was still pending or running */
+	uint32_t deadline_misses;	/*!< Runs that ended after the deadline */
+	uint32_t exec_last_us;	/*!< Execution time (CPU time), last run (known at the next release) */
+	uint32_t exec_max_us;	/*!< Execution time (CPU time), worst case */
+	uint32_t response_max_us;	/*!< Time from release to end of the function, worst case */
+	uint16_t load;			/*!< CPU load, CPU time over elapsed time (per thousand) */
+	uint32_t stack_free;	/*!< Least free stack seen (bytes) */
+} job_stats_t;
+
+/**
+ * @brief Job. Allocated by the caller (static or global), fields are internal.
+ */
+typedef struct {
+	const job_config_t *config;	/*!< Declaration */
+	soft_timer_t timer;			/*!< Release timer */
+	TaskHandle_t task;			/*!< Job task */
+	volatile uint64_t release;	/*!< Last release time (us) */
+	volatile bool busy;			/*!< Released and not finished */
+	uint64_t exec_total;		/*!< CPU time of the runs accounted since the stats were reset (us) */
+	configRUN_TIME_COUNTER_TYPE run_time;	/*!< Task run-time counter when the last run was accounted */
+	uint64_t stats_start;		/*!< Time the stats were reset (us) */
+	job_stats_t stats;			/*!< Statistics */
+} job_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Create a job (and its task). The job is stopped.
+ * 
+ * @param job Job
+ * @param config Declaration, must remain valid
+ * @return true if created, false if there are JOB_MAX jobs, the soft timer 
+ * service has no gptimer or the task could not be created
+ */
+bool JobCreate(job_t *job, const job_config_t *config);
+
+/**
+ * @brief Start releasing a job
+ * 
+ * @param job Job
+ */
+void JobStart(job_t *job);
+
+/**
+ * @brief Start all created jobs from the same instant (their offsets keep the 
+ * phase between them)
+ */
+void JobStartAll(void);
+
+/**
+ * @brief Stop releasing a job (a run in progress ends normally)
+ * 
+ * @param job Job
+ */
+void JobStop(job_t *job);
+
+/**
+ * @brief Read the statistics of a job
+ * 
+ * @param job Job
+ * @param stats Statistics since JobCreate() or JobResetStats()
+ */
+void JobGetStats(job_t *job, job_stats_t *stats);
+
+/**
+ * @brief Clear the statistics of all jobs
+ */
+void JobResetStats(void);
+
+/**
+ * @brief Total CPU load of all jobs
+ * 
+ * @return uint16_t Load (per thousand)
+ */
+uint16_t JobCpuLoad(void);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef JOB_MCU_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,148 @@
+#ifndef METRICS_MCU_H
+#define METRICS_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Metrics Metrics
+ ** @{ */
+
+/** \brief Driver metrics registry: event counters and latency histograms.
+ *
+ * The drivers feed a fixed set of counters (SPI transactions and bytes, I2C
+ * transactions and failures, ADC frames and overruns, UART drops, GPIO
+ * interrupts) and duration histograms (timer and soft timer callbacks).
+ * Counters are updated with an atomic add and histograms in a short critical
+ * section, so both can be fed from ISRs.
+ *
+ * Histograms have METRICS_HIST_BUCKETS fixed buckets of doubling width, in CPU
+ * cycles: bucket 0 holds durations under 32 cycles, bucket k durations from
+ * 2^(k+4) to 2^(k+5) cycles, and the last one everything longer (more than
+ * 3.2ms at 160MHz).
+ *
+ * The registry is read with MetricsGetCounter() and MetricsGetHistogram(), or
+ * over UART with the "metrics" command (see MetricsCmd()):
+ * @code
+ * static const uart_cmd_t commands[] = {
+ * 	{"metrics", MetricsCmd, (void*)UART_PC},
+ * };
+ * UartCmdInit(UART_PC, commands, 1, '\n');
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_mcu.h"
+/*==================[macros]=================================================*/
+#define METRICS_HIST_BUCKETS	16		/*!< Buckets per histogram */
+/*==================[typedef]================================================*/
+/**
+ * @brief Counters
+ */
+typedef enum metrics_counter {
+	METRICS_SPI_TRANSACTIONS,	/*!< SPI transactions (read, write or both) */
+	METRICS_SPI_BYTES,			/*!< SPI bytes transferred */
+	METRICS_I2C_TRANSACTIONS,	/*!< I2C transactions */
+	METRICS_I2C_ERRORS,			/*!< I2C transactions failed (NACK or timeout) */
+	METRICS_ADC_FRAMES,			/*!< ADC continuous mode DMA frames */
+	METRICS_ADC_OVERRUNS,		/*!< ADC continuous mode frames lost (driver pool full) */
+	METRICS_UART_RX_OVERFLOWS,	/*!< UART receive overflows (FIFO or buffer, data flushed) */
+	METRICS_UART_TX_DROPS,		/*!< UART buffered transmitter messages dropped */
+	METRICS_GPIO_INTERRUPTS,	/*!< GPIO interrupts */
+	METRICS_COUNTERS_QTY,		/*!< Number of counters */
+} metrics_counter_t;
+
+/**
+ * @brief Duration histograms
+ */
+typedef enum metrics_hist {
+	METRICS_TIMER_CALLBACK,		/*!< timer_mcu callbacks (all timers) */
+	METRICS_SOFT_TIMER_CALLBACK,	/*!< Soft timer callbacks */
+	METRICS_HISTS_QTY,			/*!< Number of histograms */
+} metrics_hist_t;
+
+/**
+ * @brief Histogram
+ */
+typedef struct {
+	uint32_t count;							/*!< Durations recorded */
+	uint32_t max;							/*!< Longest duration (cycles) */
+	uint64_t sum;							/*!< Sum of durations (cycles) */
+	uint32_t buckets[METRICS_HIST_BUCKETS];	/*!< Durations per bucket */
+} metrics_histogram_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Add to a counter. Can be called from an ISR.
+ *
+ * @param counter Counter
+ * @param value Value to add
+ */
+void MetricsAdd(metrics_counter_t counter, uint32_t value);
+
+/**
+ * @brief Record a duration in a histogram. Can be called from an ISR.
+ *
+ * @param hist Histogram
+ * @param cycles Duration (CPU cycles, e.g. difference of esp_cpu_get_cycle_count())
+ */
+void MetricsRecord(metrics_hist_t hist, uint32_t cycles);
+
+/**
+ * @brief Read a counter
+ *
+ * @param counter Counter
+ * @return uint32_t Value
+ */
+uint32_t MetricsGetCounter(metrics_counter_t counter);
+
+/**
+ * @brief Read a histogram
+ *
+ * @param hist Histogram
+ * @param histogram Copy of the histogram
+ */
+void MetricsGetHistogram(metrics_hist_t hist, metrics_histogram_t *histogram);
+
+/**
+ * @brief Clear all counters and histograms
+ */
+void MetricsReset(void);
+
+/**
+ * @brief Send all metrics over UART as text: "<name> <value>" for counters and
+ * "<name> n <count> mean_ns <mean> max_ns <max>" followed by
+ * "<name> lt_ns <bucket upper limit>:<count> ..." (non empty buckets) for
+ * histograms. Each line is sent whole through UartSendString().
+ *
+ * @param port Port (already initialized)
+ */
+void MetricsDump(uart_mcu_port_t port);
+
+/**
+ * @brief Command handler for UartCmdInit(). Argument "reset" clears the
+ * metrics, otherwise they are sent (see MetricsDump()).
+ *
+ * @param args Command arguments
+ * @param len Length of args
+ * @param param Port to send to, cast to void* (e.g. (void*)UART_PC)
+ */
+void MetricsCmd(const char *args, uint16_t len, void *param);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef METRICS_MCU_H */
+
+/*==================[end of file]============================================*/
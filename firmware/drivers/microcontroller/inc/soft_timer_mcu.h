@@ -0,0 +1,160 @@
+#ifndef SOFT_TIMER_MCU_H
+#define SOFT_TIMER_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Soft_Timer Soft timer
+ ** @{ */
+
+/** \brief Software timers multiplexed on a single hardware timer.
+ *
+ * Any number of periodic and one-shot callbacks (up to SOFT_TIMER_MAX active 
+ * at a time) share one free running gptimer (1us resolution). Active timers 
+ * are kept in a min-heap ordered by deadline (O(log n) start and stop), and the 
+ * hardware alarm is always set to the nearest deadline, so there is one 
+ * interrupt per expiration and none in between.
+ * 
+ * @warning The gptimer is taken by SoftTimerInit() and never released (the 
+ * ESP32-C6 has only two). If none is free, SoftTimerInit() fails and timers 
+ * can not be started until a later call gets one.
+ * 
+ * Periodic timers are rescheduled from their previous deadline, not from the 
+ * time the callback ran, so they do not drift. If a callback runs so late that 
+ * whole periods were lost, they are skipped and counted as missed.
+ * 
+ * Callbacks run in the timer ISR: they must be short and in IRAM, and can only 
+ * use FromISR functions. They may start or stop timers (including their own). 
+ * They return true if they woke a higher priority task (the 
+ * xHigherPriorityTaskWoken of the FromISR calls), so the ISR ends with a 
+ * context switch to it.
+ * 
+ * Example:
+ * @code
+ * static bool IRAM_ATTR BlinkLed(void *param){
+ *     LedToggle(LED_1);
+ *     return false;
+ * }
+ * static soft_timer_t blink;
+ * SoftTimerInit();
+ * SoftTimerStart(&blink, 0, 500000, BlinkLed, NULL);	// every 500ms
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * | 19/10/2026 | SoftTimerStartAt() (absolute first expiration)   						|
+ * | 19/10/2026 | Callbacks return the task woken flag           						|
+ * | 19/10/2026 | SoftTimerInit() reports a missing gptimer        						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+/*==================[macros]=================================================*/
+#define SOFT_TIMER_MAX		32		/*!< Most timers active at the same time */
+/*==================[typedef]================================================*/
+/**
+ * @brief Software timer. Allocated by the caller (static or global), must be 
+ * zero initialized and remain valid while active. Fields are internal.
+ */
+typedef struct {
+	bool (*func_p)(void*);	/*!< Callback, returns true if it woke a higher priority task */
+	void *param_p;			/*!< Callback parameter */
+	uint64_t deadline;		/*!< Next expiration (us since SoftTimerInit()) */
+	uint32_t period;		/*!< Period (us) (0: one-shot) */
+	uint8_t slot;			/*!< Position in the heap (0: not active) */
+} soft_timer_t;
+
+/**
+ * @brief Dispatch statistics
+ */
+typedef struct {
+	uint32_t dispatches;	/*!< Callbacks run */
+	uint32_t missed;		/*!< Periods skipped because a periodic timer ran too late */
+	uint32_t last_late_us;	/*!< Delay from deadline to callback, last dispatch */
+	uint32_t max_late_us;	/*!< Delay from deadline to callback, worst case (jitter) */
+	uint32_t max_isr_us;	/*!< Longest timer ISR (dispatch overhead plus callbacks) */
+	uint8_t active;			/*!< Timers active */
+	uint8_t max_active;		/*!< Most timers active at the same time */
+} soft_timer_stats_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Initialize the service and start its hardware timer. Once it succeeds, 
+ * calling it again (from any task) has no effect.
+ * 
+ * @return true if the service is running, false if no gptimer could be taken
+ */
+bool SoftTimerInit(void);
+
+/**
+ * @brief Start (or restart) a software timer
+ * 
+ * @param timer Timer
+ * @param delay Time to the first expiration (us)
+ * @param period Time between expirations (us) (0: one-shot)
+ * @param func_p Callback (bool func(void *param)), called from the timer ISR, 
+ * returns true if it woke a higher priority task
+ * @param param_p Callback parameter
+ * @return true if started, false if SOFT_TIMER_MAX timers are already active 
+ * or the service is not initialized
+ */
+bool SoftTimerStart(soft_timer_t *timer, uint32_t delay, uint32_t period, void *func_p, void *param_p);
+
+/**
+ * @brief Start (or restart) a software timer at an absolute time, e.g. to keep 
+ * several timers in phase
+ * 
+ * @param timer Timer
+ * @param deadline First expiration (us, see SoftTimerNow()), runs right away if already passed
+ * @param period Time between expirations (us) (0: one-shot)
+ * @param func_p Callback (bool func(void *param)), called from the timer ISR, 
+ * returns true if it woke a higher priority task
+ * @param param_p Callback parameter
+ * @return true if started, false if SOFT_TIMER_MAX timers are already active 
+ * or the service is not initialized
+ */
+bool SoftTimerStartAt(soft_timer_t *timer, uint64_t deadline, uint32_t period, void *func_p, void *param_p);
+
+/**
+ * @brief Stop a software timer (no effect if it is not active)
+ * 
+ * @param timer Timer
+ */
+void SoftTimerStop(soft_timer_t *timer);
+
+/**
+ * @brief Check if a timer is active (one-shot timers stop before their callback runs)
+ * 
+ * @param timer Timer
+ * @return true if active
+ */
+bool SoftTimerActive(const soft_timer_t *timer);
+
+/**
+ * @brief Current time of the service (us since SoftTimerInit())
+ * 
+ * @return uint64_t Time (us)
+ */
+uint64_t SoftTimerNow(void);
+
+/**
+ * @brief Read the dispatch statistics
+ * 
+ * @param stats Statistics since SoftTimerInit()
+ */
+void SoftTimerGetStats(soft_timer_stats_t *stats);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef SOFT_TIMER_MCU_H */
+
+/*==================[end of file]============================================*/
@@ -21,6 +21,7 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 09/02/2024 | Document creation		                         						|
+ * | 19/10/2026 | Task notification binding (SpiNotifyTask())      						|
  * 
  **/
 /*==================[inclusions]=============================================*/
@@ -29,6 +30,7 @@
 /*==================[macros]=================================================*/
 
 /*==================[typedef]================================================*/
+typedef struct isr_notify isr_notify_t;	/*!< Task binding (see isr_notify_mcu.h) */
 
 /**
  * @brief ESP-EDU only have 1 SPI port, than can be connected up to 3 diferent devices using 
@@ -108,6 +110,15 @@ void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size);
  */
 void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, uint32_t buffer_size);
 
+/**
+ * @brief Bind a task to a SPI device: it is notified at the end of every 
+ * transaction (device must use SPI_INTERRUPT transfer mode)
+ * 
+ * @param device SPI device
+ * @param notify Binding (see isr_notify_mcu.h), NULL to unbind
+ */
+void SpiNotifyTask(spi_dev_t device, isr_notify_t *notify);
+
 /**
  * @brief De-Initialize SPI module with the corresponding configuration
  * 
@@ -9,6 +9,23 @@
  ** @{ */
 
 /** \brief Timer driver for the ESP-EDU Board.
+ * 
+ * Periods can be changed while a timer runs (TimerSetPeriod()), and several 
+ * timers can be started together with a fixed phase relationship 
+ * (TimerStartGroup()), e.g. to keep DAC and ADC sampling aligned:
+ * @code
+ * const timer_mcu_t group[] = {TIMER_A, TIMER_B};
+ * TimerSetGroupPin(GPIO_23);
+ * TimerStartGroup(group, NULL, 2);
+ * @endcode
+ * 
+ * The counters of a group are started together in hardware: an edge of the 
+ * group pin (TimerSetGroupPin()) is one ETM event that triggers the start task 
+ * of every timer on the same clock cycle, so there is no skew between them. 
+ * The pin is driven by the driver and must not be used for anything else. 
+ * Without a group pin (or a free ETM channel per timer) the timers are started 
+ * one after another by software, and they are offset by the duration of those 
+ * calls.
  * 
  * @author Albano Peñalva
  *
@@ -17,14 +34,21 @@
  * |   Date	    | Description                                    						|
  * |:----------:|:----------------------------------------------------------------------|
  * | 20/10/2023 | Document creation		                         						|
+ * | 19/10/2026 | Runtime period change and group start            						|
+ * | 19/10/2026 | Task notification binding (TimerNotifyTask())    						|
+ * | 19/10/2026 | Captured count and handle access (for ETM)       						|
+ * | 19/10/2026 | Group start through ETM (TimerSetGroupPin())     						|
  * 
  **/
 
 /*==================[inclusions]=============================================*/
 #include "stdint.h"
+#include <stdbool.h>
+#include "gpio_mcu.h"
 /*==================[macros]=================================================*/
 
 /*==================[typedef]================================================*/
+typedef struct isr_notify isr_notify_t;	/*!< Task binding (see isr_notify_mcu.h) */
 /**
  * @brief List of available timers in this driver
  */
@@ -39,7 +63,7 @@ typedef enum timers {
 typedef struct {				
 	timer_mcu_t timer;		/*!< Selected timer */
 	uint32_t period;		/*!< Period (in us) */
-	void *func_p;			/*!< Pointer to callback function to call periodically */
+	void *func_p;			/*!< Pointer to callback function to call periodically (NULL: none, e.g. when using TimerNotifyTask()) */
 	void *param_p;			/*!< Pointer to callback function parameter */
 } timer_config_t;
 /*==================[external data declaration]==============================*/
@@ -75,6 +99,72 @@ void TimerStop(timer_mcu_t timer);
  */
 void TimerReset(timer_mcu_t timer);
 
+/**
+ * @brief Change the period of a timer. If the timer is running, the current 
+ * period ends with its old length and the new one is used from the next alarm, 
+ * so there are no short or long periods.
+ * 
+ * @param timer Timer number
+ * @param period New period (in us)
+ */
+void TimerSetPeriod(timer_mcu_t timer, uint32_t period);
+
+/**
+ * @brief Current period of a timer (or the pending one if a change is waiting 
+ * for the next alarm)
+ * 
+ * @param timer Timer number
+ * @return uint32_t Period (in us)
+ */
+uint32_t TimerGetPeriod(timer_mcu_t timer);
+
+/**
+ * @brief Bind a task to a timer: the alarm ISR notifies it (after the callback, 
+ * if any) and switches to it right away if it has higher priority.
+ * 
+ * @param timer Timer number
+ * @param notify Binding (see isr_notify_mcu.h), NULL to unbind
+ */
+void TimerNotifyTask(timer_mcu_t timer, isr_notify_t *notify);
+
+/**
+ * @brief Count captured by an ETM capture action (see etm_mcu.h)
+ * 
+ * @param timer Timer number
+ * @return uint32_t Captured count (in us since the last reload)
+ */
+uint32_t TimerGetCapture(timer_mcu_t timer);
+
+/**
+ * @brief Underlying gptimer handle, for drivers that link timer events (see etm_mcu.h)
+ * 
+ * @param timer Timer number
+ * @return void* gptimer_handle_t
+ */
+void *TimerGetHandle(timer_mcu_t timer);
+
+/**
+ * @brief Select the GPIO whose edge starts the timers of a group through ETM 
+ * (see TimerStartGroup())
+ * 
+ * @param pin GPIO, free for the driver (it is configured as output and 
+ * pulsed on every group start)
+ */
+void TimerSetGroupPin(gpio_t pin);
+
+/**
+ * @brief Start several timers together (restarting them if running), so that 
+ * their alarms keep an exact phase relationship
+ * 
+ * @param timers Timers
+ * @param phase Time from the start to the first alarm of each timer (in us, 
+ * 0 or NULL: one whole period)
+ * @param count Number of timers
+ * @return true if the counters started on the same clock cycle (ETM), false 
+ * if they were started one after another (no group pin or no ETM channel free)
+ */
+bool TimerStartGroup(const timer_mcu_t *timers, const uint32_t *phase, uint8_t count);
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
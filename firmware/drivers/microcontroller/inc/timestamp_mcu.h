@@ -0,0 +1,67 @@
+#ifndef TIMESTAMP_MCU_H
+#define TIMESTAMP_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Timestamp Timestamp
+ ** @{ */
+
+/** \brief Monotonic microsecond timestamps for acquired data.
+ *
+ * Timestamps come from esp_timer_get_time(): the 64 bit system timer, which 
+ * counts microseconds since boot and needs no gptimer, so it coexists with 
+ * timer_mcu, the soft timers and the ETM pulses on the two gptimers of the 
+ * ESP32-C6. It runs from boot, needs no initialization, does not wrap in 
+ * practice (292000 years) and is ISR safe. Differences of timestamps truncated 
+ * to 32 bit are still valid for intervals up to 71 minutes if computed with 
+ * unsigned subtraction (see TIMESTAMP_DIFF32()).
+ * 
+ * The acquisition drivers stamp their data with this service: HX711 and 
+ * MPU6050 readings, HC-SR04 echoes and ADC blocks (one timestamp per block, the 
+ * time of every sample is derived from it and the sampling rate).
+ * 
+ * @note The CPU cycle counter is not used as time base: it stops while the 
+ * CPU waits for interrupts in the idle task.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+/** Wrap safe difference (us) between two timestamps truncated to 32 bit */
+#define TIMESTAMP_DIFF32(end, start)	((uint32_t)((uint32_t)(end) - (uint32_t)(start)))
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Current time. Can be called from an ISR.
+ * 
+ * @return uint64_t Time (us since boot)
+ */
+uint64_t TimestampNow(void);
+
+/**
+ * @brief Time elapsed since a timestamp
+ * 
+ * @param since Timestamp (us)
+ * @return uint64_t Elapsed time (us)
+ */
+uint64_t TimestampElapsed(uint64_t since);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef TIMESTAMP_MCU_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,151 @@
+#ifndef TRACE_MCU_H
+#define TRACE_MCU_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Microcontroller Drivers microcontroller
+ ** @{ */
+/** \addtogroup Trace Trace
+ ** @{ */
+
+/** \brief Hot path trace recorder.
+ *
+ * Records begin/end (and instant) events with the CPU cycle count in a RAM
+ * ring buffer. Writers only reserve a slot with an atomic increment, so events
+ * can be recorded from tasks and ISRs without locks, in about 40 cycles (250ns
+ * at 160MHz). When the buffer is full the oldest events are overwritten, so
+ * it always holds the last TRACE_BUFFER_SIZE events before a stall.
+ *
+ * The drivers record: WriteLCD (ILI9341), SpiWrite, I2C_readBytes,
+ * AnalogInputReadSingle, HX711_read and the timer and soft timer ISRs.
+ * Application code can add its own ids from TRACE_USER on.
+ *
+ * TraceDump() (or the "trace" command, see TraceCmd()) streams the buffer as
+ * text over UART. firmware/tools/trace converts it to Chrome trace_event JSON
+ * (open it in chrome://tracing or ui.perfetto.dev): one row per task, plus one
+ * for the ISRs.
+ *
+ * Example:
+ * @code
+ * static const uart_cmd_t commands[] = {
+ * 	{"trace", TraceCmd, (void*)UART_PC},
+ * };
+ * TraceStart();
+ * UartCmdInit(UART_PC, commands, 1, '\n');
+ * ...
+ * TraceBegin(TRACE_USER);
+ * Procesar();
+ * TraceEnd(TRACE_USER);
+ * @endcode
+ *
+ * @note The cycle counter stops while the CPU waits for interrupts in the
+ * idle task, so idle gaps look shorter than they are. Durations of begin/end
+ * pairs of busy code are exact.
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ *
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart_mcu.h"
+/*==================[macros]=================================================*/
+#define TRACE_BUFFER_SIZE	1024	/*!< Events kept (power of 2, 12 bytes each) */
+#define TRACE_IDS_MAX		32		/*!< Number of event ids */
+/*==================[typedef]================================================*/
+/**
+ * @brief Event ids recorded by the drivers
+ */
+typedef enum trace_id {
+	TRACE_LCD_WRITE,		/*!< ILI9341 command and data write */
+	TRACE_SPI_WRITE,		/*!< SpiWrite() */
+	TRACE_I2C_READ,			/*!< I2C_readBytes() */
+	TRACE_ADC_READ,			/*!< AnalogInputReadSingle() */
+	TRACE_HX711_READ,		/*!< HX711_read() (includes waiting for the conversion) */
+	TRACE_TIMER_A_ISR,		/*!< Timer A ISR */
+	TRACE_TIMER_B_ISR,		/*!< Timer B ISR */
+	TRACE_TIMER_C_ISR,		/*!< Timer C ISR */
+	TRACE_SOFT_TIMER_ISR,	/*!< Soft timer ISR */
+	TRACE_USER,				/*!< First id free for the application */
+} trace_id_t;
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Clear the buffer and start recording
+ */
+void TraceStart(void);
+
+/**
+ * @brief Stop recording (the buffer is kept)
+ */
+void TraceStop(void);
+
+/**
+ * @brief Name shown for an event id (driver ids are already named)
+ *
+ * @param id Event id (less than TRACE_IDS_MAX)
+ * @param name Name, must remain valid
+ */
+void TraceSetName(uint16_t id, const char *name);
+
+/**
+ * @brief Record the beginning of an event. Can be called from an ISR.
+ *
+ * @param id Event id
+ */
+void TraceBegin(uint16_t id);
+
+/**
+ * @brief Record the end of an event. Can be called from an ISR.
+ *
+ * @param id Event id
+ */
+void TraceEnd(uint16_t id);
+
+/**
+ * @brief Record an instant event. Can be called from an ISR.
+ *
+ * @param id Event id
+ */
+void TraceMark(uint16_t id);
+
+/**
+ * @brief Send the recorded events over UART, oldest first. Recording is paused
+ * while sending and resumed afterwards if it was running.
+ *
+ * Format (one line each): "# trace <cpu MHz> <events> <overwritten>",
+ * "N <id> <name>" for every named id, "<B|E|i> <cycles> <id> <task>" for every
+ * event (task 0: ISR) and "# end". Names are cut at 40 characters.
+ *
+ * Each line is sent whole through UartSendString(), which blocks until it
+ * fits the UART driver buffer. With the buffered transmitter enabled the
+ * lines follow its overflow policy, so use UART_TX_BLOCK not to lose any.
+ *
+ * @param port Port (already initialized)
+ */
+void TraceDump(uart_mcu_port_t port);
+
+/**
+ * @brief Command handler for UartCmdInit(). Arguments: "start", "stop" or
+ * "dump" (default). The dump blocks the port command processing while it is
+ * being sent.
+ *
+ * @param args Command arguments
+ * @param len Length of args
+ * @param param Port to dump to, cast to void* (e.g. (void*)UART_PC)
+ */
+void TraceCmd(const char *args, uint16_t len, void *param);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef TRACE_MCU_H */
+
+/*==================[end of file]============================================*/
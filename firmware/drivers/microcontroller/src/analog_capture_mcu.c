@@ -0,0 +1,203 @@
+/**
+ * @file analog_capture_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "analog_capture_mcu.h"
+#include "analog_io_mcu.h"
+#include "freertos/FreeRTOS.h"
+#include <stddef.h>
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+static analog_capture_config_t capture;				/*!< Capture configuration */
+static volatile capture_state_t capture_state = CAPTURE_IDLE;	/*!< Engine state */
+static uint16_t capture_pos = 0;					/*!< Pre-trigger ring position (oldest sample) */
+static uint16_t capture_count = 0;					/*!< Samples stored in current phase */
+static bool capture_primed = false;					/*!< Signal went past the hysteresis band */
+static volatile bool capture_force = false;			/*!< Trigger on next sample */
+static uint32_t capture_records = 0;				/*!< Records captured */
+static uint64_t capture_time = 0;					/*!< Time of the trigger sample of the last record (us) */
+static portMUX_TYPE capture_spinlock = portMUX_INITIALIZER_UNLOCKED;
+/*==================[internal functions declaration]=========================*/
+static void capture_reverse(uint16_t *data, uint16_t len);
+static bool capture_trigger(uint16_t value);
+static void capture_restart(void);
+static void capture_block(const uint16_t *block, uint16_t len);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Reverse a buffer in place
+ */
+static void capture_reverse(uint16_t *data, uint16_t len){
+	for(uint16_t i = 0, j = len - 1; i < j; i++, j--){
+		uint16_t tmp = data[i];
+		data[i] = data[j];
+		data[j] = tmp;
+	}
+}
+
+/**
+ * @brief Evaluate the trigger condition for a new sample
+ */
+static bool capture_trigger(uint16_t value){
+	int32_t v = value;
+	int32_t level = capture.level;
+	switch(capture.trigger){
+	case CAPTURE_RISING:
+	case CAPTURE_HIGH:
+		if(v < level - capture.hysteresis){
+			capture_primed = true;
+		}
+		else if(capture_primed && v >= level){
+			return true;
+		}
+		break;
+	case CAPTURE_FALLING:
+	case CAPTURE_LOW:
+		if(v > level + capture.hysteresis){
+			capture_primed = true;
+		}
+		else if(capture_primed && v <= level){
+			return true;
+		}
+		break;
+	}
+	return false;
+}
+
+/**
+ * @brief Start a new record, with the trigger primed as configured
+ */
+static void capture_restart(void){
+	/* Edge triggers need to see the signal on the other side of the level first */
+	capture_primed = (capture.trigger == CAPTURE_HIGH || capture.trigger == CAPTURE_LOW);
+	capture_pos = 0;
+	capture_count = 0;
+	capture_state = (capture.pre > 0) ? CAPTURE_FILLING : CAPTURE_ARMED;
+}
+
+/**
+ * @brief Block listener, runs in the ADC acquisition task
+ */
+static void capture_block(const uint16_t *block, uint16_t len){
+	uint16_t i = 0;
+	while(i < len){
+		bool complete = false;
+		portENTER_CRITICAL(&capture_spinlock);
+		for(; i < len && !complete; i++){
+			uint16_t value = block[i];
+			switch(capture_state){
+			case CAPTURE_FILLING:
+			case CAPTURE_ARMED:
+				if(capture_state == CAPTURE_ARMED && (capture_trigger(value) || capture_force)){
+					capture_force = false;
+					capture.buffer[capture.pre] = value;
+					capture_time = AnalogInputBlockTime(i);
+					capture_count = 1;
+					capture_state = CAPTURE_TRIGGERED;
+					complete = (capture.post == 1);
+					break;
+				}
+				if(capture.pre > 0){
+					/* Evaluating the trigger while filling keeps the hysteresis state valid */
+					if(capture_state == CAPTURE_FILLING){
+						capture_trigger(value);
+					}
+					capture.buffer[capture_pos] = value;
+					if(++capture_pos == capture.pre){
+						capture_pos = 0;
+					}
+					if(capture_state == CAPTURE_FILLING && ++capture_count == capture.pre){
+						capture_state = CAPTURE_ARMED;
+					}
+				}
+				break;
+			case CAPTURE_TRIGGERED:
+				capture.buffer[capture.pre + capture_count] = value;
+				complete = (++capture_count == capture.post);
+				break;
+			default:
+				break;
+			}
+		}
+		if(complete){
+			/* Rotate the pre-trigger ring so the record is time ordered */
+			if(capture_pos != 0){
+				capture_reverse(capture.buffer, capture_pos);
+				capture_reverse(&capture.buffer[capture_pos], capture.pre - capture_pos);
+				capture_reverse(capture.buffer, capture.pre);
+			}
+			capture_records++;
+			capture_state = CAPTURE_DONE;
+		}
+		portEXIT_CRITICAL(&capture_spinlock);
+		if(complete){
+			if(capture.func_p != NULL){
+				capture.func_p(capture.buffer, capture.pre + capture.post, capture.param_p);
+			}
+			portENTER_CRITICAL(&capture_spinlock);
+			if(capture.mode == CAPTURE_NORMAL && capture_state == CAPTURE_DONE){
+				capture_restart();
+			}
+			portEXIT_CRITICAL(&capture_spinlock);
+		}
+	}
+}
+
+/*==================[external functions definition]==========================*/
+void AnalogCaptureInit(analog_capture_config_t *config){
+	AnalogInputBlockListener(NULL);
+	capture = *config;
+	if(capture.post == 0){
+		capture.post = 1;
+	}
+	capture_state = CAPTURE_IDLE;
+	capture_records = 0;
+	AnalogInputBlockListener(capture_block);
+}
+
+void AnalogCaptureArm(void){
+	portENTER_CRITICAL(&capture_spinlock);
+	capture_force = false;
+	capture_restart();
+	portEXIT_CRITICAL(&capture_spinlock);
+}
+
+void AnalogCaptureStop(void){
+	portENTER_CRITICAL(&capture_spinlock);
+	capture_state = CAPTURE_IDLE;
+	portEXIT_CRITICAL(&capture_spinlock);
+}
+
+void AnalogCaptureForce(void){
+	capture_force = true;
+}
+
+capture_state_t AnalogCaptureState(void){
+	return capture_state;
+}
+
+uint32_t AnalogCaptureCount(void){
+	return capture_records;
+}
+
+uint64_t AnalogCaptureTime(void){
+	uint64_t time;
+	portENTER_CRITICAL(&capture_spinlock);
+	time = capture_time;
+	portEXIT_CRITICAL(&capture_spinlock);
+	return time;
+}
+
+/*==================[end of file]============================================*/
@@ -11,21 +11,141 @@
 
 /*==================[inclusions]=============================================*/
 #include "analog_io_mcu.h"
+#include <stdlib.h>
+#include <string.h>
 #include "driver/gptimer.h"
 #include "driver/sdm.h"
 #include "esp_adc/adc_cali_scheme.h"
 #include "esp_adc/adc_oneshot.h"
 #include "esp_adc/adc_continuous.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "timestamp_mcu.h"
+#include "trace_mcu.h"
+#include "metrics_mcu.h"
+#include <math.h>
 /*==================[macros and definitions]=================================*/
 #define ADC_BITWIDTH 		SOC_ADC_DIGI_MAX_BITWIDTH	// 12 bit resolution
 #define ADC_ATTENUATION		ADC_ATTEN_DB_11				// 12dB attenuation (for 0-3,3V ADC range)
+#define ADC_CH_QTY			4							// Number of analog inputs in ESP-EDU
+#define ADC_LUT_SIZE		(1 << ADC_BITWIDTH)			// One entry per raw ADC code
+#define ADC_FRAME_RESULTS	64							// Results per DMA conversion frame
+#define ADC_CONV_FRAME_SIZE	(ADC_FRAME_RESULTS * SOC_ADC_DIGI_RESULT_BYTES)	// DMA conversion frame
+#define ADC_POOL_SIZE		(4 * ADC_CONV_FRAME_SIZE)	// Driver internal pool
+#define ADC_CIC_ORDER		3							// CIC decimator stages
+#define ADC_TASK_STACK		2048						// Continuous acquisition task stack
+#define ADC_TASK_PRIORITY	10							// Continuous acquisition task priority
+#define DAC_TIMER_RES_HZ	1000000						// DAC update timer resolution (1usec)
+#define DAC_MIDSCALE		128							// DAC output for 0 pulse density
+#define DAC_GAIN_UNITY		256							// Unity gain for playback (Q8)
+#define DAC_PHASE_BITS		16							// Fractional bits of playback position
+/**
+ * @brief Decimation filter state for a continuous channel
+ */
+typedef struct {
+	uint32_t integ[ADC_CIC_ORDER];	/*!< Integrators (boxcar only uses integ[0]) */
+	uint32_t delay[ADC_CIC_ORDER];	/*!< Comb delays (CIC only) */
+	uint16_t count;					/*!< Samples accumulated for current output */
+} adc_decimator_t;
+/**
+ * @brief Continuous mode configuration and state for one channel
+ */
+typedef struct {
+	void (*func_p)(void*);			/*!< Block ready callback */
+	void *param_p;					/*!< Block ready callback parameter */
+	uint32_t sample_frec;			/*!< Output frequency (Hz) */
+	uint16_t ratio;					/*!< Oversampling ratio (power of 2) */
+	uint8_t log2_ratio;				/*!< log2(ratio) */
+	uint8_t shift;					/*!< Right shift applied to decimator output */
+	adc_decim_t decimation;			/*!< Decimation filter */
+	adc_decimator_t decim;			/*!< Decimation filter state */
+} adc_cont_t;
+/**
+ * @brief Sample table used by the playback engine
+ */
+typedef struct {
+	const uint8_t *table;			/*!< Samples */
+	uint16_t len;					/*!< Number of samples */
+} dac_table_t;
 /*==================[internal data declaration]==============================*/
 adc_cali_handle_t adc_calibration_single, adc_calibration_cont;
 adc_oneshot_unit_handle_t adc1_single; 
-adc_continuous_handle_t adc2_cont;
+adc_continuous_handle_t adc2_cont = NULL;
 sdm_channel_handle_t dac = NULL;
 bool adc1_single_used = false;
+static uint16_t *adc_mv_lut[ADC_CH_QTY];				/*!< Raw to mV tables, allocated for initialized channels (at ADC_ATTENUATION) */
+static adc_cali_handle_t adc_cali[ADC_CH_QTY];			/*!< Calibration of the channels without table (not enough memory) */
+static uint8_t adc_extra_bits[ADC_CH_QTY];				/*!< Resolution added by oversampling, per channel */
+static adc_cont_t adc_cont[ADC_CH_QTY];					/*!< Continuous mode channels */
+static adc_ch_t adc_cont_channel;						/*!< Channel being converted in continuous mode */
+static bool adc_cont_running = false;					/*!< Continuous conversion running */
+static TaskHandle_t adc_cont_task_handle = NULL;		/*!< Continuous acquisition task */
+static uint8_t adc_frame[ADC_CONV_FRAME_SIZE];			/*!< DMA results read by the acquisition task */
+static uint16_t adc_block[2][ADC_BLOCK_SIZE];			/*!< Output blocks (one being filled, one ready) */
+static uint8_t adc_block_fill = 0;						/*!< Index of block being filled */
+static uint16_t adc_block_count = 0;					/*!< Values in block being filled */
+static void (*adc_block_listener)(const uint16_t*, uint16_t) = NULL;	/*!< Receives every complete block */
+static uint32_t adc_raw_frec = 1;						/*!< Raw ADC sample frequency (Hz) */
+static uint64_t adc_done_time = 0;						/*!< Time the last DMA frame was completed (us) */
+static uint32_t adc_frames_done = 0;					/*!< DMA frames completed since start */
+static uint32_t adc_frames_read = 0;					/*!< DMA frames read by the acquisition task since start */
+static uint64_t adc_block_time = 0;						/*!< Time of the first sample of the last complete block (us) */
+static portMUX_TYPE adc_time_lock = portMUX_INITIALIZER_UNLOCKED;
+static gptimer_handle_t dac_timer = NULL;				/*!< DAC update timer */
+static uint8_t (*dac_source_p)(void*) = NULL;			/*!< Function called on every DAC update to get the next sample */
+static void *dac_source_param = NULL;					/*!< Parameter for dac_source_p */
+static dac_table_t dac_play_table;						/*!< Table being played */
+static volatile dac_table_t dac_play_next_table;		/*!< Table queued by AnalogOutputPlaySwap() */
+static volatile bool dac_play_swap = false;				/*!< A queued table is waiting for the end of the current one */
+static uint32_t dac_play_pos = 0;						/*!< Playback position (16.16 fixed point) */
+static uint32_t dac_play_step = 0;						/*!< Position increment per DAC update (16.16 fixed point) */
+static volatile uint16_t dac_play_gain = DAC_GAIN_UNITY;	/*!< Amplitude scale (Q8) */
+static bool dac_play_loop = true;						/*!< Restart table at the end */
+static bool dac_play_interpolate = false;				/*!< Linear interpolation between samples */
+static volatile bool dac_play_done = false;				/*!< Non looping table reached its end */
+static uint32_t dac_stat_last = 0;						/*!< Cycle count of the last DAC update */
+static analog_output_stats_t dac_stats;					/*!< DAC update timing (in cpu cycles) */
+static portMUX_TYPE dac_spinlock = portMUX_INITIALIZER_UNLOCKED;
 /*==================[internal functions declaration]=========================*/
+static void adc_lut_build(adc_ch_t channel);
+static uint16_t adc_cali_mv(adc_ch_t channel, uint32_t raw);
+static uint32_t adc_decimate(adc_cont_t *ch, uint32_t raw, bool *done);
+static uint64_t adc_frame_end(void);
+static void adc_cont_task(void *pvParameters);
+static uint8_t dac_play_next(void *param);
+static bool dac_timer_setup(uint32_t update_frec);
+static bool IRAM_ATTR dac_timer_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+	uint32_t now = esp_cpu_get_cycle_count();
+	if(dac_stats.updates > 0){
+		uint32_t period = now - dac_stat_last;
+		if(period < dac_stats.period_min){
+			dac_stats.period_min = period;
+		}
+		if(period > dac_stats.period_max){
+			dac_stats.period_max = period;
+		}
+	}
+	dac_stat_last = now;
+	dac_stats.updates++;
+	sdm_channel_set_pulse_density(dac, (int8_t)(dac_source_p(dac_source_param) - DAC_MIDSCALE));
+	return false;
+}
+static bool IRAM_ATTR adc_conv_done_isr(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	portENTER_CRITICAL_ISR(&adc_time_lock);
+	adc_done_time = TimestampNow();
+	adc_frames_done++;
+	portEXIT_CRITICAL_ISR(&adc_time_lock);
+	MetricsAdd(METRICS_ADC_FRAMES, 1);
+	vTaskNotifyGiveFromISR(adc_cont_task_handle, &xHigherPriorityTaskWoken);
+	return (xHigherPriorityTaskWoken == pdTRUE);
+}
+static bool IRAM_ATTR adc_pool_ovf_isr(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data){
+	MetricsAdd(METRICS_ADC_OVERRUNS, 1);
+	return false;
+}
 
 /*==================[internal data definition]===============================*/
 adc_oneshot_unit_init_cfg_t init_config_single = {
@@ -36,9 +156,243 @@ adc_oneshot_chan_cfg_t adc_config_single = {
 	.bitwidth = ADC_BITWIDTH,
 	.atten = ADC_ATTENUATION,
 };					
+const adc_channel_t adc_channel_list[ADC_CH_QTY] = {
+	ADC_CHANNEL_0, ADC_CHANNEL_1, ADC_CHANNEL_2, ADC_CHANNEL_3
+};
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Evaluate the calibration curve for every raw code of a channel, so 
+ * conversions become a single table access. The table (8KB) is allocated the 
+ * first time the channel is initialized, so projects that do not use the ADC 
+ * do not pay for it. If it cannot be allocated, the calibration is kept and 
+ * evaluated on every conversion instead.
+ * 
+ * @param channel Channel selected
+ */
+static void adc_lut_build(adc_ch_t channel){
+	int mv;
+	adc_cali_curve_fitting_config_t cali_config = {
+		.unit_id = ADC_UNIT_1,
+		.chan = adc_channel_list[channel],
+		.atten = ADC_ATTENUATION,
+		.bitwidth = ADC_BITWIDTH,
+	};
+	if(adc_mv_lut[channel] != NULL || adc_cali[channel] != NULL){
+		/* Already calibrated */
+		return;
+	}
+	adc_cali_create_scheme_curve_fitting(&cali_config, &adc_calibration_single);
+	adc_mv_lut[channel] = malloc(ADC_LUT_SIZE * sizeof(uint16_t));
+	if(adc_mv_lut[channel] == NULL){
+		adc_cali[channel] = adc_calibration_single;
+		return;
+	}
+	for(uint32_t raw = 0; raw < ADC_LUT_SIZE; raw++){
+		mv = 0;
+		adc_cali_raw_to_voltage(adc_calibration_single, raw, &mv);
+		adc_mv_lut[channel][raw] = mv;
+	}
+	adc_cali_delete_scheme_curve_fitting(adc_calibration_single);
+}
+
+/**
+ * @brief Raw to mV with the calibration of a channel without table
+ */
+static uint16_t adc_cali_mv(adc_ch_t channel, uint32_t raw){
+	int mv = 0;
+	adc_cali_raw_to_voltage(adc_cali[channel], raw, &mv);
+	return mv;
+}
+
+/**
+ * @brief Feed one raw sample to the decimation filter of a channel.
+ * 
+ * @param ch Continuous channel
+ * @param raw Raw sample (12 bits)
+ * @param done Set to true when a new output value is available
+ * @return uint32_t Output value (12 + log2(ratio)/2 bits), valid when done is true
+ */
+static uint32_t adc_decimate(adc_cont_t *ch, uint32_t raw, bool *done){
+	adc_decimator_t *d = &ch->decim;
+	uint32_t out;
+	*done = false;
+	if(ch->decimation == ADC_DECIM_CIC){
+		/* Integrators run at input rate. Unsigned wrap-around is harmless as long
+		 * as the register width covers 12 + ADC_CIC_ORDER*log2(ratio) bits */
+		d->integ[0] += raw;
+		d->integ[1] += d->integ[0];
+		d->integ[2] += d->integ[1];
+	} else{
+		d->integ[0] += raw;
+	}
+	if(++d->count < ch->ratio){
+		return 0;
+	}
+	d->count = 0;
+	if(ch->decimation == ADC_DECIM_CIC){
+		/* Combs run at output rate */
+		out = d->integ[2];
+		for(uint8_t i = 0; i < ADC_CIC_ORDER; i++){
+			uint32_t tmp = out;
+			out -= d->delay[i];
+			d->delay[i] = tmp;
+		}
+	} else{
+		out = d->integ[0];
+		d->integ[0] = 0;
+	}
+	*done = true;
+	return out >> ch->shift;
+}
+
+/**
+ * @brief Time of the last result of the DMA frame being read, from the time 
+ * the last frame was completed and the frames completed after it.
+ * 
+ * @return uint64_t Timestamp (us)
+ */
+static uint64_t adc_frame_end(void){
+	uint64_t done_time;
+	uint32_t pending;
+	portENTER_CRITICAL(&adc_time_lock);
+	done_time = adc_done_time;
+	pending = adc_frames_done - 1 - adc_frames_read;
+	portEXIT_CRITICAL(&adc_time_lock);
+	adc_frames_read++;
+	return done_time - (uint64_t)pending * ADC_FRAME_RESULTS * 1000000 / adc_raw_frec;
+}
+
+/**
+ * @brief Acquisition task for continuous mode: drains DMA frames, decimates 
+ * them and delivers complete blocks to the user callback.
+ */
+static void adc_cont_task(void *pvParameters){
+	uint32_t length;
+	bool done;
+	uint32_t value;
+	uint64_t frame_end;
+	while(1){
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		while(adc_cont_running && 
+			adc_continuous_read(adc2_cont, adc_frame, ADC_CONV_FRAME_SIZE, &length, 0) == ESP_OK){
+			adc_cont_t *ch = &adc_cont[adc_cont_channel];
+			uint32_t results = length / SOC_ADC_DIGI_RESULT_BYTES;
+			frame_end = adc_frame_end();
+			for(uint32_t i = 0; i < length; i += SOC_ADC_DIGI_RESULT_BYTES){
+				adc_digi_output_data_t *p = (adc_digi_output_data_t*)&adc_frame[i];
+				value = adc_decimate(ch, p->type2.data, &done);
+				if(!done){
+					continue;
+				}
+				adc_block[adc_block_fill][adc_block_count++] = value;
+				if(adc_block_count == ADC_BLOCK_SIZE){
+					adc_block_count = 0;
+					/* Last sample time, back to the first one of the block */
+					uint64_t elapsed = (uint64_t)(results - 1 - i / SOC_ADC_DIGI_RESULT_BYTES) * 1000000 / adc_raw_frec;
+					elapsed += (uint64_t)(ADC_BLOCK_SIZE - 1) * ch->ratio * 1000000 / adc_raw_frec;
+					portENTER_CRITICAL(&adc_time_lock);
+					adc_block_time = frame_end - elapsed;
+					portEXIT_CRITICAL(&adc_time_lock);
+					if(adc_block_listener != NULL){
+						adc_block_listener(adc_block[adc_block_fill], ADC_BLOCK_SIZE);
+					}
+					adc_block_fill ^= 1;
+					if(ch->func_p != NULL){
+						ch->func_p(ch->param_p);
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Create (first time) and configure the DAC update timer. Timer is 
+ * left stopped.
+ * 
+ * @param update_frec DAC update frequency (Hz)
+ * @return true if configured, false if no gptimer is free (or update_frec is 
+ * out of range)
+ */
+static bool dac_timer_setup(uint32_t update_frec){
+	esp_err_t err = ESP_OK;
+	if(update_frec == 0 || update_frec > DAC_TIMER_RES_HZ){
+		return false;
+	}
+	if(dac_timer == NULL){
+		gptimer_config_t timer_config = {
+			.clk_src = GPTIMER_CLK_SRC_DEFAULT,
+			.direction = GPTIMER_COUNT_UP,
+			.resolution_hz = DAC_TIMER_RES_HZ,
+		};
+		gptimer_event_callbacks_t cbs = {
+			.on_alarm = dac_timer_isr,
+		};
+		gptimer_handle_t timer = NULL;
+		err = gptimer_new_timer(&timer_config, &timer);
+		if(err == ESP_OK){
+			err = gptimer_register_event_callbacks(timer, &cbs, NULL);
+		}
+		if(err == ESP_OK){
+			err = gptimer_enable(timer);
+		}
+		if(err != ESP_OK){
+			if(timer != NULL){
+				gptimer_del_timer(timer);
+			}
+			return false;
+		}
+		dac_timer = timer;
+	}
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = DAC_TIMER_RES_HZ / update_frec,
+		.reload_count = 0,
+		.flags.auto_reload_on_alarm = true,
+	};
+	err = gptimer_set_alarm_action(dac_timer, &alarm_config);
+	return (err == ESP_OK);
+}
+
+/**
+ * @brief Playback engine sample source (called from the DAC timer ISR).
+ */
+static uint8_t IRAM_ATTR dac_play_next(void *param){
+	uint32_t idx = dac_play_pos >> DAC_PHASE_BITS;
+	int32_t sample = dac_play_table.table[idx];
+	if(dac_play_interpolate){
+		uint32_t next = idx + 1;
+		if(next >= dac_play_table.len){
+			next = dac_play_loop ? 0 : idx;
+		}
+		uint32_t frac = dac_play_pos & ((1 << DAC_PHASE_BITS) - 1);
+		sample += ((dac_play_table.table[next] - sample) * (int32_t)frac) >> DAC_PHASE_BITS;
+	}
+	sample = DAC_MIDSCALE + (((sample - DAC_MIDSCALE) * dac_play_gain) >> 8);
+	if(sample < 0){
+		sample = 0;
+	} else if(sample > UINT8_MAX){
+		sample = UINT8_MAX;
+	}
+	if(!dac_play_done){
+		dac_play_pos += dac_play_step;
+		if((dac_play_pos >> DAC_PHASE_BITS) >= dac_play_table.len){
+			if(dac_play_swap){
+				dac_play_table.table = dac_play_next_table.table;
+				dac_play_table.len = dac_play_next_table.len;
+				dac_play_swap = false;
+				dac_play_pos = 0;
+			} else if(dac_play_loop){
+				dac_play_pos -= (uint32_t)dac_play_table.len << DAC_PHASE_BITS;
+			} else{
+				dac_play_pos = (uint32_t)(dac_play_table.len - 1) << DAC_PHASE_BITS;
+				dac_play_done = true;
+			}
+		}
+	}
+	return sample;
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -47,13 +401,8 @@ void AnalogInputInit(analog_input_config_t *config){
 	// config adc channels
 	switch(config->mode){
 		case ADC_SINGLE:
-			// create calibration curve
-			adc_cali_curve_fitting_config_t cali_config_1 = {
-				.unit_id = ADC_UNIT_1,
-				.atten = ADC_ATTENUATION,
-				.bitwidth = ADC_BITWIDTH,
-			};
-			adc_cali_create_scheme_curve_fitting(&cali_config_1, &adc_calibration_single);
+			// evaluate calibration curve once for this channel
+			adc_lut_build(config->input);
         	if(!adc1_single_used){
 				adc_oneshot_new_unit(&init_config_single, &adc1_single);
 				adc1_single_used = true;
@@ -74,19 +423,28 @@ void AnalogInputInit(analog_input_config_t *config){
 			}
 		break;
 		case ADC_CONTINUOUS:
-			switch(config->input){
-				case CH0:
-
-				break;
-				case CH1:
-
-				break;
-				case CH2:
-
-				break;
-				case CH3:
-
-				break;
+			adc_lut_build(config->input);
+			adc_cont_t *ch = &adc_cont[config->input];
+			memset(ch, 0, sizeof(adc_cont_t));
+			ch->func_p = config->func_p;
+			ch->param_p = config->param_p;
+			ch->sample_frec = config->sample_frec;
+			ch->decimation = config->decimation;
+			ch->ratio = 1;
+			while((ch->ratio << 1) <= config->oversampling && ch->log2_ratio < ADC_MAX_LOG2_OVERSAMPLING){
+				ch->ratio <<= 1;
+				ch->log2_ratio++;
+			}
+			if(ch->decimation == ADC_DECIM_CIC && ch->log2_ratio > ADC_MAX_LOG2_OVERSAMPLING_CIC){
+				ch->ratio = 1 << ADC_MAX_LOG2_OVERSAMPLING_CIC;
+				ch->log2_ratio = ADC_MAX_LOG2_OVERSAMPLING_CIC;
+			}
+			// every 4x oversampling adds 1 bit of resolution (with white input noise)
+			adc_extra_bits[config->input] = ch->log2_ratio / 2;
+			ch->shift = ch->log2_ratio - adc_extra_bits[config->input];
+			if(ch->decimation == ADC_DECIM_CIC){
+				// CIC gain is ratio^order
+				ch->shift += (ADC_CIC_ORDER - 1) * ch->log2_ratio;
 			}
 		break;
 	}
@@ -103,38 +461,134 @@ void AnalogOutputInit(void){
 }
 
 void AnalogInputReadSingle(adc_ch_t channel, uint16_t *value){
-	switch(channel){
-		case CH0:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_0, (int*)value);
-		break;
-		case CH1:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_1, (int*)value);
-		break;
-		case CH2:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_2, (int*)value);
-		break;
-		case CH3:
-			adc_oneshot_read(adc1_single, ADC_CHANNEL_3, (int*)value);
-		break;
-	}
+	int raw = 0;
+	TraceBegin(TRACE_ADC_READ);
+	adc_oneshot_read(adc1_single, adc_channel_list[channel], &raw);
+	TraceEnd(TRACE_ADC_READ);
+	*value = raw;
 }
 
 void AnalogStartContinuous(adc_ch_t channel){
-
+	adc_cont_t *ch = &adc_cont[channel];
+	uint32_t sample_freq = ch->sample_frec * ch->ratio;
+	if(adc_cont_running){
+		AnalogStopContinuous(adc_cont_channel);
+	}
+	if(adc2_cont == NULL){
+		adc_continuous_handle_cfg_t handle_config = {
+			.max_store_buf_size = ADC_POOL_SIZE,
+			.conv_frame_size = ADC_CONV_FRAME_SIZE,
+		};
+		adc_continuous_new_handle(&handle_config, &adc2_cont);
+		adc_continuous_evt_cbs_t cbs = {
+			.on_conv_done = adc_conv_done_isr,
+			.on_pool_ovf = adc_pool_ovf_isr,
+		};
+		adc_continuous_register_event_callbacks(adc2_cont, &cbs, NULL);
+		xTaskCreate(adc_cont_task, "adc_cont_task", ADC_TASK_STACK, NULL, ADC_TASK_PRIORITY, &adc_cont_task_handle);
+	}
+	if(sample_freq < SOC_ADC_SAMPLE_FREQ_THRES_LOW){
+		sample_freq = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+	} else if(sample_freq > SOC_ADC_SAMPLE_FREQ_THRES_HIGH){
+		sample_freq = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+	}
+	adc_digi_pattern_config_t pattern = {
+		.atten = ADC_ATTENUATION,
+		.channel = adc_channel_list[channel],
+		.unit = ADC_UNIT_1,
+		.bit_width = ADC_BITWIDTH,
+	};
+	adc_continuous_config_t cont_config = {
+		.pattern_num = 1,
+		.adc_pattern = &pattern,
+		.sample_freq_hz = sample_freq,
+		.conv_mode = ADC_CONV_SINGLE_UNIT_1,
+		.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+	};
+	adc_continuous_config(adc2_cont, &cont_config);
+	memset(&ch->decim, 0, sizeof(adc_decimator_t));
+	adc_block_fill = 0;
+	adc_block_count = 0;
+	adc_raw_frec = sample_freq;
+	adc_frames_done = 0;
+	adc_frames_read = 0;
+	adc_cont_channel = channel;
+	adc_cont_running = true;
+	adc_continuous_start(adc2_cont);
 }
 
 void AnalogStopContinuous(adc_ch_t channel){
-
+	if(adc_cont_running && adc_cont_channel == channel){
+		adc_cont_running = false;
+		adc_continuous_stop(adc2_cont);
+	}
 }
 
 void AnalogInputReadContinuous(adc_ch_t channel, uint16_t *values){
+	memcpy(values, adc_block[adc_block_fill ^ 1], sizeof(adc_block[0]));
+}
 
+void AnalogInputBlockListener(void (*listener)(const uint16_t *block, uint16_t len)){
+	adc_block_listener = listener;
 }
 
-uint16_t AnalogRaw2mV(uint16_t value){
-	uint16_t volt;
-	adc_cali_raw_to_voltage(adc_calibration_single, value, (int*)&volt);
-	return volt;
+uint64_t AnalogInputBlockTime(uint16_t index){
+	uint64_t time;
+	portENTER_CRITICAL(&adc_time_lock);
+	time = adc_block_time;
+	portEXIT_CRITICAL(&adc_time_lock);
+	return time + (uint64_t)index * adc_cont[adc_cont_channel].ratio * 1000000 / adc_raw_frec;
+}
+
+uint16_t AnalogRaw2mV(adc_ch_t channel, uint16_t value){
+	if(adc_mv_lut[channel] == NULL){
+		return adc_cali_mv(channel, value & (ADC_LUT_SIZE - 1));
+	}
+	return adc_mv_lut[channel][value & (ADC_LUT_SIZE - 1)];
+}
+
+void AnalogRaw2mVBuffer(adc_ch_t channel, const uint16_t *values, uint16_t *mv, uint32_t len){
+	const uint16_t *lut = adc_mv_lut[channel];
+	uint8_t extra = adc_extra_bits[channel];
+	if(lut == NULL){
+		/* No table: evaluate the calibration of the 12 bit part */
+		for(uint32_t i = 0; i < len; i++){
+			mv[i] = adc_cali_mv(channel, (values[i] >> extra) & (ADC_LUT_SIZE - 1));
+		}
+	} else if(extra == 0){
+		for(uint32_t i = 0; i < len; i++){
+			mv[i] = lut[values[i] & (ADC_LUT_SIZE - 1)];
+		}
+	} else{
+		/* Oversampled values: interpolate between the two closest table entries */
+		uint32_t frac_mask = (1 << extra) - 1;
+		for(uint32_t i = 0; i < len; i++){
+			uint32_t idx = values[i] >> extra;
+			int32_t lo = lut[idx];
+			int32_t hi = (idx < ADC_LUT_SIZE - 1) ? lut[idx + 1] : lo;
+			mv[i] = lo + (((hi - lo) * (int32_t)(values[i] & frac_mask)) >> extra);
+		}
+	}
+}
+
+float AnalogInputEnob(const uint16_t *values, uint32_t len, uint8_t bits){
+	double mean = 0, var = 0;
+	if(len < 2){
+		return bits;
+	}
+	for(uint32_t i = 0; i < len; i++){
+		mean += values[i];
+	}
+	mean /= len;
+	for(uint32_t i = 0; i < len; i++){
+		var += (values[i] - mean) * (values[i] - mean);
+	}
+	var /= (len - 1);
+	/* An ideal N bits converter only has quantization noise: 1/12 LSB^2 */
+	if(var < 1.0 / 12.0){
+		return bits;
+	}
+	return bits - 0.5 * log2(12.0 * var);
 }
 
 void AnalogOutputWrite(uint8_t value){
@@ -142,6 +596,83 @@ void AnalogOutputWrite(uint8_t value){
 	sdm_channel_set_pulse_density(dac, density);
 }
 
+bool AnalogOutputPlayInit(analog_output_play_t *config){
+	uint32_t update_frec = config->update_frec ? config->update_frec : config->sample_frec;
+	AnalogOutputPlayStop();
+	dac_play_table.table = config->table;
+	dac_play_table.len = config->len;
+	dac_play_swap = false;
+	dac_play_done = false;
+	dac_play_pos = 0;
+	dac_play_step = ((uint64_t)config->sample_frec << DAC_PHASE_BITS) / update_frec;
+	dac_play_loop = config->loop;
+	dac_play_interpolate = config->interpolate;
+	dac_play_gain = config->gain ? config->gain : DAC_GAIN_UNITY;
+	dac_source_p = dac_play_next;
+	dac_source_param = NULL;
+	return dac_timer_setup(update_frec);
+}
+
+void AnalogOutputPlayStart(void){
+	if(dac_timer == NULL){
+		return;
+	}
+	memset(&dac_stats, 0, sizeof(dac_stats));
+	dac_stats.period_min = UINT32_MAX;
+	gptimer_set_raw_count(dac_timer, 0);
+	gptimer_start(dac_timer);
+}
+
+void AnalogOutputPlayStop(void){
+	if(dac_timer != NULL){
+		gptimer_stop(dac_timer);
+	}
+}
+
+bool AnalogOutputStreamStart(uint32_t update_frec, uint8_t (*source)(void*), void *param){
+	AnalogOutputStreamStop();
+	dac_source_p = source;
+	dac_source_param = param;
+	if(!dac_timer_setup(update_frec)){
+		return false;
+	}
+	AnalogOutputPlayStart();
+	return true;
+}
+
+void AnalogOutputStreamStop(void){
+	AnalogOutputPlayStop();
+}
+
+void AnalogOutputPlaySwap(const uint8_t *table, uint16_t len){
+	portENTER_CRITICAL(&dac_spinlock);
+	dac_play_next_table.table = table;
+	dac_play_next_table.len = len;
+	dac_play_swap = true;
+	dac_play_done = false;
+	portEXIT_CRITICAL(&dac_spinlock);
+}
+
+void AnalogOutputPlayGain(uint16_t gain){
+	dac_play_gain = gain;
+}
+
+bool AnalogOutputPlayDone(void){
+	return dac_play_done;
+}
+
+void AnalogOutputStats(analog_output_stats_t *stats){
+	uint32_t cycles_per_us = esp_rom_get_cpu_ticks_per_us();
+	portENTER_CRITICAL(&dac_spinlock);
+	*stats = dac_stats;
+	portEXIT_CRITICAL(&dac_spinlock);
+	if(stats->updates < 2){
+		stats->period_min = 0;
+	}
+	stats->period_min = (uint64_t)stats->period_min * 1000 / cycles_per_us;
+	stats->period_max = (uint64_t)stats->period_max * 1000 / cycles_per_us;
+}
+
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
 /** @} doxygen end group definition */
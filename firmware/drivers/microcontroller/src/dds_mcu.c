@@ -0,0 +1,222 @@
+/**
+ * @file dds_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "dds_mcu.h"
+#include "analog_io_mcu.h"
+#include "esp_attr.h"
+#include <stddef.h>
+/*==================[macros and definitions]=================================*/
+#define QUARTER_BITS		8						/*!< log2 of quarter wave table length */
+#define QUARTER_LEN			(1 << QUARTER_BITS)		/*!< Quarter wave table length */
+#define CHIRP_FRAC_BITS		16						/*!< Fractional bits of chirp tuning word */
+/**
+ * @brief Tone state
+ */
+typedef struct {
+	dds_wave_t wave;		/*!< Waveform */
+	int32_t amplitude;		/*!< Peak amplitude (DAC counts) */
+	uint32_t phase;			/*!< Phase accumulator (2^32 = 1 period) */
+	volatile uint32_t tuning;	/*!< Phase increment per update */
+	uint64_t chirp_tuning;	/*!< Chirp tuning word (32.16 fixed point) */
+	int64_t chirp_step;		/*!< Chirp tuning word increment per update (32.16 fixed point) */
+	uint32_t chirp_len;		/*!< Updates per sweep (0: no chirp) */
+	uint32_t chirp_count;	/*!< Updates in current sweep */
+	uint32_t tuning_start;	/*!< Chirp initial tuning word */
+} dds_state_t;
+/*==================[internal data declaration]==============================*/
+static dds_state_t dds_tones[DDS_TONES_QTY];	/*!< Tones */
+static uint32_t dds_update_frec;				/*!< DAC update frequency (Hz) */
+static uint8_t dds_offset = 128;				/*!< Output value for 0 */
+/*==================[internal functions declaration]=========================*/
+static uint32_t dds_tuning_word(uint32_t frec);
+static int32_t dds_wave(dds_wave_t wave, uint32_t phase);
+/*==================[internal data definition]===============================*/
+/** Sine from 0 to pi/2 (Q15), the other quadrants are obtained by symmetry */
+static const int16_t sin_quarter[QUARTER_LEN + 1] = {
+	    0,   201,   402,   603,   804,  1005,  1206,  1407,
+	 1608,  1809,  2009,  2210,  2410,  2611,  2811,  3012,
+	 3212,  3412,  3612,  3811,  4011,  4210,  4410,  4609,
+	 4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,
+	 6393,  6590,  6786,  6983,  7179,  7375,  7571,  7767,
+	 7962,  8157,  8351,  8545,  8739,  8933,  9126,  9319,
+	 9512,  9704,  9896, 10087, 10278, 10469, 10659, 10849,
+	11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+	12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828,
+	14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+	15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673,
+	16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+	18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357,
+	19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+	20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856,
+	22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+	23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143,
+	24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+	25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198,
+	26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+	27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001,
+	28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+	28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534,
+	29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+	30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783,
+	30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+	31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736,
+	31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+	32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382,
+	32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+	32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717,
+	32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+	32767,
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Convert frequency to phase increment per DAC update
+ * 
+ * @param frec Frequency (mHz)
+ * @return uint32_t Tuning word
+ */
+static uint32_t dds_tuning_word(uint32_t frec){
+	return ((uint64_t)frec << 32) / ((uint64_t)dds_update_frec * 1000);
+}
+
+/**
+ * @brief Evaluate a waveform
+ * 
+ * @param wave Waveform
+ * @param phase Phase (2^32 = 1 period)
+ * @return int32_t Value (Q15)
+ */
+static int32_t IRAM_ATTR dds_wave(dds_wave_t wave, uint32_t phase){
+	uint32_t idx;
+	int32_t value = 0;
+	switch(wave){
+		case DDS_SINE:
+			/* 2 MSB select the quadrant, next QUARTER_BITS index the table */
+			idx = (phase >> (30 - QUARTER_BITS)) & (QUARTER_LEN - 1);
+			if(phase & 0x40000000){
+				idx = QUARTER_LEN - idx;
+			}
+			value = sin_quarter[idx];
+			if(phase & 0x80000000){
+				value = -value;
+			}
+			break;
+		case DDS_SQUARE:
+			value = (phase & 0x80000000) ? -INT16_MAX : INT16_MAX;
+			break;
+		case DDS_TRIANGLE:
+			/* Rises from -1 to 1 in the first half, falls in the second */
+			value = (phase & 0x80000000) ? ~phase : phase;
+			value = (int32_t)((uint32_t)value >> 15) - (1 << 15);
+			if(value > INT16_MAX){
+				value = INT16_MAX;
+			}
+			break;
+		case DDS_SAWTOOTH:
+			value = (int32_t)(phase >> 16) - (1 << 15);
+			break;
+		case DDS_OFF:
+			break;
+	}
+	return value;
+}
+
+/*==================[external functions definition]==========================*/
+void DdsInit(uint32_t update_frec, uint8_t offset){
+	dds_update_frec = update_frec;
+	dds_offset = offset;
+	for(uint8_t i = 0; i < DDS_TONES_QTY; i++){
+		dds_tones[i].wave = DDS_OFF;
+	}
+}
+
+void DdsSetTone(uint8_t tone, dds_tone_t *config){
+	dds_state_t *t;
+	if(tone >= DDS_TONES_QTY){
+		return;
+	}
+	t = &dds_tones[tone];
+	t->wave = DDS_OFF;
+	t->phase = 0;
+	t->amplitude = config->amplitude;
+	t->tuning = dds_tuning_word(config->frec);
+	t->chirp_len = 0;
+	if(config->frec_end != 0 && config->sweep_ms != 0){
+		t->tuning_start = t->tuning;
+		t->chirp_tuning = (uint64_t)t->tuning << CHIRP_FRAC_BITS;
+		t->chirp_len = (uint64_t)config->sweep_ms * dds_update_frec / 1000;
+		if(t->chirp_len == 0){
+			t->chirp_len = 1;
+		}
+		t->chirp_step = (((int64_t)dds_tuning_word(config->frec_end) - t->tuning) << CHIRP_FRAC_BITS) / t->chirp_len;
+		t->chirp_count = 0;
+	}
+	t->wave = config->wave;
+}
+
+void DdsSetFrequency(uint8_t tone, uint32_t frec){
+	if(tone >= DDS_TONES_QTY){
+		return;
+	}
+	dds_tones[tone].chirp_len = 0;
+	/* Only the increment changes, the accumulator keeps its phase */
+	dds_tones[tone].tuning = dds_tuning_word(frec);
+}
+
+void DdsSetAmplitude(uint8_t tone, uint8_t amplitude){
+	if(tone >= DDS_TONES_QTY){
+		return;
+	}
+	dds_tones[tone].amplitude = amplitude;
+}
+
+bool DdsStart(void){
+	return AnalogOutputStreamStart(dds_update_frec, DdsNextSample, NULL);
+}
+
+void DdsStop(void){
+	AnalogOutputStreamStop();
+}
+
+uint8_t IRAM_ATTR DdsNextSample(void *param){
+	int32_t out = 0;
+	for(uint8_t i = 0; i < DDS_TONES_QTY; i++){
+		dds_state_t *t = &dds_tones[i];
+		if(t->wave == DDS_OFF){
+			continue;
+		}
+		out += (dds_wave(t->wave, t->phase) * t->amplitude) >> 15;
+		t->phase += t->tuning;
+		if(t->chirp_len != 0){
+			if(++t->chirp_count >= t->chirp_len){
+				t->chirp_count = 0;
+				t->chirp_tuning = (uint64_t)t->tuning_start << CHIRP_FRAC_BITS;
+			} else{
+				t->chirp_tuning += t->chirp_step;
+			}
+			t->tuning = t->chirp_tuning >> CHIRP_FRAC_BITS;
+		}
+	}
+	out += dds_offset;
+	if(out < 0){
+		out = 0;
+	} else if(out > UINT8_MAX){
+		out = UINT8_MAX;
+	}
+	return out;
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
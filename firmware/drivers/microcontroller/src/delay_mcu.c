@@ -11,103 +11,104 @@
 
 /*==================[inclusions]=============================================*/
 #include "delay_mcu.h"
-#include "driver/gptimer.h"
+#include "soft_timer_mcu.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "esp_rom_sys.h"
+#include "esp_timer.h"
 /*==================[macros and definitions]=================================*/
-#define US_RESOLUTION_HZ	1000000	/*!< 1usec */
 #define MSEC				1000	/*!< 1msec = 1000usec */
 #define SEC					1000000	/*!< 1sec = 1000msec */
-#define MIN_US				50	    /*!< minimun delay in usec to use gptimer */
+#define MIN_US				50	    /*!< minimun delay in usec to use a timer */
+#define MAX_SEC				1000	/*!< longest single timer wait in sec (fits in 32 bits of usec) */
 /*==================[internal data declaration]==============================*/
-TaskHandle_t task_to_notify;
+
 /*==================[internal functions declaration]=========================*/
-static bool IRAM_ATTR delay_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-	gptimer_stop(timer);
-	vTaskNotifyGiveFromISR(task_to_notify, &xHigherPriorityTaskWoken);
-	return (xHigherPriorityTaskWoken == pdTRUE);
-}
+static void delay_wait(uint32_t usec);
+static void delay_ticks(uint32_t usec);
+static bool delay_isr(void *param);
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Soft timer callback: wake the waiting task
+ * 
+ * @param param Semaphore of the waiting task
+ * @return true if the waiting task has a higher priority than the interrupted one
+ */
+static bool IRAM_ATTR delay_isr(void *param){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	xSemaphoreGiveFromISR((SemaphoreHandle_t)param, &xHigherPriorityTaskWoken);
+	return (xHigherPriorityTaskWoken == pdTRUE);
+}
+
+/**
+ * @brief Wait usec microseconds without a soft timer: whole RTOS ticks blocked, 
+ * the rest busy waiting
+ * 
+ * vTaskDelay(n) blocks for n - 1 to n tick periods, so one tick less is 
+ * requested and the remainder is measured.
+ * 
+ * @param usec Delay (us)
+ */
+static void delay_ticks(uint32_t usec){
+	int64_t end = esp_timer_get_time() + usec;
+	TickType_t ticks = usec / (portTICK_PERIOD_MS * MSEC);
+	if(ticks > 1){
+		vTaskDelay(ticks - 1);
+	}
+	int64_t left = end - esp_timer_get_time();
+	if(left > 0){
+		esp_rom_delay_us(left);
+	}
+}
+
+/**
+ * @brief Block the calling task for usec microseconds
+ * 
+ * The timer and the semaphore live on the caller's stack, so nothing is 
+ * allocated and several tasks can wait at the same time.
+ * 
+ * @param usec Delay (us)
+ */
+static void delay_wait(uint32_t usec){
+	soft_timer_t timer = {0};
+	StaticSemaphore_t sem_buffer;
+	if(!SoftTimerInit()){
+		/* No gptimer free */
+		delay_ticks(usec);
+		return;
+	}
+	SemaphoreHandle_t sem = xSemaphoreCreateBinaryStatic(&sem_buffer);
+	if(SoftTimerStart(&timer, usec, 0, delay_isr, sem)){
+		xSemaphoreTake(sem, portMAX_DELAY);
+	}else{
+		/* No free soft timer */
+		delay_ticks(usec);
+	}
+	vSemaphoreDelete(sem);
+}
 
 /*==================[external functions definition]==========================*/
 void DelaySec(uint16_t sec){
-	task_to_notify = xTaskGetCurrentTaskHandle();
-	gptimer_handle_t delay_timer = NULL;
-    gptimer_config_t delay_timer_config = {
-        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
-        .direction = GPTIMER_COUNT_UP,
-        .resolution_hz = US_RESOLUTION_HZ,
-    };
-    gptimer_new_timer(&delay_timer_config, &delay_timer);
-    gptimer_event_callbacks_t delay_alarm = {
-        .on_alarm = delay_isr,
-    };
-	gptimer_register_event_callbacks(delay_timer, &delay_alarm, NULL);
-	gptimer_enable(delay_timer);
-    gptimer_alarm_config_t alarm_config = {
-        .alarm_count = sec*SEC, 
-    };
-	gptimer_set_alarm_action(delay_timer, &alarm_config);
-	gptimer_start(delay_timer);
-	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-	gptimer_disable(delay_timer);
-	gptimer_del_timer(delay_timer);
+	while(sec > MAX_SEC){
+		delay_wait(MAX_SEC * SEC);
+		sec -= MAX_SEC;
+	}
+	delay_wait(sec * SEC);
 }
 
 void DelayMs(uint16_t msec){
-	task_to_notify = xTaskGetCurrentTaskHandle();
-	gptimer_handle_t delay_timer = NULL;
-    gptimer_config_t delay_timer_config = {
-        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
-        .direction = GPTIMER_COUNT_UP,
-        .resolution_hz = US_RESOLUTION_HZ,
-    };
-    gptimer_new_timer(&delay_timer_config, &delay_timer);
-    gptimer_event_callbacks_t delay_alarm = {
-        .on_alarm = delay_isr,
-    };
-	gptimer_register_event_callbacks(delay_timer, &delay_alarm, NULL);
-	gptimer_enable(delay_timer);
-    gptimer_alarm_config_t alarm_config = {
-        .alarm_count = msec*MSEC, 
-    };
-	gptimer_set_alarm_action(delay_timer, &alarm_config);
-	gptimer_start(delay_timer);
-	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-	gptimer_disable(delay_timer);
-	gptimer_del_timer(delay_timer);
+	delay_wait(msec * MSEC);
 }
 
 void DelayUs(uint16_t usec){
     if(usec<=MIN_US){
         esp_rom_delay_us(usec);
     }else{
-        task_to_notify = xTaskGetCurrentTaskHandle();
-        gptimer_handle_t delay_timer = NULL;
-        gptimer_config_t delay_timer_config = {
-            .clk_src = GPTIMER_CLK_SRC_DEFAULT,
-            .direction = GPTIMER_COUNT_UP,
-            .resolution_hz = US_RESOLUTION_HZ,
-        };
-        gptimer_new_timer(&delay_timer_config, &delay_timer);
-        gptimer_event_callbacks_t delay_alarm = {
-            .on_alarm = delay_isr,
-        };
-        gptimer_register_event_callbacks(delay_timer, &delay_alarm, NULL);
-        gptimer_enable(delay_timer);
-        gptimer_alarm_config_t alarm_config = {
-            .alarm_count = usec, 
-        };
-        gptimer_set_alarm_action(delay_timer, &alarm_config);
-        gptimer_start(delay_timer);
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        gptimer_disable(delay_timer);
-        gptimer_del_timer(delay_timer);
+        delay_wait(usec);
     }
 }
@@ -0,0 +1,336 @@
+/**
+ * @file etm_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "etm_mcu.h"
+#include "esp_etm.h"
+#include "driver/gpio_etm.h"
+#include "driver/gptimer.h"
+#include "driver/gptimer_etm.h"
+#include <stddef.h>
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define US_RESOLUTION_HZ	1000000	/*!< 1usec */
+#define PULSE_CHANNELS		6		/*!< ETM channels used by the pulse generator */
+/**
+ * @brief Pulse generator resources (NULL: not allocated)
+ */
+typedef struct {
+	gptimer_handle_t period_timer;				/*!< Free running, alarm every period */
+	gptimer_handle_t width_timer;				/*!< Started by the period alarm, alarm after width */
+	esp_etm_event_handle_t period_alarm;
+	esp_etm_event_handle_t width_alarm;
+	esp_etm_task_handle_t pin_toggle;			/*!< The only GPIO task of the pin */
+	esp_etm_task_handle_t period_rearm;			/*!< Period timer alarm enable */
+	esp_etm_task_handle_t width_start;
+	esp_etm_task_handle_t width_stop;
+	esp_etm_task_handle_t width_rearm;			/*!< Width timer alarm enable */
+	esp_etm_channel_handle_t channels[PULSE_CHANNELS];
+	gpio_t pin;
+	uint32_t period;
+} etm_pulse_t;
+/*==================[internal data declaration]==============================*/
+static etm_pulse_t etm_pulse;
+/*==================[internal functions declaration]=========================*/
+static esp_err_t etm_connect(esp_etm_event_handle_t event, esp_etm_task_handle_t task, esp_etm_channel_handle_t *ret_channel);
+static esp_err_t etm_gptimer_event(gptimer_handle_t timer, esp_etm_event_handle_t *ret_event);
+static esp_err_t etm_gptimer_task(gptimer_handle_t timer, gptimer_etm_task_type_t type, esp_etm_task_handle_t *ret_task);
+static esp_err_t etm_gpio_task(gpio_t pin, etm_gpio_action_t action, esp_etm_task_handle_t *ret_task);
+static esp_err_t etm_pulse_timer(uint32_t alarm, gptimer_handle_t *ret_timer);
+static void etm_pulse_release(void);
+/*==================[internal data definition]===============================*/
+static const gpio_etm_task_action_t etm_gpio_actions[] = {
+	[ETM_GPIO_SET] = GPIO_ETM_TASK_ACTION_SET,
+	[ETM_GPIO_CLEAR] = GPIO_ETM_TASK_ACTION_CLR,
+	[ETM_GPIO_TOGGLE] = GPIO_ETM_TASK_ACTION_TOG,
+};
+static const gptimer_etm_task_type_t etm_timer_actions[] = {
+	[ETM_TIMER_START] = GPTIMER_ETM_TASK_START_COUNT,
+	[ETM_TIMER_STOP] = GPTIMER_ETM_TASK_STOP_COUNT,
+	[ETM_TIMER_RELOAD] = GPTIMER_ETM_TASK_RELOAD,
+	[ETM_TIMER_CAPTURE] = GPTIMER_ETM_TASK_CAPTURE,
+};
+static const gpio_etm_event_edge_t etm_edges[] = {
+	[ETM_EDGE_RISING] = GPIO_ETM_EVENT_EDGE_POS,
+	[ETM_EDGE_FALLING] = GPIO_ETM_EVENT_EDGE_NEG,
+	[ETM_EDGE_ANY] = GPIO_ETM_EVENT_EDGE_ANY,
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Create and enable a channel from event to task
+ *
+ * @param ret_channel Channel created (NULL if not needed by the caller)
+ */
+static esp_err_t etm_connect(esp_etm_event_handle_t event, esp_etm_task_handle_t task, esp_etm_channel_handle_t *ret_channel){
+	esp_etm_channel_config_t channel_config = {0};
+	esp_etm_channel_handle_t channel = NULL;
+	esp_err_t err = esp_etm_new_channel(&channel_config, &channel);
+	if(err != ESP_OK){
+		return err;
+	}
+	err = esp_etm_channel_connect(channel, event, task);
+	if(err == ESP_OK){
+		err = esp_etm_channel_enable(channel);
+	}
+	if(err != ESP_OK){
+		esp_etm_del_channel(channel);
+		return err;
+	}
+	if(ret_channel != NULL){
+		*ret_channel = channel;
+	}
+	return ESP_OK;
+}
+
+/**
+ * @brief Alarm event of a gptimer
+ */
+static esp_err_t etm_gptimer_event(gptimer_handle_t timer, esp_etm_event_handle_t *ret_event){
+	gptimer_etm_event_config_t event_config = {
+		.event_type = GPTIMER_ETM_EVENT_ALARM_MATCH,
+	};
+	if(timer == NULL){
+		return ESP_ERR_INVALID_STATE;
+	}
+	return gptimer_new_etm_event(timer, &event_config, ret_event);
+}
+
+/**
+ * @brief Task of a gptimer
+ */
+static esp_err_t etm_gptimer_task(gptimer_handle_t timer, gptimer_etm_task_type_t type, esp_etm_task_handle_t *ret_task){
+	gptimer_etm_task_config_t task_config = {
+		.task_type = type,
+	};
+	if(timer == NULL){
+		return ESP_ERR_INVALID_STATE;
+	}
+	return gptimer_new_etm_task(timer, &task_config, ret_task);
+}
+
+/**
+ * @brief Task of a GPIO. A GPIO can be bound to a single ETM task, so binding
+ * a pin that already has one fails.
+ */
+static esp_err_t etm_gpio_task(gpio_t pin, etm_gpio_action_t action, esp_etm_task_handle_t *ret_task){
+	gpio_etm_task_config_t task_config = {
+		.action = etm_gpio_actions[action],
+	};
+	esp_etm_task_handle_t task = NULL;
+	esp_err_t err = gpio_new_etm_task(&task_config, &task);
+	if(err != ESP_OK){
+		return err;
+	}
+	/* gpio_t values are the GPIO numbers */
+	err = gpio_etm_task_add_gpio(task, pin);
+	if(err != ESP_OK){
+		esp_etm_del_task(task);
+		return err;
+	}
+	*ret_task = task;
+	return ESP_OK;
+}
+
+/**
+ * @brief New 1MHz gptimer with an auto reload (to 0) alarm and no ISR. The
+ * alarm is re-enabled by an ETM task, not by software.
+ */
+static esp_err_t etm_pulse_timer(uint32_t alarm, gptimer_handle_t *ret_timer){
+	gptimer_config_t timer_config = {
+		.clk_src = GPTIMER_CLK_SRC_DEFAULT,
+		.direction = GPTIMER_COUNT_UP,
+		.resolution_hz = US_RESOLUTION_HZ,
+	};
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = alarm,
+		.reload_count = 0,
+		.flags.auto_reload_on_alarm = true,
+	};
+	esp_err_t err = gptimer_new_timer(&timer_config, ret_timer);
+	if(err != ESP_OK){
+		return err;
+	}
+	err = gptimer_set_alarm_action(*ret_timer, &alarm_config);
+	if(err == ESP_OK){
+		err = gptimer_enable(*ret_timer);
+	}
+	return err;
+}
+
+/**
+ * @brief Free every allocated pulse generator resource
+ */
+static void etm_pulse_release(void){
+	etm_pulse_t *p = &etm_pulse;
+	for(uint8_t i = 0; i < PULSE_CHANNELS; i++){
+		if(p->channels[i] != NULL){
+			esp_etm_channel_disable(p->channels[i]);
+			esp_etm_del_channel(p->channels[i]);
+		}
+	}
+	if(p->pin_toggle != NULL){
+		gpio_etm_task_rm_gpio(p->pin_toggle, p->pin);
+		GPIOOff(p->pin);
+	}
+	esp_etm_task_handle_t tasks[] = {p->pin_toggle, p->period_rearm, p->width_start, p->width_stop, p->width_rearm};
+	for(uint8_t i = 0; i < sizeof(tasks) / sizeof(tasks[0]); i++){
+		if(tasks[i] != NULL){
+			esp_etm_del_task(tasks[i]);
+		}
+	}
+	if(p->period_alarm != NULL){
+		esp_etm_del_event(p->period_alarm);
+	}
+	if(p->width_alarm != NULL){
+		esp_etm_del_event(p->width_alarm);
+	}
+	gptimer_handle_t timers[] = {p->period_timer, p->width_timer};
+	for(uint8_t i = 0; i < 2; i++){
+		if(timers[i] != NULL){
+			/* Fails harmlessly if the timer is not running */
+			gptimer_stop(timers[i]);
+			gptimer_disable(timers[i]);
+			gptimer_del_timer(timers[i]);
+		}
+	}
+	memset(p, 0, sizeof(etm_pulse_t));
+}
+
+/*==================[external functions definition]==========================*/
+esp_err_t EtmTimerToGpio(timer_mcu_t timer, gpio_t pin, etm_gpio_action_t action){
+	esp_etm_event_handle_t event = NULL;
+	esp_etm_task_handle_t task = NULL;
+	esp_err_t err = etm_gptimer_event((gptimer_handle_t)TimerGetHandle(timer), &event);
+	if(err != ESP_OK){
+		return err;
+	}
+	err = etm_gpio_task(pin, action, &task);
+	if(err != ESP_OK){
+		esp_etm_del_event(event);
+		return err;
+	}
+	err = etm_connect(event, task, NULL);
+	if(err != ESP_OK){
+		gpio_etm_task_rm_gpio(task, pin);
+		esp_etm_del_task(task);
+		esp_etm_del_event(event);
+	}
+	return err;
+}
+
+esp_err_t EtmGpioToTimer(gpio_t pin, etm_edge_t edge, timer_mcu_t timer, etm_timer_action_t action){
+	gpio_etm_event_config_t event_config = {
+		.edge = etm_edges[edge],
+	};
+	esp_etm_event_handle_t event = NULL;
+	esp_etm_task_handle_t task = NULL;
+	esp_err_t err = gpio_new_etm_event(&event_config, &event);
+	if(err != ESP_OK){
+		return err;
+	}
+	err = gpio_etm_event_bind_gpio(event, pin);
+	if(err == ESP_OK){
+		err = etm_gptimer_task((gptimer_handle_t)TimerGetHandle(timer), etm_timer_actions[action], &task);
+	}
+	if(err == ESP_OK){
+		err = etm_connect(event, task, NULL);
+		if(err != ESP_OK){
+			esp_etm_del_task(task);
+		}
+	}
+	if(err != ESP_OK){
+		esp_etm_del_event(event);
+	}
+	return err;
+}
+
+esp_err_t EtmPulseInit(gpio_t pin, uint32_t period, uint32_t width){
+	etm_pulse_t *p = &etm_pulse;
+	esp_err_t err;
+	if(width == 0 || width >= period){
+		return ESP_ERR_INVALID_ARG;
+	}
+	if(p->period_timer != NULL){
+		return ESP_ERR_INVALID_STATE;
+	}
+	p->pin = pin;
+	p->period = period;
+	GPIOInit(pin, GPIO_OUTPUT);
+	GPIOOff(pin);
+	/* Allocation stops at the first error (ESP_OK chains through) */
+	err = etm_pulse_timer(period, &p->period_timer);
+	if(err == ESP_OK) err = etm_pulse_timer(width, &p->width_timer);
+	if(err == ESP_OK) err = etm_gptimer_event(p->period_timer, &p->period_alarm);
+	if(err == ESP_OK) err = etm_gptimer_event(p->width_timer, &p->width_alarm);
+	if(err == ESP_OK) err = etm_gpio_task(pin, ETM_GPIO_TOGGLE, &p->pin_toggle);
+	if(err == ESP_OK) err = etm_gptimer_task(p->period_timer, GPTIMER_ETM_TASK_EN_ALARM, &p->period_rearm);
+	if(err == ESP_OK) err = etm_gptimer_task(p->width_timer, GPTIMER_ETM_TASK_START_COUNT, &p->width_start);
+	if(err == ESP_OK) err = etm_gptimer_task(p->width_timer, GPTIMER_ETM_TASK_STOP_COUNT, &p->width_stop);
+	if(err == ESP_OK) err = etm_gptimer_task(p->width_timer, GPTIMER_ETM_TASK_EN_ALARM, &p->width_rearm);
+	/* Period alarm (count reloads to 0): pin rises, the width timer starts
+	 * counting from 0 and the period alarm is re-enabled */
+	if(err == ESP_OK) err = etm_connect(p->period_alarm, p->pin_toggle, &p->channels[0]);
+	if(err == ESP_OK) err = etm_connect(p->period_alarm, p->width_start, &p->channels[1]);
+	if(err == ESP_OK) err = etm_connect(p->period_alarm, p->period_rearm, &p->channels[2]);
+	/* Width alarm (count reloads to 0): pin falls, the width timer stops at 0
+	 * and its alarm is re-enabled for the next pulse */
+	if(err == ESP_OK) err = etm_connect(p->width_alarm, p->pin_toggle, &p->channels[3]);
+	if(err == ESP_OK) err = etm_connect(p->width_alarm, p->width_stop, &p->channels[4]);
+	if(err == ESP_OK) err = etm_connect(p->width_alarm, p->width_rearm, &p->channels[5]);
+	if(err != ESP_OK){
+		etm_pulse_release();
+	}
+	return err;
+}
+
+esp_err_t EtmPulseStart(void){
+	etm_pulse_t *p = &etm_pulse;
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = p->period,
+		.reload_count = 0,
+		.flags.auto_reload_on_alarm = true,
+	};
+	if(p->period_timer == NULL){
+		return ESP_ERR_INVALID_STATE;
+	}
+	esp_err_t err = gptimer_set_raw_count(p->period_timer, 0);
+	if(err == ESP_OK){
+		/* Re-enables the alarm in case it was stopped right after firing */
+		err = gptimer_set_alarm_action(p->period_timer, &alarm_config);
+	}
+	if(err == ESP_OK){
+		err = gptimer_start(p->period_timer);
+	}
+	return err;
+}
+
+esp_err_t EtmPulseStop(void){
+	if(etm_pulse.period_timer == NULL){
+		return ESP_ERR_INVALID_STATE;
+	}
+	/* A pulse in progress still ends: the width timer stops itself */
+	return gptimer_stop(etm_pulse.period_timer);
+}
+
+esp_err_t EtmPulseDeinit(void){
+	if(etm_pulse.period_timer == NULL){
+		return ESP_ERR_INVALID_STATE;
+	}
+	etm_pulse_release();
+	return ESP_OK;
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
@@ -14,6 +14,8 @@
 #include <stdint.h>
 #include "driver/gpio.h"
 #include "driver/gpio_filter.h"
+#include "isr_notify_mcu.h"
+#include "metrics_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define GPIO_QTY 	24
 #define FILTER_QTY	8
@@ -24,8 +26,11 @@ typedef struct{
 	bool state;					/*!< GPIO output state */
 } digital_io_t;
 /*==================[internal data declaration]==============================*/
-
+static void (*gpio_isr_p[GPIO_QTY])(void*);		/*!< Interrupt handlers */
+static void *gpio_isr_args[GPIO_QTY];			/*!< Interrupt handlers parameters */
 /*==================[internal functions declaration]=========================*/
+static void gpio_isr(void *args);
+static void gpio_notify_isr(void *args);
 
 /*==================[internal data definition]===============================*/
 digital_io_t gpio_list[GPIO_QTY] = {
@@ -63,6 +68,28 @@ gpio_flex_glitch_filter_config_t filter_config = {
 
 /*==================[internal functions definition]==========================*/
 
+/**
+ * @brief GPIO interrupt handler: counts the interrupt and calls the user handler
+ * 
+ * @param args Pin (cast to void*)
+ */
+static void IRAM_ATTR gpio_isr(void *args){
+	gpio_t pin = (gpio_t)(uintptr_t)args;
+	MetricsAdd(METRICS_GPIO_INTERRUPTS, 1);
+	gpio_isr_p[pin](gpio_isr_args[pin]);
+}
+
+/**
+ * @brief GPIO interrupt handler for task bindings
+ * 
+ * @param args Binding
+ */
+static void IRAM_ATTR gpio_notify_isr(void *args){
+	if(IsrNotifyFromISR((isr_notify_t *)args)){
+		portYIELD_FROM_ISR();
+	}
+}
+
 /*==================[external functions definition]==========================*/
 void GPIOInit(gpio_t pin, io_t io){
 	if((pin == GPIO_14) || (pin > GPIO_23)){
@@ -113,7 +140,13 @@ void GPIOActivInt(gpio_t pin, void *ptr_int_func, bool edge, void *args){
 		gpio_install_isr_service(0);
 		isr_service_installed = true;
 	}
-    gpio_isr_handler_add(gpio_list[pin].pin, ptr_int_func, (void *)args);	
+	gpio_isr_p[pin] = ptr_int_func;
+	gpio_isr_args[pin] = args;
+    gpio_isr_handler_add(gpio_list[pin].pin, gpio_isr, (void *)(uintptr_t)pin);	
+}
+
+void GPIONotifyTask(gpio_t pin, bool edge, isr_notify_t *notify){
+	GPIOActivInt(pin, gpio_notify_isr, edge, notify);
 }
 
 void GPIOInputFilter(gpio_t pin){
@@ -17,6 +17,8 @@
 //#include "sdkconfig.h"
 
 #include "i2c_mcu.h"
+#include "trace_mcu.h"
+#include "metrics_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define I2C_NUM I2C_NUM_0
 
@@ -26,6 +28,22 @@
 /*==================[internal data definition]===============================*/
 
 /*==================[internal functions declaration]=========================*/
+static esp_err_t i2c_transfer(i2c_cmd_handle_t cmd);
+
+/**
+ * @brief Execute a command link, counting it in the metrics registry
+ * 
+ * @param cmd Command link
+ * @return esp_err_t ESP_OK, ESP_FAIL (NACK) or ESP_ERR_TIMEOUT
+ */
+static esp_err_t i2c_transfer(i2c_cmd_handle_t cmd){
+	esp_err_t rc = i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS);
+	MetricsAdd(METRICS_I2C_TRANSACTIONS, 1);
+	if(rc != ESP_OK){
+		MetricsAdd(METRICS_I2C_ERRORS, 1);
+	}
+	return rc;
+}
 
 /*==================[external functions definition]==========================*/
 
@@ -125,6 +143,7 @@ int8_t I2C_readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t ti
  */
 int8_t I2C_readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout) {
 	i2c_cmd_handle_t cmd;
+	TraceBegin(TRACE_I2C_READ);
 	I2C_SelectRegister(devAddr, regAddr);
 
 	cmd = i2c_cmd_link_create();
@@ -137,9 +156,10 @@ int8_t I2C_readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *
 	ESP_ERROR_CHECK(i2c_master_read_byte(cmd, data+length-1, I2C_MASTER_NACK));
 
 	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS));
+	ESP_ERROR_CHECK(i2c_transfer(cmd));
 	i2c_cmd_link_delete(cmd);
 
+	TraceEnd(TRACE_I2C_READ);
 	return length;
 }
 
@@ -158,7 +178,7 @@ void I2C_SelectRegister(uint8_t devAddr, uint8_t reg){
 	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, (devAddr << 1) | I2C_MASTER_WRITE, 1));
 	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, reg, 1));
 	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS));
+	ESP_ERROR_CHECK(i2c_transfer(cmd));
 	i2c_cmd_link_delete(cmd);
 }
 
@@ -220,7 +240,7 @@ bool I2C_writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data) {
 	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, regAddr, 1));
 	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, data, 1));
 	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS));
+	ESP_ERROR_CHECK(i2c_transfer(cmd));
 	i2c_cmd_link_delete(cmd);
 
 	return true;
@@ -243,7 +263,7 @@ bool I2C_writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *d
 	ESP_ERROR_CHECK(i2c_master_write(cmd, data, length-1, 0));
 	ESP_ERROR_CHECK(i2c_master_write_byte(cmd, data[length-1], 1));
 	ESP_ERROR_CHECK(i2c_master_stop(cmd));
-	i2c_master_cmd_begin(I2C_NUM, cmd, 1000/portTICK_PERIOD_MS);
+	i2c_transfer(cmd);
 	i2c_cmd_link_delete(cmd);
 	return true;
 }
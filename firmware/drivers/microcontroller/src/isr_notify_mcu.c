@@ -0,0 +1,70 @@
+/**
+ * @file isr_notify_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "isr_notify_mcu.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+void IsrNotifyInit(isr_notify_t *notify, TaskHandle_t task){
+	memset(notify, 0, sizeof(isr_notify_t));
+	notify->task = task;
+}
+
+bool IRAM_ATTR IsrNotifyFromISR(isr_notify_t *notify){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	if(notify->task == NULL){
+		return false;
+	}
+	notify->isr_cycles = esp_cpu_get_cycle_count();
+	notify->notifications++;
+	vTaskNotifyGiveFromISR(notify->task, &xHigherPriorityTaskWoken);
+	return (xHigherPriorityTaskWoken == pdTRUE);
+}
+
+uint32_t IsrNotifyTake(isr_notify_t *notify, TickType_t ticks){
+	uint32_t pending = ulTaskNotifyTake(pdTRUE, ticks);
+	if(pending != 0){
+		uint32_t latency = esp_cpu_get_cycle_count() - notify->isr_cycles;
+		notify->last_cycles = latency;
+		if(latency > notify->max_cycles){
+			notify->max_cycles = latency;
+		}
+		notify->takes++;
+	}
+	return pending;
+}
+
+void IsrNotifyGetStats(isr_notify_t *notify, isr_notify_stats_t *stats){
+	uint32_t mhz = esp_rom_get_cpu_ticks_per_us();
+	stats->notifications = notify->notifications;
+	stats->takes = notify->takes;
+	stats->last_latency_ns = (uint64_t)notify->last_cycles * 1000 / mhz;
+	stats->max_latency_ns = (uint64_t)notify->max_cycles * 1000 / mhz;
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
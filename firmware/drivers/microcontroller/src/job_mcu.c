@@ -0,0 +1,193 @@
+/**
+ * @file job_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "job_mcu.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+static job_t *job_list[JOB_MAX];	/*!< Created jobs */
+static uint8_t job_count;			/*!< Number of jobs */
+static portMUX_TYPE job_lock = portMUX_INITIALIZER_UNLOCKED;	/*!< Protects the CPU time accounting */
+/*==================[internal functions declaration]=========================*/
+static bool job_release(void *param);
+static uint32_t job_cpu(job_t *job);
+static void job_task(void *param);
+static uint16_t job_load(job_t *job, uint64_t now);
+static void job_start_at(job_t *job, uint64_t base);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Release timer callback: wake the job task, or count an overrun
+ * 
+ * @param param Job
+ * @return true if the job task has a higher priority than the interrupted one
+ */
+static bool IRAM_ATTR job_release(void *param){
+	job_t *job = (job_t *)param;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	job->stats.releases++;
+	if(job->busy){
+		job->stats.overruns++;
+		return false;
+	}
+	job->release = SoftTimerNow();
+	job->busy = true;
+	vTaskNotifyGiveFromISR(job->task, &xHigherPriorityTaskWoken);
+	return (xHigherPriorityTaskWoken == pdTRUE);
+}
+
+/**
+ * @brief CPU time used by the job task since the last accounted run (call 
+ * with the lock taken). The run-time counter of a task only advances when it 
+ * is switched out, so this is exact from another task, and from the job task 
+ * right after it wakes up (it then covers the whole previous run).
+ * 
+ * @return uint32_t CPU time (us), 0 without run-time stats
+ */
+static uint32_t job_cpu(job_t *job){
+#if (configGENERATE_RUN_TIME_STATS == 1)
+	return (configRUN_TIME_COUNTER_TYPE)(ulTaskGetRunTimeCounter(job->task) - job->run_time);
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @brief Job task: run the function once per release and measure it. The CPU 
+ * time of each run is accounted when the task wakes up for the next one.
+ * 
+ * @param param Job
+ */
+static void job_task(void *param){
+	job_t *job = (job_t *)param;
+	const job_config_t *config = job->config;
+	uint32_t deadline = (config->deadline != 0) ? config->deadline : config->period;
+	bool ran = false;
+	while(1){
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		portENTER_CRITICAL(&job_lock);
+		uint32_t exec = job_cpu(job);
+		job->run_time += exec;
+		if(ran){
+			job->stats.exec_last_us = exec;
+			if(exec > job->stats.exec_max_us){
+				job->stats.exec_max_us = exec;
+			}
+			job->exec_total += exec;
+		}
+		portEXIT_CRITICAL(&job_lock);
+		config->func_p(config->param_p);
+		uint32_t response = SoftTimerNow() - job->release;
+		job->stats.runs++;
+		if(response > job->stats.response_max_us){
+			job->stats.response_max_us = response;
+		}
+		if(response > deadline){
+			job->stats.deadline_misses++;
+		}
+		ran = true;
+		job->busy = false;
+	}
+}
+
+/**
+ * @brief CPU load of a job since its stats were reset, including the run not 
+ * accounted yet
+ * 
+ * @return uint16_t Load (per thousand)
+ */
+static uint16_t job_load(job_t *job, uint64_t now){
+	uint64_t elapsed = now - job->stats_start;
+	uint64_t cpu;
+	if(elapsed == 0){
+		return 0;
+	}
+	portENTER_CRITICAL(&job_lock);
+	cpu = job->exec_total + job_cpu(job);
+	portEXIT_CRITICAL(&job_lock);
+	return cpu * 1000 / elapsed;
+}
+
+/**
+ * @brief Start releasing a job, first release offset us after base
+ */
+static void job_start_at(job_t *job, uint64_t base){
+	uint32_t offset = (job->config->offset != 0) ? job->config->offset : job->config->period;
+	SoftTimerStartAt(&job->timer, base + offset, job->config->period, job_release, job);
+}
+
+/*==================[external functions definition]==========================*/
+bool JobCreate(job_t *job, const job_config_t *config){
+	if(job_count >= JOB_MAX || !SoftTimerInit()){
+		return false;
+	}
+	memset(job, 0, sizeof(job_t));
+	job->config = config;
+	job->stats_start = SoftTimerNow();
+	if(xTaskCreate(job_task, config->name, config->stack, job, config->priority, &job->task) != pdPASS){
+		return false;
+	}
+	job_list[job_count++] = job;
+	return true;
+}
+
+void JobStart(job_t *job){
+	job_start_at(job, SoftTimerNow());
+}
+
+void JobStartAll(void){
+	uint64_t base = SoftTimerNow();
+	for(uint8_t i = 0; i < job_count; i++){
+		job_start_at(job_list[i], base);
+	}
+}
+
+void JobStop(job_t *job){
+	SoftTimerStop(&job->timer);
+}
+
+void JobGetStats(job_t *job, job_stats_t *stats){
+	*stats = job->stats;
+	stats->load = job_load(job, SoftTimerNow());
+	stats->stack_free = uxTaskGetStackHighWaterMark(job->task) * sizeof(StackType_t);
+}
+
+void JobResetStats(void){
+	uint64_t now = SoftTimerNow();
+	for(uint8_t i = 0; i < job_count; i++){
+		portENTER_CRITICAL(&job_lock);
+		memset(&job_list[i]->stats, 0, sizeof(job_stats_t));
+		/* CPU time used so far is not counted after the reset */
+		job_list[i]->run_time += job_cpu(job_list[i]);
+		job_list[i]->exec_total = 0;
+		job_list[i]->stats_start = now;
+		portEXIT_CRITICAL(&job_lock);
+	}
+}
+
+uint16_t JobCpuLoad(void){
+	uint64_t now = SoftTimerNow();
+	uint16_t load = 0;
+	for(uint8_t i = 0; i < job_count; i++){
+		load += job_load(job_list[i], now);
+	}
+	return load;
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
@@ -0,0 +1,189 @@
+/**
+ * @file metrics_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "metrics_mcu.h"
+#include "fmt.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_rom_sys.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define METRICS_BUCKET_SHIFT	5		/*!< log2 of bucket 0 upper limit (cycles) */
+#define METRICS_NAME_MAX		24		/*!< Longest metric name */
+#define METRICS_DIGITS_MAX		10		/*!< Decimal digits of a uint32_t */
+#define METRICS_LINE_MAX		(METRICS_NAME_MAX + 8 + METRICS_HIST_BUCKETS * (2 + 2 * METRICS_DIGITS_MAX) + 2)	/*!< Dump line buffer (room for every bucket) */
+/*==================[internal data declaration]==============================*/
+static uint32_t metrics_counters[METRICS_COUNTERS_QTY];			/*!< Counters */
+static metrics_histogram_t metrics_hists[METRICS_HISTS_QTY];	/*!< Histograms */
+static portMUX_TYPE metrics_lock = portMUX_INITIALIZER_UNLOCKED;
+/*==================[internal functions declaration]=========================*/
+static uint8_t metrics_bucket(uint32_t cycles);
+static uint16_t metrics_text(char *line, const char *text);
+static uint16_t metrics_field(char *line, const char *text, uint32_t value);
+static void metrics_send_line(uart_mcu_port_t port, char *line, uint16_t len);
+/*==================[internal data definition]===============================*/
+static const char *metrics_counter_names[METRICS_COUNTERS_QTY] = {
+	[METRICS_SPI_TRANSACTIONS] = "spi_transactions",
+	[METRICS_SPI_BYTES] = "spi_bytes",
+	[METRICS_I2C_TRANSACTIONS] = "i2c_transactions",
+	[METRICS_I2C_ERRORS] = "i2c_errors",
+	[METRICS_ADC_FRAMES] = "adc_frames",
+	[METRICS_ADC_OVERRUNS] = "adc_overruns",
+	[METRICS_UART_RX_OVERFLOWS] = "uart_rx_overflows",
+	[METRICS_UART_TX_DROPS] = "uart_tx_drops",
+	[METRICS_GPIO_INTERRUPTS] = "gpio_interrupts",
+};
+static const char *metrics_hist_names[METRICS_HISTS_QTY] = {
+	[METRICS_TIMER_CALLBACK] = "timer_callback",
+	[METRICS_SOFT_TIMER_CALLBACK] = "soft_timer_callback",
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Bucket of a duration
+ */
+static uint8_t IRAM_ATTR metrics_bucket(uint32_t cycles){
+	uint32_t limit = cycles >> METRICS_BUCKET_SHIFT;
+	uint8_t bucket = 0;
+	while(limit != 0 && bucket < METRICS_HIST_BUCKETS - 1){
+		limit >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+/**
+ * @brief Copy a name into a dump line
+ *
+ * @return uint16_t Characters written (at most METRICS_NAME_MAX)
+ */
+static uint16_t metrics_text(char *line, const char *text){
+	uint16_t len = 0;
+	while(text[len] != '\0' && len < METRICS_NAME_MAX){
+		line[len] = text[len];
+		len++;
+	}
+	return len;
+}
+
+/**
+ * @brief Write " <text> <value>" into a dump line
+ *
+ * @return uint16_t Characters written
+ */
+static uint16_t metrics_field(char *line, const char *text, uint32_t value){
+	uint16_t len = 0;
+	line[len++] = ' ';
+	len += metrics_text(&line[len], text);
+	line[len++] = ' ';
+	return len + FmtUint(&line[len], value, 10, 0, ' ');
+}
+
+/**
+ * @brief Send a complete dump line, adding the end of line, in a single write
+ */
+static void metrics_send_line(uart_mcu_port_t port, char *line, uint16_t len){
+	line[len++] = '\n';
+	line[len] = '\0';
+	UartSendString(port, line);
+}
+
+/*==================[external functions definition]==========================*/
+void IRAM_ATTR MetricsAdd(metrics_counter_t counter, uint32_t value){
+	__atomic_fetch_add(&metrics_counters[counter], value, __ATOMIC_RELAXED);
+}
+
+void IRAM_ATTR MetricsRecord(metrics_hist_t hist, uint32_t cycles){
+	metrics_histogram_t *h = &metrics_hists[hist];
+	uint8_t bucket = metrics_bucket(cycles);
+	portENTER_CRITICAL_SAFE(&metrics_lock);
+	h->count++;
+	h->sum += cycles;
+	if(cycles > h->max){
+		h->max = cycles;
+	}
+	h->buckets[bucket]++;
+	portEXIT_CRITICAL_SAFE(&metrics_lock);
+}
+
+uint32_t MetricsGetCounter(metrics_counter_t counter){
+	return __atomic_load_n(&metrics_counters[counter], __ATOMIC_RELAXED);
+}
+
+void MetricsGetHistogram(metrics_hist_t hist, metrics_histogram_t *histogram){
+	portENTER_CRITICAL_SAFE(&metrics_lock);
+	*histogram = metrics_hists[hist];
+	portEXIT_CRITICAL_SAFE(&metrics_lock);
+}
+
+void MetricsReset(void){
+	portENTER_CRITICAL_SAFE(&metrics_lock);
+	memset(metrics_counters, 0, sizeof(metrics_counters));
+	memset(metrics_hists, 0, sizeof(metrics_hists));
+	portEXIT_CRITICAL_SAFE(&metrics_lock);
+}
+
+void MetricsDump(uart_mcu_port_t port){
+	char line[METRICS_LINE_MAX];
+	uint16_t len;
+	uint32_t mhz = esp_rom_get_cpu_ticks_per_us();
+	metrics_histogram_t h;
+	for(uint8_t i = 0; i < METRICS_COUNTERS_QTY; i++){
+		len = metrics_text(line, metrics_counter_names[i]);
+		line[len++] = ' ';
+		len += FmtUint(&line[len], MetricsGetCounter(i), 10, 0, ' ');
+		metrics_send_line(port, line, len);
+	}
+	for(uint8_t i = 0; i < METRICS_HISTS_QTY; i++){
+		MetricsGetHistogram(i, &h);
+		len = metrics_text(line, metrics_hist_names[i]);
+		len += metrics_field(&line[len], "n", h.count);
+		len += metrics_field(&line[len], "mean_ns", h.count ? h.sum * 1000 / mhz / h.count : 0);
+		len += metrics_field(&line[len], "max_ns", (uint64_t)h.max * 1000 / mhz);
+		metrics_send_line(port, line, len);
+		if(h.count == 0){
+			continue;
+		}
+		len = metrics_text(line, metrics_hist_names[i]);
+		len += metrics_text(&line[len], " lt_ns");
+		for(uint8_t b = 0; b < METRICS_HIST_BUCKETS; b++){
+			if(h.buckets[b] == 0){
+				continue;
+			}
+			line[len++] = ' ';
+			if(b == METRICS_HIST_BUCKETS - 1){
+				line[len++] = 'i';
+				line[len++] = 'n';
+				line[len++] = 'f';
+			} else{
+				len += FmtUint(&line[len], ((uint64_t)1000 << (b + METRICS_BUCKET_SHIFT)) / mhz, 10, 0, ' ');
+			}
+			line[len++] = ':';
+			len += FmtUint(&line[len], h.buckets[b], 10, 0, ' ');
+		}
+		metrics_send_line(port, line, len);
+	}
+}
+
+void MetricsCmd(const char *args, uint16_t len, void *param){
+	if(strncmp(args, "reset", 5) == 0){
+		MetricsReset();
+	} else{
+		MetricsDump((uart_mcu_port_t)(uintptr_t)param);
+	}
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
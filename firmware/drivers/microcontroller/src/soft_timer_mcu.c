@@ -0,0 +1,281 @@
+/**
+ * @file soft_timer_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "soft_timer_mcu.h"
+#include "driver/gptimer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "trace_mcu.h"
+#include "metrics_mcu.h"
+#include "esp_cpu.h"
+/*==================[macros and definitions]=================================*/
+#define US_RESOLUTION_HZ	1000000	/*!< 1usec */
+/*==================[internal data declaration]==============================*/
+static gptimer_handle_t soft_timer_hw = NULL;				/*!< Free running timer */
+static soft_timer_t *soft_timer_heap[SOFT_TIMER_MAX + 1];	/*!< Min-heap by deadline (1 based, [1] is the nearest) */
+static uint8_t soft_timer_len;								/*!< Timers in the heap */
+static uint64_t soft_timer_armed = UINT64_MAX;				/*!< Current hardware alarm */
+static soft_timer_stats_t soft_timer_stats;				/*!< Statistics */
+static portMUX_TYPE soft_timer_lock = portMUX_INITIALIZER_UNLOCKED;	/*!< Protects the heap */
+static volatile uint8_t soft_timer_init_state;				/*!< 0: not initialized, 1: in progress, 2: done */
+/*==================[internal functions declaration]=========================*/
+static void soft_timer_place(uint8_t pos, soft_timer_t *timer);
+static void soft_timer_sift_up(uint8_t pos);
+static void soft_timer_sift_down(uint8_t pos);
+static void soft_timer_remove(soft_timer_t *timer);
+static void soft_timer_arm(void);
+static bool soft_timer_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data);
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Store a timer at a heap position
+ */
+static inline void IRAM_ATTR soft_timer_place(uint8_t pos, soft_timer_t *timer){
+	soft_timer_heap[pos] = timer;
+	timer->slot = pos;
+}
+
+/**
+ * @brief Move a timer towards the top while its deadline is earlier than its parent's
+ */
+static void IRAM_ATTR soft_timer_sift_up(uint8_t pos){
+	soft_timer_t *timer = soft_timer_heap[pos];
+	while(pos > 1 && soft_timer_heap[pos / 2]->deadline > timer->deadline){
+		soft_timer_place(pos, soft_timer_heap[pos / 2]);
+		pos /= 2;
+	}
+	soft_timer_place(pos, timer);
+}
+
+/**
+ * @brief Move a timer towards the bottom while a child has an earlier deadline
+ */
+static void IRAM_ATTR soft_timer_sift_down(uint8_t pos){
+	soft_timer_t *timer = soft_timer_heap[pos];
+	while(2 * pos <= soft_timer_len){
+		uint8_t child = 2 * pos;
+		if(child < soft_timer_len && soft_timer_heap[child + 1]->deadline < soft_timer_heap[child]->deadline){
+			child++;
+		}
+		if(soft_timer_heap[child]->deadline >= timer->deadline){
+			break;
+		}
+		soft_timer_place(pos, soft_timer_heap[child]);
+		pos = child;
+	}
+	soft_timer_place(pos, timer);
+}
+
+/**
+ * @brief Take a timer out of the heap (call with lock taken)
+ */
+static void IRAM_ATTR soft_timer_remove(soft_timer_t *timer){
+	uint8_t pos = timer->slot;
+	soft_timer_t *last = soft_timer_heap[soft_timer_len--];
+	timer->slot = 0;
+	if(last == timer){
+		return;
+	}
+	soft_timer_place(pos, last);
+	if(pos > 1 && soft_timer_heap[pos / 2]->deadline > last->deadline){
+		soft_timer_sift_up(pos);
+	}
+	else{
+		soft_timer_sift_down(pos);
+	}
+}
+
+/**
+ * @brief Set the hardware alarm to the nearest deadline (call with lock taken)
+ */
+static void IRAM_ATTR soft_timer_arm(void){
+	if(soft_timer_len == 0 || soft_timer_heap[1]->deadline == soft_timer_armed){
+		/* Nothing to do: with no timers a stale alarm only causes an empty ISR */
+		return;
+	}
+	soft_timer_armed = soft_timer_heap[1]->deadline;
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = soft_timer_armed,
+	};
+	/* A deadline already passed triggers the alarm right away */
+	gptimer_set_alarm_action(soft_timer_hw, &alarm_config);
+}
+
+/**
+ * @brief Alarm ISR: run every expired callback and rearm for the next deadline
+ * 
+ * @return true if a callback woke a higher priority task
+ */
+static bool IRAM_ATTR soft_timer_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+	uint64_t start = edata->count_value;
+	uint64_t now = start;
+	bool yield = false;
+	TraceBegin(TRACE_SOFT_TIMER_ISR);
+	portENTER_CRITICAL_ISR(&soft_timer_lock);
+	soft_timer_armed = UINT64_MAX;
+	while(soft_timer_len > 0 && soft_timer_heap[1]->deadline <= now){
+		soft_timer_t *expired = soft_timer_heap[1];
+		uint32_t late = now - expired->deadline;
+		soft_timer_stats.last_late_us = late;
+		if(late > soft_timer_stats.max_late_us){
+			soft_timer_stats.max_late_us = late;
+		}
+		soft_timer_stats.dispatches++;
+		if(expired->period != 0){
+			expired->deadline += expired->period;
+			if(expired->deadline <= now){
+				/* Whole periods lost: skip them and keep the phase */
+				uint32_t lost = (now - expired->deadline) / expired->period + 1;
+				soft_timer_stats.missed += lost;
+				expired->deadline += (uint64_t)lost * expired->period;
+			}
+			soft_timer_sift_down(1);
+		}
+		else{
+			soft_timer_remove(expired);
+		}
+		bool (*func_p)(void*) = expired->func_p;
+		void *param_p = expired->param_p;
+		portEXIT_CRITICAL_ISR(&soft_timer_lock);
+		uint32_t cycles = esp_cpu_get_cycle_count();
+		yield |= func_p(param_p);
+		MetricsRecord(METRICS_SOFT_TIMER_CALLBACK, esp_cpu_get_cycle_count() - cycles);
+		gptimer_get_raw_count(soft_timer_hw, &now);
+		portENTER_CRITICAL_ISR(&soft_timer_lock);
+	}
+	soft_timer_arm();
+	soft_timer_stats.active = soft_timer_len;
+	portEXIT_CRITICAL_ISR(&soft_timer_lock);
+	if(now - start > soft_timer_stats.max_isr_us){
+		soft_timer_stats.max_isr_us = now - start;
+	}
+	TraceEnd(TRACE_SOFT_TIMER_ISR);
+	return yield;
+}
+
+/*==================[external functions definition]==========================*/
+bool SoftTimerInit(void){
+	bool first = false;
+	portENTER_CRITICAL(&soft_timer_lock);
+	if(soft_timer_init_state == 0){
+		soft_timer_init_state = 1;
+		first = true;
+	}
+	portEXIT_CRITICAL(&soft_timer_lock);
+	if(!first){
+		/* Another task may be creating the timer */
+		while(soft_timer_init_state == 1){
+			vTaskDelay(1);
+		}
+		return (soft_timer_init_state == 2);
+	}
+	gptimer_config_t timer_config = {
+		.clk_src = GPTIMER_CLK_SRC_DEFAULT,
+		.direction = GPTIMER_COUNT_UP,
+		.resolution_hz = US_RESOLUTION_HZ,
+	};
+	gptimer_event_callbacks_t alarm = {
+		.on_alarm = soft_timer_isr,
+	};
+	gptimer_handle_t timer = NULL;
+	esp_err_t err = gptimer_new_timer(&timer_config, &timer);
+	if(err == ESP_OK){
+		err = gptimer_register_event_callbacks(timer, &alarm, NULL);
+	}
+	if(err == ESP_OK){
+		err = gptimer_enable(timer);
+	}
+	if(err == ESP_OK){
+		err = gptimer_start(timer);
+		if(err != ESP_OK){
+			gptimer_disable(timer);
+		}
+	}
+	if(err != ESP_OK){
+		/* No gptimer free: release what was taken, a later call tries again */
+		if(timer != NULL){
+			gptimer_del_timer(timer);
+		}
+		soft_timer_init_state = 0;
+		return false;
+	}
+	soft_timer_hw = timer;
+	soft_timer_init_state = 2;
+	return true;
+}
+
+bool SoftTimerStart(soft_timer_t *timer, uint32_t delay, uint32_t period, void *func_p, void *param_p){
+	return SoftTimerStartAt(timer, SoftTimerNow() + delay, period, func_p, param_p);
+}
+
+bool SoftTimerStartAt(soft_timer_t *timer, uint64_t deadline, uint32_t period, void *func_p, void *param_p){
+	bool started = false;
+	if(soft_timer_hw == NULL){
+		/* SoftTimerInit() not called or failed */
+		return false;
+	}
+	portENTER_CRITICAL_SAFE(&soft_timer_lock);
+	if(timer->slot != 0){
+		soft_timer_remove(timer);
+	}
+	if(soft_timer_len < SOFT_TIMER_MAX){
+		timer->func_p = func_p;
+		timer->param_p = param_p;
+		timer->period = period;
+		timer->deadline = deadline;
+		soft_timer_len++;
+		soft_timer_place(soft_timer_len, timer);
+		soft_timer_sift_up(soft_timer_len);
+		soft_timer_arm();
+		started = true;
+	}
+	soft_timer_stats.active = soft_timer_len;
+	if(soft_timer_len > soft_timer_stats.max_active){
+		soft_timer_stats.max_active = soft_timer_len;
+	}
+	portEXIT_CRITICAL_SAFE(&soft_timer_lock);
+	return started;
+}
+
+void SoftTimerStop(soft_timer_t *timer){
+	portENTER_CRITICAL_SAFE(&soft_timer_lock);
+	if(timer->slot != 0){
+		soft_timer_remove(timer);
+		soft_timer_arm();
+	}
+	soft_timer_stats.active = soft_timer_len;
+	portEXIT_CRITICAL_SAFE(&soft_timer_lock);
+}
+
+bool SoftTimerActive(const soft_timer_t *timer){
+	return timer->slot != 0;
+}
+
+uint64_t IRAM_ATTR SoftTimerNow(void){
+	uint64_t now = 0;
+	gptimer_get_raw_count(soft_timer_hw, &now);
+	return now;
+}
+
+void SoftTimerGetStats(soft_timer_stats_t *stats){
+	portENTER_CRITICAL_SAFE(&soft_timer_lock);
+	*stats = soft_timer_stats;
+	portEXIT_CRITICAL_SAFE(&soft_timer_lock);
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
@@ -15,6 +15,9 @@
 #include <string.h>
 #include "driver/spi_master.h"
 #include "gpio_mcu.h"
+#include "isr_notify_mcu.h"
+#include "trace_mcu.h"
+#include "metrics_mcu.h"
 /*==================[macros and definitions]=================================*/
 #define PIN_NUM_MISO	GPIO_22	/*!<  */
 #define PIN_NUM_MOSI	GPIO_21	/*!<  */
@@ -39,21 +42,40 @@ void (*spi_3_isr_p)(void*);	/*!<  */
 void *spi_1_user_data;	    /*!<  */
 void *spi_2_user_data;	    /*!<  */
 void *spi_3_user_data;	    /*!<  */
+static isr_notify_t *spi_notify[3];	/*!< Bound tasks (SPI_1 to SPI_3) */
 /*==================[internal functions declaration]=========================*/
+static void spi_notify_isr(isr_notify_t *notify);
 static void IRAM_ATTR spi_1_isr(spi_transaction_t *t){
-	spi_1_isr_p(spi_1_user_data);
+	if(spi_1_isr_p != NULL){
+		spi_1_isr_p(spi_1_user_data);
+	}
+	spi_notify_isr(spi_notify[0]);
 }
 static void IRAM_ATTR spi_2_isr(spi_transaction_t *t){
-	spi_2_isr_p(spi_2_user_data);
+	if(spi_2_isr_p != NULL){
+		spi_2_isr_p(spi_2_user_data);
+	}
+	spi_notify_isr(spi_notify[1]);
 }
 static void IRAM_ATTR spi_3_isr(spi_transaction_t *t){
-	spi_3_isr_p(spi_3_user_data);
+	if(spi_3_isr_p != NULL){
+		spi_3_isr_p(spi_3_user_data);
+	}
+	spi_notify_isr(spi_notify[2]);
 }
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief Notify the bound task (if any) at the end of a transaction
+ */
+static void IRAM_ATTR spi_notify_isr(isr_notify_t *notify){
+	if(notify != NULL && IsrNotifyFromISR(notify)){
+		portYIELD_FROM_ISR();
+	}
+}
 
 /*==================[external functions definition]==========================*/
 uint8_t SpiInit(spi_mcu_config_t* spi){
@@ -80,20 +102,20 @@ uint8_t SpiInit(spi_mcu_config_t* spi){
             break;
         case SPI_2:
             dev_cfg.spics_io_num = PIN_NUM_CS2;
+            transfer_mode_2 = spi->transfer_mode;
             if(transfer_mode_2 == SPI_INTERRUPT){
                 dev_cfg.post_cb = spi_2_isr;
             } 
-            transfer_mode_1 = spi->transfer_mode;
             spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_2);
             spi_2_isr_p = spi->func_p;
             spi_2_user_data = spi->param_p;
             break;
         case SPI_3:
             dev_cfg.spics_io_num = PIN_NUM_CS3;
+            transfer_mode_3 = spi->transfer_mode;
             if(transfer_mode_3 == SPI_INTERRUPT){
                 dev_cfg.post_cb = spi_3_isr;
             } 
-            transfer_mode_1 = spi->transfer_mode;
             spi_bus_add_device(SPI2_HOST, &dev_cfg, &spi_3);
             spi_3_isr_p = spi->func_p;
             spi_3_user_data = spi->param_p;
@@ -108,6 +130,8 @@ void SpiRead(spi_dev_t device, uint8_t * rx_buffer, uint32_t rx_buffer_size){
     t.length = rx_buffer_size * 8;  // tx_buffer_size is in bytes, transaction length is in bits.
     t.rxlength = rx_buffer_size * 8;
     t.rx_buffer = rx_buffer;        // Data
+    MetricsAdd(METRICS_SPI_TRANSACTIONS, 1);
+    MetricsAdd(METRICS_SPI_BYTES, rx_buffer_size);
     switch(device){
         case SPI_1:
             switch(transfer_mode_1){
@@ -144,9 +168,12 @@ void SpiRead(spi_dev_t device, uint8_t * rx_buffer, uint32_t rx_buffer_size){
 
 void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size){
     spi_transaction_t t;
+    TraceBegin(TRACE_SPI_WRITE);
     memset(&t, 0, sizeof(t));       // Zero out the transaction
     t.length = tx_buffer_size * 8;  // tx_buffer_size is in bytes, transaction length is in bits.
     t.tx_buffer = tx_buffer;        // Data
+    MetricsAdd(METRICS_SPI_TRANSACTIONS, 1);
+    MetricsAdd(METRICS_SPI_BYTES, tx_buffer_size);
     switch(device){
         case SPI_1:
             switch(transfer_mode_1){
@@ -179,6 +206,7 @@ void SpiWrite(spi_dev_t device, uint8_t * tx_buffer, uint32_t tx_buffer_size){
             }
             break;
     }
+    TraceEnd(TRACE_SPI_WRITE);
 }
 
 void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, uint32_t buffer_size){
@@ -188,6 +216,8 @@ void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, ui
     t.rxlength = buffer_size * 8;
     t.tx_buffer = tx_buffer;        // Data
     t.rx_buffer = rx_buffer;        
+    MetricsAdd(METRICS_SPI_TRANSACTIONS, 1);
+    MetricsAdd(METRICS_SPI_BYTES, buffer_size);
     switch(device){
         case SPI_1:
             switch(transfer_mode_1){
@@ -222,6 +252,10 @@ void SpiReadWrite(spi_dev_t device, uint8_t * tx_buffer, uint8_t * rx_buffer, ui
     }
 }
 
+void SpiNotifyTask(spi_dev_t device, isr_notify_t *notify){
+    spi_notify[device] = notify;
+}
+
 uint8_t SpiDeInit(spi_dev_t device){
     return 0;
 }
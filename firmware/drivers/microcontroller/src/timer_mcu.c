@@ -12,11 +12,20 @@
 /*==================[inclusions]=============================================*/
 #include "timer_mcu.h"
 #include "driver/gptimer.h"
+#include "driver/gptimer_etm.h"
+#include "driver/gpio.h"
+#include "driver/gpio_etm.h"
+#include "esp_etm.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "isr_notify_mcu.h"
+#include "trace_mcu.h"
+#include "metrics_mcu.h"
+#include "esp_cpu.h"
 /*==================[macros and definitions]=================================*/
 #define US_RESOLUTION_HZ	1000000	/*!< 1usec */
 #define RESET_COUNT_VALUE	0		/*!< Reset timer count to 0 */
+#define TIMER_QTY			3		/*!< Number of timers */
 /*==================[internal data declaration]==============================*/
 gptimer_handle_t timer_a = NULL;		/*!<  */
 gptimer_handle_t timer_b = NULL;		/*!<  */
@@ -32,24 +41,173 @@ void (*timer_c_isr_p)(void*);	/*!<  */
 void *timer_a_user_data;	/*!<  */
 void *timer_b_user_data;	/*!<  */
 void *timer_c_user_data;	/*!<  */
+static uint32_t timer_period[TIMER_QTY];				/*!< Current period (us) */
+static volatile uint32_t timer_next_period[TIMER_QTY];	/*!< Period to apply at the next alarm (0: no change) */
+static bool timer_running[TIMER_QTY];					/*!< Timer started */
+static isr_notify_t *timer_notify[TIMER_QTY];			/*!< Bound tasks */
+static portMUX_TYPE timer_group_lock = portMUX_INITIALIZER_UNLOCKED;	/*!< Group start critical section */
+static int8_t timer_group_pin = -1;						/*!< GPIO whose edge starts a group through ETM (-1: none) */
 /*==================[internal functions declaration]=========================*/
+static gptimer_handle_t timer_handle(timer_mcu_t timer);
+static void timer_set_alarm(timer_mcu_t timer, uint32_t period);
+static void timer_update_period(timer_mcu_t timer);
+static bool timer_notify_isr(timer_mcu_t timer, bool callback);
+static bool timer_group_etm_start(const timer_mcu_t *timers, uint8_t count);
 static bool IRAM_ATTR timer_a_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	timer_a_isr_p(timer_a_user_data);
-	return true;
+	TraceBegin(TRACE_TIMER_A_ISR);
+	timer_update_period(TIMER_A);
+	if(timer_a_isr_p != NULL){
+		uint32_t start = esp_cpu_get_cycle_count();
+		timer_a_isr_p(timer_a_user_data);
+		MetricsRecord(METRICS_TIMER_CALLBACK, esp_cpu_get_cycle_count() - start);
+	}
+	bool yield = timer_notify_isr(TIMER_A, timer_a_isr_p != NULL);
+	TraceEnd(TRACE_TIMER_A_ISR);
+	return yield;
 }
 static bool IRAM_ATTR timer_b_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	timer_b_isr_p(timer_b_user_data);
-	return true;
+	TraceBegin(TRACE_TIMER_B_ISR);
+	timer_update_period(TIMER_B);
+	if(timer_b_isr_p != NULL){
+		uint32_t start = esp_cpu_get_cycle_count();
+		timer_b_isr_p(timer_b_user_data);
+		MetricsRecord(METRICS_TIMER_CALLBACK, esp_cpu_get_cycle_count() - start);
+	}
+	bool yield = timer_notify_isr(TIMER_B, timer_b_isr_p != NULL);
+	TraceEnd(TRACE_TIMER_B_ISR);
+	return yield;
 }
 static bool IRAM_ATTR timer_c_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
-	timer_c_isr_p(timer_c_user_data);
-	return true;
+	TraceBegin(TRACE_TIMER_C_ISR);
+	timer_update_period(TIMER_C);
+	if(timer_c_isr_p != NULL){
+		uint32_t start = esp_cpu_get_cycle_count();
+		timer_c_isr_p(timer_c_user_data);
+		MetricsRecord(METRICS_TIMER_CALLBACK, esp_cpu_get_cycle_count() - start);
+	}
+	bool yield = timer_notify_isr(TIMER_C, timer_c_isr_p != NULL);
+	TraceEnd(TRACE_TIMER_C_ISR);
+	return yield;
 }
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
+/**
+ * @brief gptimer handle of a timer
+ */
+static gptimer_handle_t IRAM_ATTR timer_handle(timer_mcu_t timer){
+	switch(timer){
+		case TIMER_B:
+			return timer_b;
+		case TIMER_C:
+			return timer_c;
+		case TIMER_A:
+		default:
+			return timer_a;
+	}
+}
+
+/**
+ * @brief Set the alarm (auto reload to 0) of a timer
+ */
+static void IRAM_ATTR timer_set_alarm(timer_mcu_t timer, uint32_t period){
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = period,
+		.reload_count = RESET_COUNT_VALUE,
+		.flags.auto_reload_on_alarm = true,
+	};
+	gptimer_set_alarm_action(timer_handle(timer), &alarm_config);
+	timer_period[timer] = period;
+}
+
+/**
+ * @brief Apply a pending period change. Called from the alarm ISR, right after 
+ * the count is reloaded, so the period that just ended keeps its old length.
+ */
+static void IRAM_ATTR timer_update_period(timer_mcu_t timer){
+	uint32_t period = timer_next_period[timer];
+	if(period != 0){
+		timer_next_period[timer] = 0;
+		timer_set_alarm(timer, period);
+	}
+}
+
+
+/**
+ * @brief Notify the bound task (if any) from the alarm ISR
+ * 
+ * @param timer Timer
+ * @param callback A callback was called (it may have woken a task without 
+ * reporting it, so a context switch is always requested as before)
+ * @return true if a context switch is needed
+ */
+static bool IRAM_ATTR timer_notify_isr(timer_mcu_t timer, bool callback){
+	bool yield = callback;
+	if(timer_notify[timer] != NULL){
+		yield |= IsrNotifyFromISR(timer_notify[timer]);
+	}
+	return yield;
+}
+
+/**
+ * @brief Start the counters of a group in hardware: a rising edge of the group 
+ * pin is a single ETM event, linked to the start task of every timer, so all 
+ * of them start on the same clock cycle. The ETM resources are released after 
+ * the start.
+ * 
+ * @param timers Timers
+ * @param count Number of timers
+ * @return true if the counters were started, false if there is no group pin 
+ * or no ETM channel free (nothing is started then)
+ */
+static bool timer_group_etm_start(const timer_mcu_t *timers, uint8_t count){
+	gpio_etm_event_config_t event_config = {
+		.edge = GPIO_ETM_EVENT_EDGE_POS,
+	};
+	gptimer_etm_task_config_t task_config = {
+		.task_type = GPTIMER_ETM_TASK_START_COUNT,
+	};
+	esp_etm_channel_config_t channel_config = {0};
+	esp_etm_event_handle_t event = NULL;
+	esp_etm_task_handle_t tasks[TIMER_QTY] = {NULL};
+	esp_etm_channel_handle_t channels[TIMER_QTY] = {NULL};
+	int8_t pin = timer_group_pin;
+	if(pin < 0 || count > TIMER_QTY){
+		return false;
+	}
+	/* Output low, with its input enabled for the ETM event */
+	gpio_set_level(pin, 0);
+	gpio_set_direction(pin, GPIO_MODE_INPUT_OUTPUT);
+	/* Allocation stops at the first error (ESP_OK chains through) */
+	esp_err_t err = gpio_new_etm_event(&event_config, &event);
+	if(err == ESP_OK) err = gpio_etm_event_bind_gpio(event, pin);
+	for(uint8_t i = 0; i < count && err == ESP_OK; i++){
+		err = gptimer_new_etm_task(timer_handle(timers[i]), &task_config, &tasks[i]);
+		if(err == ESP_OK) err = esp_etm_new_channel(&channel_config, &channels[i]);
+		if(err == ESP_OK) err = esp_etm_channel_connect(channels[i], event, tasks[i]);
+		if(err == ESP_OK) err = esp_etm_channel_enable(channels[i]);
+	}
+	if(err == ESP_OK){
+		gpio_set_level(pin, 1);
+	}
+	for(uint8_t i = 0; i < count; i++){
+		if(channels[i] != NULL){
+			/* Fails harmlessly if the channel was not enabled */
+			esp_etm_channel_disable(channels[i]);
+			esp_etm_del_channel(channels[i]);
+		}
+		if(tasks[i] != NULL){
+			esp_etm_del_task(tasks[i]);
+		}
+	}
+	if(event != NULL){
+		esp_etm_del_event(event);
+	}
+	gpio_set_level(pin, 0);
+	return (err == ESP_OK);
+}
 
 /*==================[external functions definition]==========================*/
 void TimerInit(timer_config_t *timer_ini){
@@ -69,6 +227,9 @@ void TimerInit(timer_config_t *timer_ini){
 			};
 			gptimer_register_event_callbacks(timer_a, &alarm_a, NULL);
 			gptimer_enable(timer_a);
+			timer_period[TIMER_A] = timer_ini->period;
+			timer_next_period[TIMER_A] = 0;
+			timer_running[TIMER_A] = false;
 	 	break;
 
 	 	case TIMER_B:
@@ -86,6 +247,9 @@ void TimerInit(timer_config_t *timer_ini){
 			};
 			gptimer_register_event_callbacks(timer_b, &alarm_b, NULL);
 			gptimer_enable(timer_b);
+			timer_period[TIMER_B] = timer_ini->period;
+			timer_next_period[TIMER_B] = 0;
+			timer_running[TIMER_B] = false;
 	 	break;
 
 	 	case TIMER_C:
@@ -103,11 +267,15 @@ void TimerInit(timer_config_t *timer_ini){
 			};
 			gptimer_register_event_callbacks(timer_c, &alarm_c, NULL);
 			gptimer_enable(timer_c);
+			timer_period[TIMER_C] = timer_ini->period;
+			timer_next_period[TIMER_C] = 0;
+			timer_running[TIMER_C] = false;
 	 	break;
 	}
 }
 
 void TimerStart(timer_mcu_t timer){
+	timer_running[timer] = true;
 	switch(timer){
 	 	case TIMER_A:
 	 		gptimer_start(timer_a);
@@ -122,6 +290,7 @@ void TimerStart(timer_mcu_t timer){
 }
 
 void TimerStop(timer_mcu_t timer){
+	timer_running[timer] = false;
 	switch(timer){
 	 	case TIMER_A:
 	 		gptimer_stop(timer_a);
@@ -149,4 +318,69 @@ void TimerReset(timer_mcu_t timer){
 	}
 }
 
+void TimerSetPeriod(timer_mcu_t timer, uint32_t period){
+	uint64_t count = 0;
+	if(period == 0){
+		return;
+	}
+	if(timer_running[timer]){
+		/* Applied by the ISR at the next alarm */
+		timer_next_period[timer] = period;
+		return;
+	}
+	timer_next_period[timer] = 0;
+	timer_set_alarm(timer, period);
+	gptimer_get_raw_count(timer_handle(timer), &count);
+	if(count >= period){
+		gptimer_set_raw_count(timer_handle(timer), RESET_COUNT_VALUE);
+	}
+}
+
+uint32_t TimerGetPeriod(timer_mcu_t timer){
+	uint32_t period = timer_next_period[timer];
+	return (period != 0) ? period : timer_period[timer];
+}
+
+void TimerNotifyTask(timer_mcu_t timer, isr_notify_t *notify){
+	timer_notify[timer] = notify;
+}
+
+uint32_t TimerGetCapture(timer_mcu_t timer){
+	uint64_t count = 0;
+	gptimer_get_captured_count(timer_handle(timer), &count);
+	return count;
+}
+
+void *TimerGetHandle(timer_mcu_t timer){
+	return timer_handle(timer);
+}
+
+void TimerSetGroupPin(gpio_t pin){
+	timer_group_pin = pin;
+}
+
+bool TimerStartGroup(const timer_mcu_t *timers, const uint32_t *phase, uint8_t count){
+	for(uint8_t i = 0; i < count; i++){
+		timer_mcu_t timer = timers[i];
+		if(timer_running[timer]){
+			gptimer_stop(timer_handle(timer));
+		}
+		timer_update_period(timer);
+		/* First alarm phase[i] us after the start (a whole period if 0) */
+		uint32_t offset = (phase != NULL) ? phase[i] % timer_period[timer] : 0;
+		gptimer_set_raw_count(timer_handle(timer), (offset != 0) ? timer_period[timer] - offset : RESET_COUNT_VALUE);
+		timer_running[timer] = true;
+	}
+	bool together = timer_group_etm_start(timers, count);
+	/* Without ETM the counters start one call after another, with interrupts 
+	 * off. After an ETM start this only updates the driver state (the counters 
+	 * keep running) */
+	portENTER_CRITICAL(&timer_group_lock);
+	for(uint8_t i = 0; i < count; i++){
+		gptimer_start(timer_handle(timers[i]));
+	}
+	portEXIT_CRITICAL(&timer_group_lock);
+	return together;
+}
+
 /*==================[end of file]============================================*/
@@ -0,0 +1,40 @@
+/**
+ * @file timestamp_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "timestamp_mcu.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+/*==================[macros and definitions]=================================*/
+
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+
+/*==================[internal data definition]===============================*/
+
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+
+/*==================[external functions definition]==========================*/
+uint64_t IRAM_ATTR TimestampNow(void){
+	return (uint64_t)esp_timer_get_time();
+}
+
+uint64_t IRAM_ATTR TimestampElapsed(uint64_t since){
+	return (uint64_t)esp_timer_get_time() - since;
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
@@ -0,0 +1,187 @@
+/**
+ * @file trace_mcu.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "trace_mcu.h"
+#include "fmt.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include <stddef.h>
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define TRACE_NAME_MAX	40		/*!< Longest event name in the dump (longer ones are cut) */
+#define TRACE_LINE_MAX	(TRACE_NAME_MAX + 3 * FMT_BUF_SIZE)	/*!< Dump line buffer */
+/**
+ * @brief Recorded event
+ */
+typedef struct {
+	uint32_t cycles;		/*!< CPU cycle count */
+	uint32_t task;			/*!< Task handle (0: ISR) */
+	uint16_t id;			/*!< Event id */
+	char type;				/*!< 'B': begin, 'E': end, 'i': instant */
+} trace_event_t;
+/*==================[internal data declaration]==============================*/
+static trace_event_t trace_buffer[TRACE_BUFFER_SIZE];	/*!< Event ring */
+static uint32_t trace_head = 0;							/*!< Events written since TraceStart() */
+static volatile bool trace_on = false;					/*!< Recording */
+/*==================[internal functions declaration]=========================*/
+static void trace_record(uint16_t id, char type);
+static uint8_t trace_text(char *line, const char *text, uint8_t max);
+static void trace_send_line(uart_mcu_port_t port, char *line, uint8_t len);
+/*==================[internal data definition]===============================*/
+static const char *trace_names[TRACE_IDS_MAX] = {
+	[TRACE_LCD_WRITE] = "WriteLCD",
+	[TRACE_SPI_WRITE] = "SpiWrite",
+	[TRACE_I2C_READ] = "I2C_readBytes",
+	[TRACE_ADC_READ] = "AnalogInputReadSingle",
+	[TRACE_HX711_READ] = "HX711_read",
+	[TRACE_TIMER_A_ISR] = "Timer A ISR",
+	[TRACE_TIMER_B_ISR] = "Timer B ISR",
+	[TRACE_TIMER_C_ISR] = "Timer C ISR",
+	[TRACE_SOFT_TIMER_ISR] = "Soft timer ISR",
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Reserve a slot and store an event in it
+ */
+static void IRAM_ATTR trace_record(uint16_t id, char type){
+	uint32_t cycles = esp_cpu_get_cycle_count();
+	if(!trace_on){
+		return;
+	}
+	/* Atomic reservation: a preempting writer gets the next slot */
+	uint32_t slot = __atomic_fetch_add(&trace_head, 1, __ATOMIC_RELAXED) & (TRACE_BUFFER_SIZE - 1);
+	trace_event_t *event = &trace_buffer[slot];
+	event->cycles = cycles;
+	event->task = xPortInIsrContext() ? 0 : (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+	event->id = id;
+	event->type = type;
+}
+
+/**
+ * @brief Copy text into a dump line
+ *
+ * @return uint8_t Characters written (at most max)
+ */
+static uint8_t trace_text(char *line, const char *text, uint8_t max){
+	uint8_t len = 0;
+	while(text[len] != '\0' && len < max){
+		line[len] = text[len];
+		len++;
+	}
+	return len;
+}
+
+/**
+ * @brief Send a complete dump line, adding the end of line. The whole line
+ * goes in a single write, so lines never interleave with other output.
+ */
+static void trace_send_line(uart_mcu_port_t port, char *line, uint8_t len){
+	line[len++] = '\n';
+	line[len] = '\0';
+	UartSendString(port, line);
+}
+
+/*==================[external functions definition]==========================*/
+void TraceStart(void){
+	trace_on = false;
+	trace_head = 0;
+	trace_on = true;
+}
+
+void TraceStop(void){
+	trace_on = false;
+}
+
+void TraceSetName(uint16_t id, const char *name){
+	if(id < TRACE_IDS_MAX){
+		trace_names[id] = name;
+	}
+}
+
+void IRAM_ATTR TraceBegin(uint16_t id){
+	trace_record(id, 'B');
+}
+
+void IRAM_ATTR TraceEnd(uint16_t id){
+	trace_record(id, 'E');
+}
+
+void IRAM_ATTR TraceMark(uint16_t id){
+	trace_record(id, 'i');
+}
+
+void TraceDump(uart_mcu_port_t port){
+	char line[TRACE_LINE_MAX];
+	uint8_t len;
+	bool was_on = trace_on;
+	trace_on = false;
+	/* Let writers that already passed the check finish their slot */
+	vTaskDelay(1);
+	uint32_t head = trace_head;
+	uint32_t count = (head > TRACE_BUFFER_SIZE) ? TRACE_BUFFER_SIZE : head;
+
+	len = trace_text(line, "# trace ", TRACE_NAME_MAX);
+	len += FmtUint(&line[len], esp_rom_get_cpu_ticks_per_us(), 10, 0, ' ');
+	line[len++] = ' ';
+	len += FmtUint(&line[len], count, 10, 0, ' ');
+	line[len++] = ' ';
+	len += FmtUint(&line[len], head - count, 10, 0, ' ');
+	trace_send_line(port, line, len);
+
+	for(uint16_t id = 0; id < TRACE_IDS_MAX; id++){
+		if(trace_names[id] == NULL){
+			continue;
+		}
+		len = trace_text(line, "N ", TRACE_NAME_MAX);
+		len += FmtUint(&line[len], id, 10, 0, ' ');
+		line[len++] = ' ';
+		len += trace_text(&line[len], trace_names[id], TRACE_NAME_MAX);
+		trace_send_line(port, line, len);
+	}
+
+	for(uint32_t i = head - count; i != head; i++){
+		trace_event_t *event = &trace_buffer[i & (TRACE_BUFFER_SIZE - 1)];
+		len = 0;
+		line[len++] = event->type;
+		line[len++] = ' ';
+		len += FmtUint(&line[len], event->cycles, 10, 0, ' ');
+		line[len++] = ' ';
+		len += FmtUint(&line[len], event->id, 10, 0, ' ');
+		line[len++] = ' ';
+		len += FmtUint(&line[len], event->task, 16, 0, ' ');
+		trace_send_line(port, line, len);
+	}
+	len = trace_text(line, "# end", TRACE_NAME_MAX);
+	trace_send_line(port, line, len);
+	trace_on = was_on;
+}
+
+void TraceCmd(const char *args, uint16_t len, void *param){
+	uart_mcu_port_t port = (uart_mcu_port_t)(uintptr_t)param;
+	if(strncmp(args, "start", 5) == 0){
+		TraceStart();
+	} else if(strncmp(args, "stop", 4) == 0){
+		TraceStop();
+	} else{
+		TraceDump(port);
+	}
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
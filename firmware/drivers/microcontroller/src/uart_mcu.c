@@ -12,99 +12,453 @@
 /*==================[inclusions]=============================================*/
 #include "uart_mcu.h"
 #include "gpio_mcu.h"
+#include "fmt.h"
+#include "metrics_mcu.h"
 #include "driver/uart.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
 /*==================[macros and definitions]=================================*/
 #define UART_CONN_TX        GPIO_18         /*!<  */
 #define UART_CONN_RX        GPIO_19         /*!<  */
-#define TX_BUFFER_SIZE      256             /*!<  */
-#define RX_BUFFER_SIZE      256             /*!<  */
-#define EVENT_QUEUE_SIZE    16              /*!<  */
+#define TX_BUFFER_SIZE      256             /*!< Default driver transmit buffer */
+#define RX_BUFFER_SIZE      256             /*!< Default driver receive buffer */
+#define EVENT_QUEUE_SIZE    16              /*!< Default event queue length */
+#define EVENT_TASK_STACK    2048            /*!< Event task stack */
+#define EVENT_TASK_PRIO     12              /*!< Event task priority */
 #define READ_TIMEOUT        100             /*!<  */
+#define UART_TX_MASK        (UART_TX_RING_SIZE - 1) /*!< Ring index mask */
+#define UART_TX_MSG_QTY     32              /*!< Message boundaries kept for UART_TX_DROP_OLDEST */
+#define UART_TX_TASK_STACK  2048            /*!< Transmit task stack */
+#define UART_TX_TASK_PRIO   5               /*!< Transmit task priority (below sampling tasks) */
+#define UART_PORT_QTY       2               /*!< Number of ports */
+#define TELEMETRY_HEADER    8               /*!< Frame header bytes (channel, sequence, timestamp, count) */
+#define TELEMETRY_MAX_FRAME (TELEMETRY_HEADER + 2 * UART_TELEMETRY_MAX_SAMPLES + 2)    /*!< Frame bytes before encoding */
+/**
+ * @brief Buffered transmitter state. Indexes are free running (masked on access).
+ */
+typedef struct {
+    char buf[UART_TX_RING_SIZE + UART_TX_MSG_MAX];  /*!< Ring, plus room for a message written past the end */
+    volatile uint32_t head;                 /*!< Write index */
+    volatile uint32_t rd;                   /*!< Next byte to hand to the driver */
+    volatile uint32_t free;                 /*!< Bytes before this index can be overwritten */
+    uint32_t msg_end[UART_TX_MSG_QTY];      /*!< End index of pending messages */
+    uint8_t msg_first;                      /*!< Oldest message boundary */
+    uint8_t msg_count;                      /*!< Message boundaries stored */
+    uart_tx_policy_t policy;                /*!< Overflow policy */
+    uint32_t dropped;                       /*!< Messages dropped */
+    bool enabled;                           /*!< Transmitter initialized */
+    TaskHandle_t task;                      /*!< Drain task */
+    SemaphoreHandle_t writer;               /*!< Serializes writers */
+    SemaphoreHandle_t space;                /*!< Given when the drain task frees space */
+    portMUX_TYPE spinlock;                  /*!< Protects indexes */
+} uart_tx_t;
+/**
+ * @brief Received line assembler and command dispatcher state
+ */
+typedef struct {
+    char line[UART_CMD_LINE_MAX + 1];       /*!< Partial line (plus room for '\0') */
+    uint16_t fill;                          /*!< Bytes in line */
+    bool discard;                           /*!< Line too long, skipping up to the next delimiter */
+    char delimiter;                         /*!< End of line character */
+    const uart_cmd_t *table;                /*!< Command table (NULL: dispatcher disabled) */
+    uint8_t count;                          /*!< Table entries */
+    uart_cmd_stats_t stats;                 /*!< Statistics */
+} uart_cmd_rx_t;
+/**
+ * @brief Port state
+ */
+typedef struct {
+    void (*isr_p)(void*);                   /*!< Received data callback */
+    void *user_data;                        /*!< Callback parameter */
+    QueueHandle_t queue;                    /*!< Driver event queue */
+    uint16_t rx_buffer_size;                /*!< Driver receive buffer */
+    uint16_t tx_buffer_size;                /*!< Driver transmit buffer */
+    uint8_t event_queue_size;               /*!< Event queue length */
+    bool event_task_on;                     /*!< Event task created */
+    uart_stats_t stats;                     /*!< Event counters */
+} uart_port_state_t;
 /*==================[internal data declaration]==============================*/
-void (*uart_pc_isr_p)(void*);	            /*!<  */
-void (*uart_conn_isr_p)(void*);	            /*!<  */
-void *uart_pc_user_data;	                /*!<  */
-void *uart_conn_user_data;	                /*!<  */
-static QueueHandle_t uart_pc_queue;         /*!<  */
-static QueueHandle_t uart_conn_queue;       /*!<  */
+static uart_port_state_t uart_port[UART_PORT_QTY];  /*!< Ports */
+static uart_tx_t uart_tx[UART_PORT_QTY];    /*!< Buffered transmitters */
+static uint16_t uart_telemetry_seq[UART_PORT_QTY];  /*!< Telemetry frame sequence numbers */
+static uart_cmd_rx_t uart_cmd[UART_PORT_QTY];       /*!< Command dispatchers */
+static const uint16_t uart_crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
 /*==================[internal functions declaration]=========================*/
+static uart_port_t uart_mcu_num(uart_mcu_port_t port);
+static void uart_event_task(void *pvParameters);
+static void uart_recover(uart_mcu_port_t port);
+static void uart_tx_task(void *pvParameters);
+static bool uart_tx_discard(uart_tx_t *tx);
+static bool uart_tx_space(uart_tx_t *tx, uint32_t len);
+static void uart_tx_commit(uart_tx_t *tx, uint32_t len);
+static void uart_cmd_receive(uart_mcu_port_t port, size_t size, int64_t t_event);
+static void uart_cmd_dispatch(uart_cmd_rx_t *rx, char *line, uint16_t len, int64_t t_event);
 
 /*==================[internal data definition]===============================*/
 
 /*==================[external data definition]===============================*/
 
 /*==================[internal functions definition]==========================*/
-static void uart_pc_event_task(void *pvParameters){
+/**
+ * @brief ESP-IDF port number of an ESP-EDU port
+ */
+static uart_port_t uart_mcu_num(uart_mcu_port_t port){
+    return (port == UART_CONNECTOR) ? UART_NUM_1 : UART_NUM_0;
+}
+
+/**
+ * @brief Event task: installs the driver, counts every event, dispatches received 
+ * data and recovers from overflows.
+ */
+static void uart_event_task(void *pvParameters){
+    uart_mcu_port_t port = (uart_mcu_port_t)(uintptr_t)pvParameters;
+    uart_port_state_t *state = &uart_port[port];
+    uart_stats_t *stats = &state->stats;
+    uart_port_t uart_num = uart_mcu_num(port);
     uart_event_t event;
-    uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_pc_queue, 0);
+    size_t buffered;
+    uart_driver_install(uart_num, state->rx_buffer_size, state->tx_buffer_size, state->event_queue_size, &state->queue, 0);
     while(1){
         //Waiting for UART event.
-        if (xQueueReceive(uart_pc_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
+        if(xQueueReceive(state->queue, (void *)&event, (TickType_t)portMAX_DELAY)){
+            int64_t t_event = esp_timer_get_time();
+            uint32_t waiting = uxQueueMessagesWaiting(state->queue) + 1;
+            if(waiting > stats->queue_max){
+                stats->queue_max = waiting;
+            }
             switch(event.type) {
                 case UART_DATA:
-                    uart_pc_isr_p(uart_pc_user_data);
+                    stats->data++;
+                    stats->rx_bytes += event.size;
+                    buffered = 0;
+                    uart_get_buffered_data_len(uart_num, &buffered);
+                    if(buffered > stats->rx_max){
+                        stats->rx_max = buffered;
+                    }
+                    if(uart_cmd[port].table != NULL){
+                        uart_cmd_receive(port, event.size, t_event);
+                    }else if(state->isr_p != NULL){
+                        state->isr_p(state->user_data);
+                    }
                     break;
                 case UART_BREAK:
+                    stats->breaks++;
                     break;
                 case UART_BUFFER_FULL:
+                    stats->buffer_full++;
+                    MetricsAdd(METRICS_UART_RX_OVERFLOWS, 1);
+                    uart_recover(port);
                     break;
                 case UART_FIFO_OVF:
+                    stats->fifo_ovf++;
+                    MetricsAdd(METRICS_UART_RX_OVERFLOWS, 1);
+                    uart_recover(port);
                     break;
                 case UART_FRAME_ERR:
+                    stats->frame_err++;
                     break;
                 case UART_PARITY_ERR:
+                    stats->parity_err++;
                     break;
                 case UART_DATA_BREAK:
+                    stats->data_break++;
                     break;
                 case UART_PATTERN_DET:
+                    stats->pattern++;
                     break;
                 case UART_WAKEUP:
+                    stats->wakeup++;
                     break;
                 case UART_EVENT_MAX:
+                default:
+                    stats->other++;
                     break;
             }
         }
     }
 }
 
-static void uart_conn_event_task(void *pvParameters){
-    uart_event_t event;
-    uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 16, &uart_conn_queue, 0);
+/**
+ * @brief Overflow recovery: the received stream is broken, so drop everything 
+ * pending (driver buffer, queued events and partial command line)
+ */
+static void uart_recover(uart_mcu_port_t port){
+    uart_flush_input(uart_mcu_num(port));
+    xQueueReset(uart_port[port].queue);
+    uart_cmd[port].fill = 0;
+    uart_cmd[port].discard = false;
+    uart_port[port].stats.flushes++;
+}
+
+/**
+ * @brief Drain task: hands everything pending to the driver, one bulk write 
+ * per contiguous part of the ring.
+ */
+static void uart_tx_task(void *pvParameters){
+    uart_mcu_port_t port = (uart_mcu_port_t)(uintptr_t)pvParameters;
+    uart_tx_t *tx = &uart_tx[port];
+    uart_port_t uart_num = uart_mcu_num(port);
     while(1){
-        //Waiting for UART event.
-        if(xQueueReceive(uart_conn_queue, (void *)&event, (TickType_t)portMAX_DELAY)){
-            switch(event.type) {
-                case UART_DATA:
-                    uart_conn_isr_p(uart_conn_user_data);
-                    break;
-                case UART_BREAK:
-                    break;
-                case UART_BUFFER_FULL:
-                    break;
-                case UART_FIFO_OVF:
-                    break;
-                case UART_FRAME_ERR:
-                    break;
-                case UART_PARITY_ERR:
-                    break;
-                case UART_DATA_BREAK:
-                    break;
-                case UART_PATTERN_DET:
-                    break;
-                case UART_WAKEUP:
-                    break;
-                case UART_EVENT_MAX:
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while(1){
+            portENTER_CRITICAL(&tx->spinlock);
+            uint32_t start = tx->rd;
+            uint32_t end = tx->head;
+            /* Whole messages are taken, so rd always stays at a message boundary */
+            tx->rd = end;
+            portEXIT_CRITICAL(&tx->spinlock);
+            if(start == end){
+                break;
+            }
+            uint32_t first = UART_TX_RING_SIZE - (start & UART_TX_MASK);
+            if(first > end - start){
+                first = end - start;
+            }
+            uart_write_bytes(uart_num, &tx->buf[start & UART_TX_MASK], first);
+            if(end - start > first){
+                uart_write_bytes(uart_num, tx->buf, end - start - first);
+            }
+            portENTER_CRITICAL(&tx->spinlock);
+            tx->free = tx->rd;
+            while(tx->msg_count > 0 && (int32_t)(tx->msg_end[tx->msg_first] - tx->rd) <= 0){
+                tx->msg_first = (tx->msg_first + 1) % UART_TX_MSG_QTY;
+                tx->msg_count--;
+            }
+            portEXIT_CRITICAL(&tx->spinlock);
+            xSemaphoreGive(tx->space);
+        }
+    }
+}
+
+/**
+ * @brief Drop the oldest message not yet handed to the driver (call with spinlock taken)
+ * 
+ * Only while the drain task is not writing: the bytes it is writing can not 
+ * be reused until it ends, so dropping queued messages would not make room 
+ * for the new one.
+ * 
+ * @return true if a message was dropped (its space is free right away)
+ */
+static bool uart_tx_discard(uart_tx_t *tx){
+    if(tx->free != tx->rd){
+        return false;
+    }
+    while(tx->msg_count > 0){
+        uint32_t end = tx->msg_end[tx->msg_first];
+        tx->msg_first = (tx->msg_first + 1) % UART_TX_MSG_QTY;
+        tx->msg_count--;
+        if((int32_t)(end - tx->rd) > 0){
+            tx->rd = end;
+            tx->free = end;
+            tx->dropped++;
+            MetricsAdd(METRICS_UART_TX_DROPS, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Make room for len bytes according to the overflow policy (call with writer mutex taken)
+ * 
+ * @return true if there is room, false if the message must be dropped
+ */
+static bool uart_tx_space(uart_tx_t *tx, uint32_t len){
+    if(len > UART_TX_RING_SIZE){
+        tx->dropped++;
+        MetricsAdd(METRICS_UART_TX_DROPS, 1);
+        return false;
+    }
+    while(1){
+        portENTER_CRITICAL(&tx->spinlock);
+        if(tx->head - tx->free + len <= UART_TX_RING_SIZE){
+            portEXIT_CRITICAL(&tx->spinlock);
+            return true;
+        }
+        switch(tx->policy){
+            case UART_TX_BLOCK:
+                portEXIT_CRITICAL(&tx->spinlock);
+                xSemaphoreTake(tx->space, portMAX_DELAY);
+                break;
+            case UART_TX_DROP_OLDEST:
+                if(uart_tx_discard(tx)){
+                    portEXIT_CRITICAL(&tx->spinlock);
                     break;
+                }
+                /* Nothing to drop, or the drain task is writing: drop the new one */
+                /* fall through */
+            case UART_TX_DROP_NEWEST:
+            default:
+                tx->dropped++;
+                MetricsAdd(METRICS_UART_TX_DROPS, 1);
+                portEXIT_CRITICAL(&tx->spinlock);
+                return false;
+        }
+    }
+}
+
+/**
+ * @brief Publish len bytes written at head and wake the drain task (call with writer mutex taken)
+ */
+static void uart_tx_commit(uart_tx_t *tx, uint32_t len){
+    portENTER_CRITICAL(&tx->spinlock);
+    tx->head += len;
+    if(tx->msg_count == UART_TX_MSG_QTY){
+        /* No room for another boundary: merge with the newest message */
+        tx->msg_end[(tx->msg_first + tx->msg_count - 1) % UART_TX_MSG_QTY] = tx->head;
+    }
+    else{
+        tx->msg_end[(tx->msg_first + tx->msg_count) % UART_TX_MSG_QTY] = tx->head;
+        tx->msg_count++;
+    }
+    portEXIT_CRITICAL(&tx->spinlock);
+    xTaskNotifyGive(tx->task);
+}
+
+/**
+ * @brief Read size received bytes into the line buffer and dispatch every complete line
+ * 
+ * @param port Port
+ * @param size Bytes available (from the UART event)
+ * @param t_event Time the event was received (us)
+ */
+static void uart_cmd_receive(uart_mcu_port_t port, size_t size, int64_t t_event){
+    uart_cmd_rx_t *rx = &uart_cmd[port];
+    uart_port_t uart_num = uart_mcu_num(port);
+    while(size > 0){
+        if(rx->fill == UART_CMD_LINE_MAX){
+            /* Line too long: drop it and skip up to the next delimiter */
+            if(!rx->discard){
+                rx->stats.overflows++;
+                rx->discard = true;
+            }
+            rx->fill = 0;
+        }
+        uint16_t n = UART_CMD_LINE_MAX - rx->fill;
+        if(n > size){
+            n = size;
+        }
+        int read = uart_read_bytes(uart_num, &rx->line[rx->fill], n, 0);
+        if(read <= 0){
+            break;
+        }
+        size -= read;
+        char *start = rx->line;
+        char *end = &rx->line[rx->fill + read];
+        char *p = &rx->line[rx->fill];
+        while((p = memchr(p, rx->delimiter, end - p)) != NULL){
+            if(rx->discard){
+                rx->discard = false;
+            }else{
+                uart_cmd_dispatch(rx, start, p - start, t_event);
             }
+            start = ++p;
+        }
+        rx->fill = end - start;
+        if(start != rx->line && rx->fill > 0){
+            memmove(rx->line, start, rx->fill);
         }
     }
 }
+
+/**
+ * @brief Find the handler of a complete line and call it
+ * 
+ * @param rx Dispatcher
+ * @param line Line, without delimiter (it is overwritten with '\0')
+ * @param len Line length
+ * @param t_event Time the event was received (us)
+ */
+static void uart_cmd_dispatch(uart_cmd_rx_t *rx, char *line, uint16_t len, int64_t t_event){
+    const uart_cmd_t *entry = NULL;
+    uint16_t name_len = 0;
+    if(rx->delimiter == '\n' && len > 0 && line[len - 1] == '\r'){
+        len--;
+    }
+    if(len == 0){
+        return;
+    }
+    line[len] = '\0';
+    while(name_len < len && line[name_len] != ' '){
+        name_len++;
+    }
+    for(uint8_t i = 0; i < rx->count; i++){
+        const char *name = rx->table[i].name;
+        if(name == NULL){
+            if(entry == NULL){
+                entry = &rx->table[i];
+            }
+        }else if(strncmp(name, line, name_len) == 0 && name[name_len] == '\0'){
+            entry = &rx->table[i];
+            break;
+        }
+    }
+    if(entry == NULL){
+        rx->stats.unknown++;
+        return;
+    }
+    if(entry->name != NULL){
+        /* Arguments start after the name and the spaces that follow it */
+        while(name_len < len && line[name_len] == ' '){
+            name_len++;
+        }
+        line += name_len;
+        len -= name_len;
+    }
+    uint32_t latency = esp_timer_get_time() - t_event;
+    rx->stats.last_latency_us = latency;
+    if(latency > rx->stats.max_latency_us){
+        rx->stats.max_latency_us = latency;
+    }
+    rx->stats.commands++;
+    entry->handler(line, len, entry->param);
+}
+
 /*==================[external functions definition]==========================*/
 
 void UartInit(serial_config_t *port_config){
+    uart_port_state_t *state = &uart_port[port_config->port];
+    uart_port_t uart_num = uart_mcu_num(port_config->port);
     uart_config_t uart_config = {
         .baud_rate = port_config->baud_rate,
         .data_bits = UART_DATA_8_BITS,
@@ -113,30 +467,27 @@ void UartInit(serial_config_t *port_config){
         .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
         .source_clk = UART_SCLK_DEFAULT,
     };
+    state->rx_buffer_size = port_config->rx_buffer_size ? port_config->rx_buffer_size : RX_BUFFER_SIZE;
+    state->tx_buffer_size = port_config->tx_buffer_size ? port_config->tx_buffer_size : TX_BUFFER_SIZE;
+    state->event_queue_size = port_config->event_queue_size ? port_config->event_queue_size : EVENT_QUEUE_SIZE;
+    memset(&state->stats, 0, sizeof(state->stats));
+    uart_param_config(uart_num, &uart_config);
     switch(port_config->port){
         case UART_PC:
-            uart_param_config(UART_NUM_0, &uart_config);
-            uart_set_pin(UART_NUM_0, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-            if(port_config->func_p != UART_NO_INT){
-                uart_pc_isr_p = port_config->func_p;
-                uart_pc_queue = port_config->param_p;
-                xTaskCreate(uart_pc_event_task, "uart_pc_event_task", 2048, NULL, 12, 0);
-            }else{
-                uart_driver_install(UART_NUM_0, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
-            }
+            uart_set_pin(uart_num, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
             break;
         case UART_CONNECTOR:
-            uart_param_config(UART_NUM_1, &uart_config);
-            uart_set_pin(UART_NUM_1, UART_CONN_TX, UART_CONN_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-            if(port_config->func_p != UART_NO_INT){
-                uart_conn_isr_p = port_config->func_p;
-                uart_conn_queue = port_config->param_p;
-                xTaskCreate(uart_conn_event_task, "uart_conn_event_task", 2048, NULL, 12, NULL);
-            }else{
-                uart_driver_install(UART_NUM_1, RX_BUFFER_SIZE, TX_BUFFER_SIZE, 0, NULL, 0);
-            }
+            uart_set_pin(uart_num, UART_CONN_TX, UART_CONN_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
             break;
     }
+    if(port_config->func_p != UART_NO_INT){
+        state->isr_p = port_config->func_p;
+        state->user_data = port_config->param_p;
+        xTaskCreate(uart_event_task, "uart_event_task", EVENT_TASK_STACK, (void*)(uintptr_t)port_config->port, EVENT_TASK_PRIO, NULL);
+        state->event_task_on = true;
+    }else{
+        uart_driver_install(uart_num, state->rx_buffer_size, state->tx_buffer_size, 0, NULL, 0);
+    }
 }
 
 uint8_t UartReadByte(uart_mcu_port_t port, uint8_t* data){
@@ -200,10 +551,11 @@ void UartSendString(uart_mcu_port_t port, const char *msg){
                 uart_num = UART_NUM_1;
             break;
     }
-	while(*msg != 0){
-        uart_tx_chars(uart_num, msg, 1);
-		msg++;
-	}
+    if(uart_tx[port].enabled){
+        UartTxString(port, msg);
+    }else{
+        uart_write_bytes(uart_num, msg, strlen(msg));
+    }
 }
 
 void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes){
@@ -219,17 +571,216 @@ void UartSendBuffer(uart_mcu_port_t port, const char *data, uint8_t nbytes){
     uart_tx_chars(uart_num, data, nbytes);
 }
 
-uint8_t* UartItoa(uint32_t val, uint8_t base){
-	static uint8_t buf[32] = {0};
-	uint32_t i = 30;
-    if(val == 0){
-        return (uint8_t*)"0";
-    }else{
-        for(; val && i ; --i, val /= base){
-            buf[i] = "0123456789abcdef"[val % base];
+void UartTxInit(uart_mcu_port_t port, uart_tx_policy_t policy){
+    uart_tx_t *tx = &uart_tx[port];
+    tx->policy = policy;
+    tx->dropped = 0;
+    if(tx->enabled){
+        return;
+    }
+    tx->head = 0;
+    tx->rd = 0;
+    tx->free = 0;
+    tx->msg_first = 0;
+    tx->msg_count = 0;
+    portMUX_INITIALIZE(&tx->spinlock);
+    tx->writer = xSemaphoreCreateMutex();
+    tx->space = xSemaphoreCreateBinary();
+    xTaskCreate(uart_tx_task, "uart_tx_task", UART_TX_TASK_STACK, (void*)(uintptr_t)port, UART_TX_TASK_PRIO, &tx->task);
+    tx->enabled = true;
+}
+
+bool UartTxPrintf(uart_mcu_port_t port, const char *fmt, ...){
+    uart_tx_t *tx = &uart_tx[port];
+    va_list args;
+    xSemaphoreTake(tx->writer, portMAX_DELAY);
+    /* Format in place in the free space (a message can run past the ring end) */
+    portENTER_CRITICAL(&tx->spinlock);
+    uint32_t avail = UART_TX_RING_SIZE - (tx->head - tx->free);
+    portEXIT_CRITICAL(&tx->spinlock);
+    if(avail > UART_TX_MSG_MAX){
+        avail = UART_TX_MSG_MAX;
+    }
+    va_start(args, fmt);
+    int len = vsnprintf(&tx->buf[tx->head & UART_TX_MASK], avail, fmt, args);
+    va_end(args);
+    if(len < 0){
+        xSemaphoreGive(tx->writer);
+        return false;
+    }
+    if((uint32_t)len >= avail){
+        /* Did not fit: apply the overflow policy and format again */
+        if(len >= UART_TX_MSG_MAX){
+            len = UART_TX_MSG_MAX - 1;
+        }
+        if(!uart_tx_space(tx, len + 1)){
+            xSemaphoreGive(tx->writer);
+            return false;
+        }
+        va_start(args, fmt);
+        vsnprintf(&tx->buf[tx->head & UART_TX_MASK], len + 1, fmt, args);
+        va_end(args);
+    }
+    uint32_t pos = tx->head & UART_TX_MASK;
+    if(pos + len > UART_TX_RING_SIZE){
+        /* Move the part written past the end to the start of the ring */
+        memcpy(tx->buf, &tx->buf[UART_TX_RING_SIZE], pos + len - UART_TX_RING_SIZE);
+    }
+    uart_tx_commit(tx, len);
+    xSemaphoreGive(tx->writer);
+    return true;
+}
+
+bool UartTxString(uart_mcu_port_t port, const char *msg){
+    return UartTxBuffer(port, msg, strlen(msg));
+}
+
+bool UartTxBuffer(uart_mcu_port_t port, const void *data, uint16_t nbytes){
+    uart_tx_t *tx = &uart_tx[port];
+    xSemaphoreTake(tx->writer, portMAX_DELAY);
+    if(!uart_tx_space(tx, nbytes)){
+        xSemaphoreGive(tx->writer);
+        return false;
+    }
+    uint32_t pos = tx->head & UART_TX_MASK;
+    uint32_t first = UART_TX_RING_SIZE - pos;
+    if(first > nbytes){
+        first = nbytes;
+    }
+    memcpy(&tx->buf[pos], data, first);
+    memcpy(tx->buf, (const uint8_t*)data + first, nbytes - first);
+    uart_tx_commit(tx, nbytes);
+    xSemaphoreGive(tx->writer);
+    return true;
+}
+
+uint16_t UartTxPending(uart_mcu_port_t port){
+    uart_tx_t *tx = &uart_tx[port];
+    return tx->head - tx->rd;
+}
+
+bool UartTxFlush(uart_mcu_port_t port, uint32_t timeout_ms){
+    uart_tx_t *tx = &uart_tx[port];
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(timeout_ms);
+    while(1){
+        portENTER_CRITICAL(&tx->spinlock);
+        bool done = (tx->free == tx->head);
+        portEXIT_CRITICAL(&tx->spinlock);
+        if(done){
+            break;
+        }
+        if(xTaskGetTickCount() - start >= timeout){
+            return false;
         }
-        return &buf[i+1];
+        vTaskDelay(1);
+    }
+    TickType_t elapsed = xTaskGetTickCount() - start;
+    return uart_wait_tx_done(uart_mcu_num(port), (elapsed < timeout) ? timeout - elapsed : 0) == ESP_OK;
+}
+
+uint32_t UartTxDropped(uart_mcu_port_t port){
+    return uart_tx[port].dropped;
+}
+
+uint16_t UartCrc16(uint16_t crc, const uint8_t *data, uint16_t len){
+    while(len--){
+        crc = (crc << 8) ^ uart_crc16_table[(crc >> 8) ^ *data++];
     }
+    return crc;
+}
+
+uint16_t UartCobsEncode(const uint8_t *src, uint16_t len, uint8_t *dst){
+    uint16_t code_pos = 0;
+    uint16_t out = 1;
+    uint8_t code = 1;
+    for(uint16_t i = 0; i < len; i++){
+        if(src[i] == 0){
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }else{
+            dst[out++] = src[i];
+            if(++code == 0xFF){
+                dst[code_pos] = code;
+                code_pos = out++;
+                code = 1;
+            }
+        }
+    }
+    dst[code_pos] = code;
+    return out;
+}
+
+bool UartTelemetrySend(uart_mcu_port_t port, uint8_t channel, uint32_t timestamp, const int16_t *samples, uint8_t count){
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    uint8_t encoded[TELEMETRY_MAX_FRAME + 3];
+    if(count > UART_TELEMETRY_MAX_SAMPLES){
+        count = UART_TELEMETRY_MAX_SAMPLES;
+    }
+    uint16_t seq = uart_telemetry_seq[port]++;
+    frame[0] = channel;
+    frame[1] = seq & 0xFF;
+    frame[2] = seq >> 8;
+    frame[3] = timestamp & 0xFF;
+    frame[4] = (timestamp >> 8) & 0xFF;
+    frame[5] = (timestamp >> 16) & 0xFF;
+    frame[6] = timestamp >> 24;
+    frame[7] = count;
+    uint16_t len = TELEMETRY_HEADER;
+    for(uint8_t i = 0; i < count; i++){
+        frame[len++] = samples[i] & 0xFF;
+        frame[len++] = (uint16_t)samples[i] >> 8;
+    }
+    uint16_t crc = UartCrc16(0xFFFF, frame, len);
+    frame[len++] = crc & 0xFF;
+    frame[len++] = crc >> 8;
+    len = UartCobsEncode(frame, len, encoded);
+    encoded[len++] = 0;
+    if(uart_tx[port].enabled){
+        return UartTxBuffer(port, encoded, len);
+    }
+    uart_write_bytes(uart_mcu_num(port), encoded, len);
+    return true;
+}
+
+void UartCmdInit(uart_mcu_port_t port, const uart_cmd_t *table, uint8_t count, char delimiter){
+    uart_cmd_rx_t *rx = &uart_cmd[port];
+    rx->table = NULL;
+    rx->count = count;
+    rx->delimiter = delimiter;
+    rx->fill = 0;
+    rx->discard = false;
+    memset(&rx->stats, 0, sizeof(rx->stats));
+    rx->table = table;
+    if(!uart_port[port].event_task_on){
+        /* Installed without event queue: reinstall it from the event task */
+        uart_driver_delete(uart_mcu_num(port));
+        xTaskCreate(uart_event_task, "uart_event_task", EVENT_TASK_STACK, (void*)(uintptr_t)port, EVENT_TASK_PRIO, NULL);
+        uart_port[port].event_task_on = true;
+    }
+}
+
+void UartCmdStats(uart_mcu_port_t port, uart_cmd_stats_t *stats){
+    *stats = uart_cmd[port].stats;
+}
+
+void UartGetStats(uart_mcu_port_t port, uart_stats_t *stats){
+    *stats = uart_port[port].stats;
+    size_t size = 0;
+    uart_get_tx_buffer_free_size(uart_mcu_num(port), &size);
+    stats->tx_free = size;
+}
+
+void UartResetStats(uart_mcu_port_t port){
+    memset(&uart_port[port].stats, 0, sizeof(uart_stats_t));
+}
+
+uint8_t* UartItoa(uint32_t val, uint8_t base){
+    /* Shared by every caller, so UartItoa() is not reentrant (FmtUint() is) */
+    static char buf[FMT_BUF_SIZE];
+    FmtUint(buf, val, base, 0, 0);
+    return (uint8_t*)buf;
 }
 
 /*==================[end of file]============================================*/
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef FMT_H
+#define FMT_H
+/** \addtogroup Drivers_Programable Drivers Programable
+ ** @{ */
+/** \addtogroup Drivers_Utils Drivers utils
+ ** @{ */
+/** \addtogroup Fmt Number formatting
+ ** @{ */
+
+/** \brief Reentrant number formatting without printf.
+ *
+ * Converts integers (any base from 2 to 36, with minimum width and padding), 
+ * fixed point and float values (without newlib's float printf, which is 
+ * large and slow on the FPU-less ESP32-C6) and binary data (hex) to text. 
+ * All functions write into a buffer given by the caller and keep no state, 
+ * so they can be used from several tasks at the same time. Decimal 
+ * conversion produces two digits per division using a digit pair table.
+ * 
+ * Every function ends the text with '\0' and returns its length.
+ * 
+ * Example:
+ * @code
+ * char msg[FMT_BUF_SIZE];
+ * FmtFixed(msg, temperature_centi, 2);	// 2534 -> "25.34"
+ * UartSendString(UART_PC, msg);
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * | 19/10/2026 | Exact FmtFloat() digits, host test against snprintf					|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#define FMT_MAX_WIDTH		32		/*!< Largest minimum width (longer widths are limited) */
+#define FMT_BUF_SIZE		(FMT_MAX_WIDTH + 2)	/*!< Buffer size that fits any single number (sign, digits, '\0') */
+#define FMT_MAX_DECIMALS	9		/*!< Most decimals for fixed point and float values */
+#define FMT_HEXDUMP_LINE	80		/*!< Buffer size for FmtHexDumpLine() */
+/*==================[typedef]================================================*/
+
+/*==================[external data declaration]==============================*/
+
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Unsigned integer to text
+ * 
+ * @param buf Output (FMT_BUF_SIZE chars)
+ * @param val Value
+ * @param base Base (2 to 36)
+ * @param width Minimum width (0: no padding)
+ * @param pad Padding character (e.g. '0' or ' ')
+ * @return uint8_t Length
+ */
+uint8_t FmtUint(char *buf, uint32_t val, uint8_t base, uint8_t width, char pad);
+
+/**
+ * @brief Signed integer to text. With '0' padding the sign goes before the zeros.
+ * 
+ * @param buf Output (FMT_BUF_SIZE chars)
+ * @param val Value
+ * @param base Base (2 to 36)
+ * @param width Minimum width, sign included (0: no padding)
+ * @param pad Padding character (e.g. '0' or ' ')
+ * @return uint8_t Length
+ */
+uint8_t FmtInt(char *buf, int32_t val, uint8_t base, uint8_t width, char pad);
+
+/**
+ * @brief Fixed point value to text (e.g. 2534 with 2 decimals -> "25.34")
+ * 
+ * @param buf Output (FMT_BUF_SIZE chars)
+ * @param val Value multiplied by 10^decimals
+ * @param decimals Number of decimals (up to FMT_MAX_DECIMALS)
+ * @return uint8_t Length
+ */
+uint8_t FmtFixed(char *buf, int32_t val, uint8_t decimals);
+
+/**
+ * @brief Float to text, with the same digits as printf("%.*f"). Integer part 
+ * and decimals are taken from the float bits with integer arithmetic, so every 
+ * digit is exact and rounding is half to even on the exact value.
+ * 
+ * @param buf Output (FMT_BUF_SIZE chars)
+ * @param val Value, integer part of |val| must fit 32 bits ("ovf" otherwise)
+ * @param decimals Number of decimals (up to FMT_MAX_DECIMALS)
+ * @return uint8_t Length
+ */
+uint8_t FmtFloat(char *buf, float val, uint8_t decimals);
+
+/**
+ * @brief Bytes to hexadecimal text ("0a 1b ff"), truncated to fit the buffer
+ * 
+ * @param buf Output
+ * @param size Output size
+ * @param data Bytes
+ * @param len Number of bytes
+ * @param sep Separator between bytes ('\0': none)
+ * @return uint16_t Length
+ */
+uint16_t FmtHex(char *buf, uint16_t size, const uint8_t *data, uint16_t len, char sep);
+
+/**
+ * @brief One hex dump line: offset, up to 16 bytes and their printable characters
+ * ("00000010  48 6f 6c 61 ...  |Hola...|")
+ * 
+ * @param buf Output (FMT_HEXDUMP_LINE chars)
+ * @param offset Offset shown at the start of the line
+ * @param data Bytes
+ * @param len Number of bytes (up to 16)
+ * @return uint8_t Length
+ */
+uint8_t FmtHexDumpLine(char *buf, uint32_t offset, const uint8_t *data, uint8_t len);
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+#endif /* #ifndef FMT_H */
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,253 @@
+/**
+ * @file fmt.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "fmt.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define FMT_DIGITS_MAX		32		/*!< Digits of the largest value (base 2) */
+#define FMT_FLOAT_MANT_BITS	23		/*!< Stored mantissa bits of a float */
+#define FMT_FLOAT_BIAS		127		/*!< Exponent bias of a float */
+/*==================[internal data declaration]==============================*/
+
+/*==================[internal functions declaration]=========================*/
+static uint8_t fmt_digits(char *end, uint32_t val, uint8_t base);
+/*==================[internal data definition]===============================*/
+static const char fmt_pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";	/*!< "00" to "99" */
+static const char fmt_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+static const uint32_t fmt_pow10[FMT_MAX_DECIMALS + 1] = {
+	1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+/*==================[external data definition]===============================*/
+
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Write the digits of val backwards, ending just before end
+ * 
+ * @return uint8_t Number of digits
+ */
+static uint8_t fmt_digits(char *end, uint32_t val, uint8_t base){
+	char *p = end;
+	if(base == 10){
+		while(val >= 100){
+			uint32_t q = val / 100;
+			uint32_t r = val - q * 100;
+			p -= 2;
+			p[0] = fmt_pairs[2 * r];
+			p[1] = fmt_pairs[2 * r + 1];
+			val = q;
+		}
+		if(val >= 10){
+			p -= 2;
+			p[0] = fmt_pairs[2 * val];
+			p[1] = fmt_pairs[2 * val + 1];
+		}
+		else{
+			*--p = '0' + val;
+		}
+	}
+	else if(base == 16){
+		do{
+			*--p = fmt_chars[val & 0xF];
+			val >>= 4;
+		} while(val != 0);
+	}
+	else{
+		if(base < 2 || base > 36){
+			base = 10;
+		}
+		do{
+			*--p = fmt_chars[val % base];
+			val /= base;
+		} while(val != 0);
+	}
+	return end - p;
+}
+
+/*==================[external functions definition]==========================*/
+uint8_t FmtUint(char *buf, uint32_t val, uint8_t base, uint8_t width, char pad){
+	char tmp[FMT_DIGITS_MAX];
+	uint8_t len = fmt_digits(&tmp[FMT_DIGITS_MAX], val, base);
+	uint8_t n = 0;
+	if(width > FMT_MAX_WIDTH){
+		width = FMT_MAX_WIDTH;
+	}
+	while(n + len < width){
+		buf[n++] = pad;
+	}
+	memcpy(&buf[n], &tmp[FMT_DIGITS_MAX - len], len);
+	n += len;
+	buf[n] = '\0';
+	return n;
+}
+
+uint8_t FmtInt(char *buf, int32_t val, uint8_t base, uint8_t width, char pad){
+	if(val >= 0){
+		return FmtUint(buf, val, base, width, pad);
+	}
+	uint32_t mag = -(uint32_t)val;
+	if(pad == '0' || width == 0){
+		buf[0] = '-';
+		return 1 + FmtUint(&buf[1], mag, base, (width > 0) ? width - 1 : 0, pad);
+	}
+	/* Padding goes before the sign */
+	char tmp[FMT_DIGITS_MAX];
+	uint8_t len = fmt_digits(&tmp[FMT_DIGITS_MAX], mag, base);
+	uint8_t n = 0;
+	if(width > FMT_MAX_WIDTH){
+		width = FMT_MAX_WIDTH;
+	}
+	while(n + len + 1 < width){
+		buf[n++] = pad;
+	}
+	buf[n++] = '-';
+	memcpy(&buf[n], &tmp[FMT_DIGITS_MAX - len], len);
+	n += len;
+	buf[n] = '\0';
+	return n;
+}
+
+uint8_t FmtFixed(char *buf, int32_t val, uint8_t decimals){
+	uint8_t n = 0;
+	if(decimals > FMT_MAX_DECIMALS){
+		decimals = FMT_MAX_DECIMALS;
+	}
+	uint32_t mag = val;
+	if(val < 0){
+		buf[n++] = '-';
+		mag = -(uint32_t)val;
+	}
+	uint32_t ip = mag / fmt_pow10[decimals];
+	n += FmtUint(&buf[n], ip, 10, 0, 0);
+	if(decimals > 0){
+		buf[n++] = '.';
+		n += FmtUint(&buf[n], mag - ip * fmt_pow10[decimals], 10, decimals, '0');
+	}
+	return n;
+}
+
+uint8_t FmtFloat(char *buf, float val, uint8_t decimals){
+	uint32_t bits;
+	uint8_t n = 0;
+	if(decimals > FMT_MAX_DECIMALS){
+		decimals = FMT_MAX_DECIMALS;
+	}
+	memcpy(&bits, &val, sizeof(bits));
+	int16_t exp = (bits >> FMT_FLOAT_MANT_BITS) & 0xFF;
+	uint32_t mant = bits & ((1UL << FMT_FLOAT_MANT_BITS) - 1);
+	if(exp == 0xFF && mant != 0){
+		memcpy(buf, "nan", 4);
+		return 3;
+	}
+	/* |val| = mant * 2^-shift, exactly */
+	if(exp == 0){
+		exp = 1;
+	}
+	else{
+		mant |= 1UL << FMT_FLOAT_MANT_BITS;
+	}
+	int16_t shift = FMT_FLOAT_BIAS + FMT_FLOAT_MANT_BITS - exp;
+	if(shift < FMT_FLOAT_MANT_BITS + 1 - 32){
+		/* Integer part above 32 bits (or infinite) */
+		memcpy(buf, "ovf", 4);
+		return 3;
+	}
+	uint32_t ip;
+	uint32_t fp = 0;
+	if(shift <= 0){
+		ip = mant << -shift;
+	}
+	else{
+		/* Fraction scaled by 10^decimals, rounded half to even like printf */
+		uint64_t frac = (shift < 32) ? (mant & ((1UL << shift) - 1)) : mant;
+		ip = (shift < 32) ? (mant >> shift) : 0;
+		frac *= fmt_pow10[decimals];
+		if(shift < 64){
+			uint64_t half = 1ULL << (shift - 1);
+			uint64_t rem = frac & ((half << 1) - 1);
+			fp = frac >> shift;
+			/* Ties go to the even last digit (of ip if there are no decimals) */
+			if(rem > half || (rem == half && (((decimals > 0) ? fp : ip) & 1))){
+				fp++;
+			}
+		}
+		if(fp == fmt_pow10[decimals]){
+			fp = 0;
+			if(++ip == 0){
+				memcpy(buf, "ovf", 4);
+				return 3;
+			}
+		}
+	}
+	if(bits >> 31){
+		buf[n++] = '-';
+	}
+	n += FmtUint(&buf[n], ip, 10, 0, 0);
+	if(decimals > 0){
+		buf[n++] = '.';
+		n += FmtUint(&buf[n], fp, 10, decimals, '0');
+	}
+	return n;
+}
+
+uint16_t FmtHex(char *buf, uint16_t size, const uint8_t *data, uint16_t len, char sep){
+	uint16_t n = 0;
+	if(size == 0){
+		return 0;
+	}
+	for(uint16_t i = 0; i < len; i++){
+		uint8_t sep_len = (i > 0 && sep != '\0') ? 1 : 0;
+		if(n + sep_len + 2 >= size){
+			break;
+		}
+		if(sep_len){
+			buf[n++] = sep;
+		}
+		buf[n++] = fmt_chars[data[i] >> 4];
+		buf[n++] = fmt_chars[data[i] & 0xF];
+	}
+	buf[n] = '\0';
+	return n;
+}
+
+uint8_t FmtHexDumpLine(char *buf, uint32_t offset, const uint8_t *data, uint8_t len){
+	uint8_t n;
+	if(len > 16){
+		len = 16;
+	}
+	n = FmtUint(buf, offset, 16, 8, '0');
+	buf[n++] = ' ';
+	for(uint8_t i = 0; i < 16; i++){
+		buf[n++] = ' ';
+		if(i < len){
+			buf[n++] = fmt_chars[data[i] >> 4];
+			buf[n++] = fmt_chars[data[i] & 0xF];
+		}
+		else{
+			buf[n++] = ' ';
+			buf[n++] = ' ';
+		}
+	}
+	buf[n++] = ' ';
+	buf[n++] = ' ';
+	buf[n++] = '|';
+	for(uint8_t i = 0; i < len; i++){
+		buf[n++] = (data[i] >= 0x20 && data[i] < 0x7F) ? data[i] : '.';
+	}
+	buf[n++] = '|';
+	buf[n] = '\0';
+	return n;
+}
+
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/** @} doxygen end group definition */
+/*==================[end of file]============================================*/
@@ -0,0 +1,500 @@
+/**
+ * @file bench.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host micro-benchmarks of the drivers hot paths. Runs each API against
+ * the mocked ESP-IDF (see mock.h) and reports, per call: host CPU time (also
+ * per item: sample, pixel, message...), virtual time spent waiting (delays,
+ * timeouts and the UART line), peripheral driver calls and bytes moved over
+ * the bus, in total and per peripheral.
+ *
+ * CPU time is the host's, so compare it between builds and between benches,
+ * not with the target. Calls, bytes and virtual time are exact: they are what
+ * the target would do.
+ *
+ * Build: cmake -S firmware/tools/host_bench -B build && cmake --build build
+ * Usage: host_bench [api name filter [iterations]]
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "driver/uart.h"
+#include "ili9341.h"
+#include "neopixel_stripe.h"
+#include "mpu6050.h"
+#include "i2c_mcu.h"
+#include "uart_mcu.h"
+#include "delay_mcu.h"
+#include "soft_timer_mcu.h"
+#include "driver/gptimer.h"
+#include "dsp_filter.h"
+#include "dsp_fft.h"
+#include "dsp_goertzel.h"
+#include "fmt.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/*==================[macros and definitions]=================================*/
+#define LEDS_QTY	16			/* NeoPixel stripe length */
+#define I2C_HZ		400000		/* I2C clock */
+#define DSP_BLOCK	256			/* Samples per DSP call (an ADC block) */
+#define FIR_TAPS	32			/* FIR length */
+#define BQ_STAGES	2			/* Cascaded biquads (4th order) */
+#define FFT_FS		1000		/* FFT sample frequency (Hz) */
+#define FMT_VALUES	64			/* Values formatted per call */
+#define CMD_BATCH	8			/* Command lines per UART event (batched bench) */
+#define TLM_SAMPLES	UART_TELEMETRY_MAX_SAMPLES	/* Samples per telemetry frame */
+
+typedef struct {
+	const char *name;
+	void (*setup)(void);
+	void (*run)(void);
+	uint32_t iterations;
+	uint32_t items;			/* Items processed per call (0: 1) */
+} bench_t;
+/*==================[internal data definition]===============================*/
+static neopixel_color_t leds[LEDS_QTY];
+static int16_t ax, ay, az, gx, gy, gz;
+static q15_t dsp_in[DSP_BLOCK];
+static q15_t dsp_out[DSP_BLOCK];
+static q31_t dsp_in31[DSP_BLOCK];
+static q31_t dsp_out31[DSP_BLOCK];
+static q15_t fir_coeffs[FIR_TAPS];
+static q31_t fir_coeffs31[FIR_TAPS];
+static q15_t fir_state[2 * FIR_TAPS];
+static q31_t fir_state31[2 * FIR_TAPS];
+static dsp_fir_q15_t fir;
+static dsp_fir_q31_t fir31;
+static dsp_biquad_coeffs_t bq_coeffs[BQ_STAGES];
+static dsp_biquad_state_t bq_state[BQ_STAGES];
+static dsp_biquad_t bq;
+static dsp_dc_block_t dc;
+static q15_t fft_in[DSP_FFT_MAX_SIZE];
+static dsp_cq31_t fft_buf[DSP_FFT_MAX_SIZE];
+static uint32_t fft_mag[DSP_FFT_MAX_SIZE / 2];
+static dsp_fft_t fft;
+static dsp_goertzel_t goertzel;
+static int16_t tlm_samples[TLM_SAMPLES];
+static uint32_t tx_count;
+static int32_t fmt_ints[FMT_VALUES];
+static float fmt_floats[FMT_VALUES];
+static char fmt_buf[FMT_BUF_SIZE];
+static uint32_t cmd_hits;
+/*==================[internal functions definition]==========================*/
+static void ili9341_setup(void){
+	ILI9341Init(SPI_1, GPIO_9, GPIO_18);
+	ILI9341Rotate(ILI9341_Landscape_1);
+}
+
+static void ili9341_fill(void){
+	ILI9341Fill(ILI9341_DARKCYAN);
+}
+
+static void neopixel_setup(void){
+	NeoPixelInit(GPIO_8, LEDS_QTY, leds);
+	for(uint16_t i = 0; i < LEDS_QTY; i++){
+		leds[i] = (i & 1) ? NEOPIXEL_COLOR_TURQUOISE : NEOPIXEL_COLOR_ORANGE;
+	}
+}
+
+static void neopixel_set_array(void){
+	NeoPixelSetArray(leds);
+}
+
+static void mpu6050_setup(void){
+	I2C_initialize(I2C_HZ);
+	MPU6050_initialize();
+}
+
+static void mpu6050_get_motion6(void){
+	MPU6050_getMotion6(&ax, &ay, &az, &gx, &gy, &gz);
+}
+
+static void uart_setup(void){
+	serial_config_t port = {
+		.port = UART_PC,
+		.baud_rate = 115200,
+		.func_p = UART_NO_INT,
+		.param_p = NULL,
+	};
+	UartInit(&port);
+}
+
+static void uart_send_string(void){
+	UartSendString(UART_PC, "temperatura: 25.3 C\r\n");
+}
+
+/* Delays: wait_us/call is the delay actually waited, calls/call its overhead */
+static void delay_setup(void){
+	SoftTimerInit();
+}
+
+static void delay_us_20(void){
+	DelayUs(20);
+}
+
+static void delay_us_100(void){
+	DelayUs(100);
+}
+
+static void delay_ms_1(void){
+	DelayMs(1);
+}
+
+static bool delay_reference_isr(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *user_data){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	gptimer_stop(timer);
+	vTaskNotifyGiveFromISR((TaskHandle_t)user_data, &xHigherPriorityTaskWoken);
+	return (xHigherPriorityTaskWoken == pdTRUE);
+}
+
+/* Reference: the former DelayUs(), a gptimer created and deleted per call */
+static void delay_us_100_reference(void){
+	gptimer_handle_t timer = NULL;
+	gptimer_config_t timer_config = {
+		.clk_src = GPTIMER_CLK_SRC_DEFAULT,
+		.direction = GPTIMER_COUNT_UP,
+		.resolution_hz = 1000000,
+	};
+	gptimer_new_timer(&timer_config, &timer);
+	gptimer_event_callbacks_t alarm = {
+		.on_alarm = delay_reference_isr,
+	};
+	gptimer_register_event_callbacks(timer, &alarm, xTaskGetCurrentTaskHandle());
+	gptimer_enable(timer);
+	gptimer_alarm_config_t alarm_config = {
+		.alarm_count = 100,
+	};
+	gptimer_set_alarm_action(timer, &alarm_config);
+	gptimer_start(timer);
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	gptimer_disable(timer);
+	gptimer_del_timer(timer);
+}
+
+/* Sensor like values of every magnitude and sign */
+static void fmt_setup(void){
+	uint32_t seed = 1;
+	for(uint8_t i = 0; i < FMT_VALUES; i++){
+		seed = seed * 1664525u + 1013904223u;
+		fmt_ints[i] = (int32_t)seed >> (i % 31);
+		fmt_floats[i] = fmt_ints[i] / 1000.0f;
+	}
+}
+
+static void fmt_int(void){
+	for(uint8_t i = 0; i < FMT_VALUES; i++){
+		FmtInt(fmt_buf, fmt_ints[i], 10, 0, ' ');
+	}
+}
+
+static void snprintf_int(void){
+	for(uint8_t i = 0; i < FMT_VALUES; i++){
+		snprintf(fmt_buf, sizeof(fmt_buf), "%ld", (long)fmt_ints[i]);
+	}
+}
+
+static void fmt_float(void){
+	for(uint8_t i = 0; i < FMT_VALUES; i++){
+		FmtFloat(fmt_buf, fmt_floats[i], 2);
+	}
+}
+
+static void snprintf_float(void){
+	for(uint8_t i = 0; i < FMT_VALUES; i++){
+		snprintf(fmt_buf, sizeof(fmt_buf), "%.2f", (double)fmt_floats[i]);
+	}
+}
+
+/* Buffered transmitter on the connector port, writers wait for room: once the
+ring is full, wait_us/call is the line time of a message */
+static void uart_tx_setup(uint32_t baud_rate){
+	serial_config_t port = {
+		.port = UART_CONNECTOR,
+		.baud_rate = baud_rate,
+		.func_p = UART_NO_INT,
+		.param_p = NULL,
+	};
+	UartInit(&port);
+	UartTxInit(UART_CONNECTOR, UART_TX_BLOCK);
+	tx_count = 0;
+	for(uint8_t i = 0; i < TLM_SAMPLES; i++){
+		tlm_samples[i] = (int16_t)(1000 * sinf(2 * (float)M_PI * i / TLM_SAMPLES));
+	}
+}
+
+static void uart_tx_115200_setup(void){
+	uart_tx_setup(115200);
+}
+
+static void uart_tx_921600_setup(void){
+	uart_tx_setup(921600);
+}
+
+static void uart_tx_string(void){
+	UartTxString(UART_CONNECTOR, "temperatura: 25.3 C\r\n");
+}
+
+static void uart_tx_printf(void){
+	UartTxPrintf(UART_CONNECTOR, "t %lu: %d.%d C\r\n", (unsigned long)tx_count++, 25, 3);
+}
+
+static void uart_telemetry_send(void){
+	UartTelemetrySend(UART_CONNECTOR, 0, tx_count++, tlm_samples, TLM_SAMPLES);
+}
+
+static void cmd_handler(const char *args, uint16_t len, void *param){
+	cmd_hits++;
+}
+
+/* Dispatcher on the connector port, the matching entry is the last one */
+static void uart_cmd_setup(void){
+	static const uart_cmd_t cmds[] = {
+		{"start", cmd_handler, NULL},
+		{"stop", cmd_handler, NULL},
+		{"rate", cmd_handler, NULL},
+		{"led", cmd_handler, NULL},
+	};
+	serial_config_t port = {
+		.port = UART_CONNECTOR,
+		.baud_rate = 115200,
+		.func_p = UART_NO_INT,
+		.param_p = NULL,
+	};
+	static bool cmd_on;
+	/* The port keeps its event task: initialize it only once */
+	if(!cmd_on){
+		UartInit(&port);
+		cmd_on = true;
+	}
+	UartCmdInit(UART_CONNECTOR, cmds, sizeof(cmds) / sizeof(cmds[0]), '\n');
+	/* Let the event task install the driver before data arrives */
+	MockRunTasks();
+}
+
+/* One line per UART event, run until the event task has dispatched it */
+static void uart_cmd_line(void){
+	MockUartReceive(UART_NUM_1, "led on 3\r\n", 10);
+	MockRunTasks();
+}
+
+/* Several lines in one UART event, as when the task falls behind */
+static void uart_cmd_batch(void){
+	static const char lines[] = "led on 3\r\nled on 3\r\nled on 3\r\nled on 3\r\n"
+		"led on 3\r\nled on 3\r\nled on 3\r\nled on 3\r\n";
+	MockUartReceive(UART_NUM_1, lines, sizeof(lines) - 1);
+	MockRunTasks();
+}
+
+/* Two tones and a DC offset, like a block of ADC samples */
+static void dsp_signal(void){
+	for(uint16_t i = 0; i < DSP_BLOCK; i++){
+		float x = 0.1f + 0.4f * sinf(2 * (float)M_PI * 5 * i / DSP_BLOCK) + 0.2f * sinf(2 * (float)M_PI * 60 * i / DSP_BLOCK);
+		dsp_in[i] = Q15(x);
+		dsp_in31[i] = (q31_t)dsp_in[i] << 16;
+	}
+}
+
+/* Windowed sinc low-pass at fs/8 */
+static void fir_setup(void){
+	dsp_signal();
+	for(uint16_t k = 0; k < FIR_TAPS; k++){
+		float m = k - (FIR_TAPS - 1) / 2.0f;
+		float h = (m == 0) ? 0.25f : sinf((float)M_PI * 0.25f * m) / ((float)M_PI * m);
+		h *= 0.54f - 0.46f * cosf(2 * (float)M_PI * k / (FIR_TAPS - 1));
+		fir_coeffs[k] = Q15(h);
+		fir_coeffs31[k] = (q31_t)fir_coeffs[k] << 16;
+	}
+	DspFirQ15Init(&fir, fir_coeffs, FIR_TAPS, fir_state);
+	DspFirQ31Init(&fir31, fir_coeffs31, FIR_TAPS, fir_state31);
+}
+
+static void fir_q15(void){
+	DspFirQ15(&fir, dsp_in, dsp_out, DSP_BLOCK);
+}
+
+/* Reference: textbook circular delay line with a modulo per tap */
+static void fir_q15_reference(void){
+	static q15_t line[FIR_TAPS];
+	static uint16_t pos;
+	for(uint16_t i = 0; i < DSP_BLOCK; i++){
+		int32_t acc = 0;
+		line[pos] = dsp_in[i];
+		for(uint16_t k = 0; k < FIR_TAPS; k++){
+			acc += (int32_t)fir_coeffs[k] * line[(pos + FIR_TAPS - k) % FIR_TAPS];
+		}
+		pos = (pos + 1) % FIR_TAPS;
+		dsp_out[i] = DspSat16(acc >> 15);
+	}
+}
+
+static void fir_q31(void){
+	DspFirQ31(&fir31, dsp_in31, dsp_out31, DSP_BLOCK);
+}
+
+/* 4th order: 0.5Hz high-pass and 40Hz low-pass at 1kHz */
+static void biquad_setup(void){
+	dsp_signal();
+	DspBiquadHighpass(&bq_coeffs[0], 0.5f, 1000, 0.7071f);
+	DspBiquadLowpass(&bq_coeffs[1], 40, 1000, 0.7071f);
+	DspBiquadInit(&bq, bq_coeffs, BQ_STAGES, bq_state);
+}
+
+static void biquad_q15(void){
+	DspBiquadQ15(&bq, dsp_in, dsp_out, DSP_BLOCK);
+}
+
+static void biquad_q31(void){
+	DspBiquadQ31(&bq, dsp_in31, dsp_out31, DSP_BLOCK);
+}
+
+static void dc_block_setup(void){
+	dsp_signal();
+	DspDcBlockInit(&dc, Q15(0.995));
+}
+
+static void dc_block_q15(void){
+	DspDcBlockQ15(&dc, dsp_in, dsp_out, DSP_BLOCK);
+}
+
+/* 50Hz tone and noise, as many samples as the largest FFT */
+static void fft_signal(uint16_t n){
+	uint32_t seed = 1;
+	for(uint16_t i = 0; i < DSP_FFT_MAX_SIZE; i++){
+		seed = seed * 1664525u + 1013904223u;
+		fft_in[i] = Q15(0.5f * sinf(2 * (float)M_PI * 50 * i / FFT_FS)) + (int16_t)(seed >> 16) / 64;
+	}
+	DspFftInit(&fft, n, DSP_WINDOW_HANN);
+}
+
+static void fft_256_setup(void){
+	fft_signal(256);
+}
+
+static void fft_1024_setup(void){
+	fft_signal(1024);
+}
+
+/* Windowed FFT, magnitude spectrum and dominant frequency: a full analysis */
+static void fft_spectrum(void){
+	DspFftQ15(&fft, fft_in, fft_buf);
+	DspFftMagnitude(&fft, fft_buf, fft_mag);
+	DspFftDominant(&fft, fft_mag, FFT_FS);
+}
+
+/* Same signal and window length as the 1024 point FFT, for comparison */
+static void goertzel_setup(uint8_t tones){
+	static const float frec[DSP_GOERTZEL_MAX_TONES] = {50, 60, 100, 120};
+	fft_signal(1024);
+	DspGoertzelInit(&goertzel, frec, tones, FFT_FS, 1024, Q15(1.0));
+}
+
+static void goertzel_1_setup(void){
+	goertzel_setup(1);
+}
+
+static void goertzel_4_setup(void){
+	goertzel_setup(DSP_GOERTZEL_MAX_TONES);
+}
+
+static void goertzel_window(void){
+	DspGoertzelQ15(&goertzel, fft_in, 1024);
+}
+
+static const bench_t benches[] = {
+	{"ILI9341Fill", ili9341_setup, ili9341_fill, 20, ILI9341_WIDTH * ILI9341_HEIGHT},
+	{"NeoPixelSetArray", neopixel_setup, neopixel_set_array, 2000, LEDS_QTY},
+	{"MPU6050_getMotion6", mpu6050_setup, mpu6050_get_motion6, 200000, 1},
+	{"UartSendString", uart_setup, uart_send_string, 100000, 1},
+	{"UartTxString 115200", uart_tx_115200_setup, uart_tx_string, 100000, 1},
+	{"UartTxString 921600", uart_tx_921600_setup, uart_tx_string, 100000, 1},
+	{"UartTxPrintf 115200", uart_tx_115200_setup, uart_tx_printf, 100000, 1},
+	{"UartTxPrintf 921600", uart_tx_921600_setup, uart_tx_printf, 100000, 1},
+	{"UartTelemetrySend 115200", uart_tx_115200_setup, uart_telemetry_send, 20000, TLM_SAMPLES},
+	{"UartTelemetrySend 921600", uart_tx_921600_setup, uart_telemetry_send, 20000, TLM_SAMPLES},
+	{"UartCmd 1 line per event", uart_cmd_setup, uart_cmd_line, 100000, 1},
+	{"UartCmd 8 lines per event", uart_cmd_setup, uart_cmd_batch, 20000, CMD_BATCH},
+	{"DelayUs 20 (busy wait)", delay_setup, delay_us_20, 100000, 1},
+	{"DelayUs 100", delay_setup, delay_us_100, 100000, 1},
+	{"DelayUs 100 (reference)", delay_setup, delay_us_100_reference, 100000, 1},
+	{"DelayMs 1", delay_setup, delay_ms_1, 100000, 1},
+	{"FmtInt", fmt_setup, fmt_int, 100000, FMT_VALUES},
+	{"snprintf %ld (reference)", fmt_setup, snprintf_int, 100000, FMT_VALUES},
+	{"FmtFloat 2 decimals", fmt_setup, fmt_float, 100000, FMT_VALUES},
+	{"snprintf %.2f (reference)", fmt_setup, snprintf_float, 100000, FMT_VALUES},
+	{"DspFirQ15 32 taps", fir_setup, fir_q15, 20000, DSP_BLOCK},
+	{"FIR Q15 modulo (reference)", fir_setup, fir_q15_reference, 20000, DSP_BLOCK},
+	{"DspFirQ31 32 taps", fir_setup, fir_q31, 20000, DSP_BLOCK},
+	{"DspBiquadQ15 4th order", biquad_setup, biquad_q15, 50000, DSP_BLOCK},
+	{"DspBiquadQ31 4th order", biquad_setup, biquad_q31, 50000, DSP_BLOCK},
+	{"DspDcBlockQ15", dc_block_setup, dc_block_q15, 200000, DSP_BLOCK},
+	{"DspFft spectrum 256", fft_256_setup, fft_spectrum, 20000, 256},
+	{"DspFft spectrum 1024", fft_1024_setup, fft_spectrum, 5000, 1024},
+	{"DspGoertzel 1 tone 1024", goertzel_1_setup, goertzel_window, 10000, 1024},
+	{"DspGoertzel 4 tones 1024", goertzel_4_setup, goertzel_window, 10000, 1024},
+};
+
+static uint64_t cpu_ns(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void bench_run(const bench_t *bench, uint32_t iterations){
+	mock_count_t total = {0};
+	uint32_t items = bench->items ? bench->items : 1;
+	bench->setup();
+	/* Warm up, then count only the measured calls */
+	bench->run();
+	MockRunTasks();
+	MockReset();
+	uint64_t wait_start = MockNow();
+	uint64_t start = cpu_ns();
+	for(uint32_t i = 0; i < iterations; i++){
+		bench->run();
+	}
+	double ns = (double)(cpu_ns() - start) / iterations;
+	double wait_us = (double)(MockNow() - wait_start) / iterations;
+	for(int g = 0; g < MOCK_GROUPS_QTY; g++){
+		total.calls += mock_counts[g].calls;
+		total.bytes += mock_counts[g].bytes;
+	}
+	printf("%-28s %10u %12.1f %12.2f %12.1f %12.1f %12.1f\n", bench->name, iterations, ns, ns / items, wait_us,
+		(double)total.calls / iterations, (double)total.bytes / iterations);
+	for(int g = 0; g < MOCK_GROUPS_QTY; g++){
+		if(mock_counts[g].calls == 0){
+			continue;
+		}
+		printf("  %-76s %12.1f %12.1f\n", mock_group_names[g],
+			(double)mock_counts[g].calls / iterations, (double)mock_counts[g].bytes / iterations);
+	}
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+	const char *filter = (argc > 1) ? argv[1] : "";
+	uint32_t iterations = (argc > 2) ? strtoul(argv[2], NULL, 0) : 0;
+	int found = 0;
+	printf("%-28s %10s %12s %12s %12s %12s %12s\n", "api", "iterations", "cpu_ns/call", "cpu_ns/item", "wait_us/call", "calls/call", "bytes/call");
+	for(size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++){
+		if(strstr(benches[i].name, filter) == NULL){
+			continue;
+		}
+		bench_run(&benches[i], iterations ? iterations : benches[i].iterations);
+		found++;
+	}
+	if(found == 0){
+		fprintf(stderr, "no api matches \"%s\"\n", filter);
+		return 1;
+	}
+	return 0;
+}
+
+/*==================[end of file]============================================*/
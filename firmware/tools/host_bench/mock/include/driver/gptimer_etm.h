@@ -0,0 +1,11 @@
+#ifndef MOCK_DRIVER_GPTIMER_ETM_H
+#define MOCK_DRIVER_GPTIMER_ETM_H
+#include "esp_etm.h"
+#include "driver/gptimer.h"
+typedef enum { GPTIMER_ETM_EVENT_ALARM_MATCH } gptimer_etm_event_type_t;
+typedef struct { gptimer_etm_event_type_t event_type; } gptimer_etm_event_config_t;
+typedef enum { GPTIMER_ETM_TASK_START_COUNT, GPTIMER_ETM_TASK_STOP_COUNT, GPTIMER_ETM_TASK_EN_ALARM, GPTIMER_ETM_TASK_RELOAD, GPTIMER_ETM_TASK_CAPTURE } gptimer_etm_task_type_t;
+typedef struct { gptimer_etm_task_type_t task_type; } gptimer_etm_task_config_t;
+esp_err_t gptimer_new_etm_event(gptimer_handle_t timer, const gptimer_etm_event_config_t *config, esp_etm_event_handle_t *out_event);
+esp_err_t gptimer_new_etm_task(gptimer_handle_t timer, const gptimer_etm_task_config_t *config, esp_etm_task_handle_t *out_task);
+#endif
@@ -0,0 +1,6 @@
+#ifndef MOCK_ESP_ATTR_H
+#define MOCK_ESP_ATTR_H
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define IRAM_ATTR_INLINE
+#endif
@@ -0,0 +1,9 @@
+#ifndef MOCK_ESP_LOG_H
+#define MOCK_ESP_LOG_H
+#include <stdio.h>
+#include "esp_err.h"
+#define ESP_LOGE(tag, fmt, ...) ((void)(tag))
+#define ESP_LOGW(tag, fmt, ...) ((void)(tag))
+#define ESP_LOGI(tag, fmt, ...) ((void)(tag))
+#define ESP_LOGD(tag, fmt, ...) ((void)(tag))
+#endif
@@ -0,0 +1,40 @@
+#ifndef MOCK_FREERTOS_H
+#define MOCK_FREERTOS_H
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_attr.h"
+#include "sdkconfig.h"
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              pdTRUE
+#define pdFAIL              pdFALSE
+#define portMAX_DELAY       ((TickType_t)0xffffffffUL)
+#define configTICK_RATE_HZ  CONFIG_FREERTOS_HZ
+#define portTICK_PERIOD_MS  ((TickType_t)1000 / configTICK_RATE_HZ)
+#ifdef CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+#define configGENERATE_RUN_TIME_STATS   1
+#else
+#define configGENERATE_RUN_TIME_STATS   0
+#endif
+#define configRUN_TIME_COUNTER_TYPE     uint32_t
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(((TickType_t)(ms) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+typedef struct { volatile uint32_t owner; volatile uint32_t count; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED    {0, 0}
+#define portMUX_INITIALIZE(mux)         ((mux)->owner = 0, (mux)->count = 0)
+#define portENTER_CRITICAL(mux)         ((void)(mux))
+#define portEXIT_CRITICAL(mux)          ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux)     ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux)      ((void)(mux))
+#define portENTER_CRITICAL_SAFE(mux)    ((void)(mux))
+#define portEXIT_CRITICAL_SAFE(mux)     ((void)(mux))
+#define taskENTER_CRITICAL(mux)         ((void)(mux))
+#define taskEXIT_CRITICAL(mux)          ((void)(mux))
+#define portYIELD_FROM_ISR(...)         ((void)0)
+#define portNUM_PROCESSORS              1
+BaseType_t xPortInIsrContext(void);
+#endif
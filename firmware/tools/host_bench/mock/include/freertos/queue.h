@@ -0,0 +1,10 @@
+#ifndef MOCK_FREERTOS_QUEUE_H
+#define MOCK_FREERTOS_QUEUE_H
+#include "freertos/FreeRTOS.h"
+typedef struct mock_queue *QueueHandle_t;
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size);
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks);
+BaseType_t xQueueReset(QueueHandle_t q);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+#endif
@@ -0,0 +1,19 @@
+#ifndef MOCK_FREERTOS_TASK_H
+#define MOCK_FREERTOS_TASK_H
+#include "freertos/FreeRTOS.h"
+typedef void (*TaskFunction_t)(void *);
+typedef struct mock_task *TaskHandle_t;
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter(const TaskHandle_t task);
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+#endif
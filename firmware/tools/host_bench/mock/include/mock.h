@@ -0,0 +1,99 @@
+/**
+ * @file mock.h
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock of the ESP-IDF drivers used by firmware/drivers.
+ *
+ * Every mocked peripheral call is counted per group, together with the bytes
+ * it moves over its bus. Time is virtual: it only advances when the drivers
+ * wait (esp_rom_delay_us(), vTaskDelay(), blocking on a semaphore or task
+ * notification), and gptimer alarms fire in order as it does, so DelayUs(),
+ * DelayMs() and the soft timers work. ETM channels are simulated: timer alarms
+ * and GPIO edges run the linked timer and GPIO tasks, with the ESP32-C6 limit
+ * of one ETM task per GPIO. Tasks created with xTaskCreate() run cooperatively
+ * while the calling thread blocks (see MockRunTasks()). The UART transmits at
+ * its baud rate through the driver buffer and FIFO, and received data can be
+ * injected with MockUartReceive(). ADC continuous mode converts the samples
+ * given to MockAdcConvert().
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef MOCK_H
+#define MOCK_H
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+/*==================[macros]=================================================*/
+#define MOCK_CPU_MHZ	160		/* Reported CPU clock (esp_rom_get_cpu_ticks_per_us()) */
+/* Count a call of a group and the bytes it moved */
+#define MOCK_CALL(group, nbytes)	(mock_counts[group].calls++, mock_counts[group].bytes += (nbytes))
+/*==================[typedef]================================================*/
+/* Peripheral groups */
+typedef enum mock_group {
+	MOCK_GPIO,
+	MOCK_DEDIC_GPIO,
+	MOCK_SPI,
+	MOCK_I2C,
+	MOCK_UART,
+	MOCK_GPTIMER,
+	MOCK_ADC,
+	MOCK_SDM,
+	MOCK_LEDC,
+	MOCK_ETM,
+	MOCK_RTOS,
+	MOCK_GROUPS_QTY,
+} mock_group_t;
+
+typedef struct {
+	uint64_t calls;		/* API calls */
+	uint64_t bytes;		/* Bytes moved over the bus (transfers only) */
+} mock_count_t;
+/*==================[external data declaration]==============================*/
+extern mock_count_t mock_counts[MOCK_GROUPS_QTY];
+extern const char *mock_group_names[MOCK_GROUPS_QTY];
+/*==================[external functions declaration]=========================*/
+/* Clear the counters (time keeps running) */
+void MockReset(void);
+
+/* Virtual time (us) */
+uint64_t MockNow(void);
+
+/* Advance the virtual time to a deadline, firing the gptimer alarms due on the way */
+void MockAdvanceTo(uint64_t deadline);
+
+/* Block until the next gptimer alarm: advance the virtual time to it and fire
+ * it. Returns 0 if no alarm is due before the deadline (time is then left at
+ * the deadline, or unchanged for UINT64_MAX) */
+int MockAdvanceToAlarm(uint64_t deadline);
+
+/* Run the created tasks that are ready until all of them block. Returns the
+ * number of times a task ran (only from the main thread) */
+int MockRunTasks(void);
+
+/* Data received by a UART port (uart_port_t): it is buffered by the driver and
+ * a UART_DATA event is queued */
+void MockUartReceive(int uart_num, const void *data, uint32_t len);
+
+/* Called with the data of every uart_write_bytes(), before it waits for the
+ * line: it sees what reaches the UART, and can run what a higher priority task
+ * would do while the write is in progress (NULL: none) */
+void MockUartWriteHook(void (*hook)(int uart_num, const void *data, uint32_t len));
+
+/* Raw samples converted by the ADC in continuous mode (after
+ * adc_continuous_start()): they fill the conversion frames, and each complete
+ * frame calls the conversion done callback */
+void MockAdcConvert(const uint16_t *raw, uint32_t len);
+
+/* Hooks between the mocked peripherals (ETM links them as the hardware does) */
+struct gptimer_t;
+void MockGpioDrive(int pin, uint32_t level);
+void MockGptimerEtmTask(struct gptimer_t *timer, int task_type);
+void MockEtmTimerAlarm(struct gptimer_t *timer);
+void MockEtmGpioEdge(int pin, uint32_t level);
+
+#endif /* #ifndef MOCK_H */
+
+/*==================[end of file]============================================*/
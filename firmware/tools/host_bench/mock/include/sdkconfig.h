@@ -0,0 +1,6 @@
+#ifndef MOCK_SDKCONFIG_H
+#define MOCK_SDKCONFIG_H
+#define CONFIG_IDF_TARGET_ESP32C6 1
+#define CONFIG_FREERTOS_HZ 100
+#define CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS 1
+#endif
@@ -0,0 +1,176 @@
+/**
+ * @file mock_adc.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: ADC oneshot, continuous and calibration drivers. Oneshot
+ * reads return mid scale. In continuous mode the samples given to
+ * MockAdcConvert() fill conversion frames: each complete frame calls the
+ * conversion done callback and can then be read.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define RAW_MID		2048		/* Oneshot reading */
+#define MV_FULL		3300		/* Calibrated full scale (mV) */
+#define POOL_MAX	4096		/* Continuous mode results waiting to be read */
+/*==================[internal data definition]===============================*/
+/* Handles are only compared against NULL by the drivers */
+static int dummy;
+static adc_continuous_evt_cbs_t cont_cbs;
+static void *cont_user_data;
+static uint32_t cont_frame_results = 1;		/* Results per conversion frame */
+static uint32_t cont_pool_max = POOL_MAX;	/* Pool size (results) */
+static uint8_t cont_channel;
+static bool cont_running;
+static uint32_t cont_pool[POOL_MAX];
+static uint32_t cont_pool_done;				/* Results of complete frames */
+static uint32_t cont_pool_len;				/* Results (including the frame being converted) */
+/*==================[external functions definition]==========================*/
+void MockAdcConvert(const uint16_t *raw, uint32_t len){
+	for(uint32_t i = 0; i < len && cont_running; i++){
+		if(cont_pool_len == cont_pool_max){
+			/* Pool full: the frame being converted is lost */
+			cont_pool_len = cont_pool_done;
+			if(cont_cbs.on_pool_ovf != NULL){
+				cont_cbs.on_pool_ovf((adc_continuous_handle_t)&dummy, NULL, cont_user_data);
+			}
+			continue;
+		}
+		adc_digi_output_data_t result = {
+			.type2.data = raw[i],
+			.type2.channel = cont_channel,
+		};
+		cont_pool[cont_pool_len++] = result.val;
+		if(cont_pool_len - cont_pool_done == cont_frame_results){
+			adc_continuous_evt_data_t edata = {
+				.conv_frame_buffer = (uint8_t *)&cont_pool[cont_pool_done],
+				.size = cont_frame_results * SOC_ADC_DIGI_RESULT_BYTES,
+			};
+			cont_pool_done = cont_pool_len;
+			if(cont_cbs.on_conv_done != NULL){
+				cont_cbs.on_conv_done((adc_continuous_handle_t)&dummy, &edata, cont_user_data);
+			}
+		}
+	}
+}
+
+esp_err_t adc_oneshot_new_unit(const adc_oneshot_unit_init_cfg_t *init_config, adc_oneshot_unit_handle_t *ret_unit){
+	MOCK_CALL(MOCK_ADC, 0);
+	*ret_unit = (adc_oneshot_unit_handle_t)&dummy;
+	return ESP_OK;
+}
+
+esp_err_t adc_oneshot_config_channel(adc_oneshot_unit_handle_t handle, adc_channel_t channel, const adc_oneshot_chan_cfg_t *config){
+	MOCK_CALL(MOCK_ADC, 0);
+	return ESP_OK;
+}
+
+esp_err_t adc_oneshot_read(adc_oneshot_unit_handle_t handle, adc_channel_t chan, int *out_raw){
+	MOCK_CALL(MOCK_ADC, 2);
+	*out_raw = RAW_MID;
+	return ESP_OK;
+}
+
+esp_err_t adc_oneshot_del_unit(adc_oneshot_unit_handle_t handle){
+	MOCK_CALL(MOCK_ADC, 0);
+	return ESP_OK;
+}
+
+esp_err_t adc_cali_create_scheme_curve_fitting(const adc_cali_curve_fitting_config_t *config, adc_cali_handle_t *ret_handle){
+	MOCK_CALL(MOCK_ADC, 0);
+	*ret_handle = (adc_cali_handle_t)&dummy;
+	return ESP_OK;
+}
+
+esp_err_t adc_cali_delete_scheme_curve_fitting(adc_cali_handle_t handle){
+	MOCK_CALL(MOCK_ADC, 0);
+	return ESP_OK;
+}
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage){
+	MOCK_CALL(MOCK_ADC, 0);
+	*voltage = raw * MV_FULL / 4096;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle){
+	MOCK_CALL(MOCK_ADC, 0);
+	cont_frame_results = hdl_config->conv_frame_size / SOC_ADC_DIGI_RESULT_BYTES;
+	cont_pool_max = hdl_config->max_store_buf_size / SOC_ADC_DIGI_RESULT_BYTES;
+	if(cont_frame_results == 0 || cont_pool_max < cont_frame_results || cont_pool_max > POOL_MAX){
+		return ESP_ERR_INVALID_ARG;
+	}
+	*ret_handle = (adc_continuous_handle_t)&dummy;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config){
+	MOCK_CALL(MOCK_ADC, 0);
+	if(cont_running){
+		return ESP_ERR_INVALID_STATE;
+	}
+	cont_channel = config->adc_pattern[0].channel;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs, void *user_data){
+	MOCK_CALL(MOCK_ADC, 0);
+	cont_cbs = *cbs;
+	cont_user_data = user_data;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle){
+	MOCK_CALL(MOCK_ADC, 0);
+	if(cont_running){
+		return ESP_ERR_INVALID_STATE;
+	}
+	cont_pool_done = 0;
+	cont_pool_len = 0;
+	cont_running = true;
+	return ESP_OK;
+}
+
+/* Reads whole results of complete frames only */
+esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint32_t length_max, uint32_t *out_length, uint32_t timeout_ms){
+	uint32_t results = length_max / SOC_ADC_DIGI_RESULT_BYTES;
+	MOCK_CALL(MOCK_ADC, 0);
+	if(results > cont_pool_done){
+		results = cont_pool_done;
+	}
+	*out_length = results * SOC_ADC_DIGI_RESULT_BYTES;
+	if(results == 0){
+		return ESP_ERR_TIMEOUT;
+	}
+	mock_counts[MOCK_ADC].bytes += *out_length;
+	memcpy(buf, cont_pool, *out_length);
+	memmove(cont_pool, &cont_pool[results], (cont_pool_len - results) * sizeof(cont_pool[0]));
+	cont_pool_done -= results;
+	cont_pool_len -= results;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle){
+	MOCK_CALL(MOCK_ADC, 0);
+	if(!cont_running){
+		return ESP_ERR_INVALID_STATE;
+	}
+	cont_running = false;
+	return ESP_OK;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle){
+	MOCK_CALL(MOCK_ADC, 0);
+	return ESP_OK;
+}
+
+/*==================[end of file]============================================*/
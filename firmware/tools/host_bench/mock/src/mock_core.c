@@ -0,0 +1,58 @@
+/**
+ * @file mock_core.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: call counters, CPU cycle counter, ROM delays and esp_timer
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include <string.h>
+#include <time.h>
+/*==================[external data definition]===============================*/
+mock_count_t mock_counts[MOCK_GROUPS_QTY];
+const char *mock_group_names[MOCK_GROUPS_QTY] = {
+	[MOCK_GPIO] = "gpio",
+	[MOCK_DEDIC_GPIO] = "dedic_gpio",
+	[MOCK_SPI] = "spi",
+	[MOCK_I2C] = "i2c",
+	[MOCK_UART] = "uart",
+	[MOCK_GPTIMER] = "gptimer",
+	[MOCK_ADC] = "adc",
+	[MOCK_SDM] = "sdm",
+	[MOCK_LEDC] = "ledc",
+	[MOCK_ETM] = "etm",
+	[MOCK_RTOS] = "freertos",
+};
+/*==================[external functions definition]==========================*/
+void MockReset(void){
+	memset(mock_counts, 0, sizeof(mock_counts));
+}
+
+/* Host CPU time scaled to the target clock, so cycle differences read as target time */
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (esp_cpu_cycle_count_t)(((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec) * MOCK_CPU_MHZ / 1000);
+}
+
+void esp_rom_delay_us(uint32_t us){
+	MockAdvanceTo(MockNow() + us);
+}
+
+uint32_t esp_rom_get_cpu_ticks_per_us(void){
+	return MOCK_CPU_MHZ;
+}
+
+int64_t esp_timer_get_time(void){
+	return (int64_t)MockNow();
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,251 @@
+/**
+ * @file mock_etm.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: Event Task Matrix. Channels link the gptimer alarm and GPIO
+ * edge events to the gptimer and GPIO tasks, which run as soon as the event
+ * happens. As on the ESP32-C6, a GPIO can be added to only one GPIO ETM task.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "esp_etm.h"
+#include "driver/gpio_etm.h"
+#include "driver/gptimer_etm.h"
+#include <stdlib.h>
+/*==================[macros and definitions]=================================*/
+#define CHANNELS_MAX	50		/* ESP32-C6 ETM channels */
+#define DEPTH_MAX		8		/* Nested events (a task that makes an event) */
+
+typedef enum {
+	ETM_TIMER,
+	ETM_GPIO,
+} etm_source_t;
+
+struct esp_etm_event_t {
+	etm_source_t source;
+	gptimer_handle_t timer;			/* ETM_TIMER: the alarm */
+	int pin;						/* ETM_GPIO: the edge */
+	gpio_etm_event_edge_t edge;
+};
+
+struct esp_etm_task_t {
+	etm_source_t source;
+	gptimer_handle_t timer;			/* ETM_TIMER */
+	gptimer_etm_task_type_t timer_task;
+	gpio_etm_task_action_t action;	/* ETM_GPIO */
+	uint64_t pins;					/* ETM_GPIO: mask of the added GPIOs */
+};
+
+struct esp_etm_channel_t {
+	bool used;
+	bool enabled;
+	esp_etm_event_handle_t event;
+	esp_etm_task_handle_t task;
+};
+/*==================[internal data definition]===============================*/
+static struct esp_etm_channel_t channels[CHANNELS_MAX];
+static esp_etm_task_handle_t gpio_owner[GPIO_NUM_MAX];	/* GPIO ETM task of each GPIO */
+static uint32_t pin_levels[GPIO_NUM_MAX];				/* Last level driven by ETM */
+static int depth;
+/*==================[internal functions definition]==========================*/
+static void task_run(esp_etm_task_handle_t task){
+	if(task->source == ETM_TIMER){
+		MockGptimerEtmTask(task->timer, task->timer_task);
+		return;
+	}
+	for(int pin = 0; pin < GPIO_NUM_MAX; pin++){
+		if(!(task->pins & (1ULL << pin))){
+			continue;
+		}
+		switch(task->action){
+			case GPIO_ETM_TASK_ACTION_SET:
+				pin_levels[pin] = 1;
+				break;
+			case GPIO_ETM_TASK_ACTION_CLR:
+				pin_levels[pin] = 0;
+				break;
+			case GPIO_ETM_TASK_ACTION_TOG:
+				pin_levels[pin] ^= 1;
+				break;
+		}
+		MockGpioDrive(pin, pin_levels[pin]);
+	}
+}
+
+/* Run the tasks of every enabled channel whose event matches */
+static void event_fire(etm_source_t source, gptimer_handle_t timer, int pin, uint32_t level){
+	if(depth >= DEPTH_MAX){
+		return;
+	}
+	depth++;
+	for(int i = 0; i < CHANNELS_MAX; i++){
+		esp_etm_channel_handle_t chan = &channels[i];
+		if(!chan->used || !chan->enabled || chan->event == NULL || chan->task == NULL){
+			continue;
+		}
+		esp_etm_event_handle_t event = chan->event;
+		if(event->source != source){
+			continue;
+		}
+		if(source == ETM_TIMER && event->timer != timer){
+			continue;
+		}
+		if(source == ETM_GPIO && (event->pin != pin ||
+			(event->edge == GPIO_ETM_EVENT_EDGE_POS && !level) ||
+			(event->edge == GPIO_ETM_EVENT_EDGE_NEG && level))){
+			continue;
+		}
+		task_run(chan->task);
+	}
+	depth--;
+}
+
+/*==================[external functions definition]==========================*/
+void MockEtmTimerAlarm(struct gptimer_t *timer){
+	event_fire(ETM_TIMER, timer, -1, 0);
+}
+
+void MockEtmGpioEdge(int pin, uint32_t level){
+	pin_levels[pin] = level;
+	event_fire(ETM_GPIO, NULL, pin, level);
+}
+
+esp_err_t esp_etm_new_channel(const esp_etm_channel_config_t *config, esp_etm_channel_handle_t *ret_chan){
+	MOCK_CALL(MOCK_ETM, 0);
+	for(int i = 0; i < CHANNELS_MAX; i++){
+		if(!channels[i].used){
+			channels[i] = (struct esp_etm_channel_t){.used = true};
+			*ret_chan = &channels[i];
+			return ESP_OK;
+		}
+	}
+	return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t esp_etm_del_channel(esp_etm_channel_handle_t chan){
+	MOCK_CALL(MOCK_ETM, 0);
+	if(chan->enabled){
+		return ESP_ERR_INVALID_STATE;
+	}
+	chan->used = false;
+	return ESP_OK;
+}
+
+esp_err_t esp_etm_channel_enable(esp_etm_channel_handle_t chan){
+	MOCK_CALL(MOCK_ETM, 0);
+	if(chan->enabled){
+		return ESP_ERR_INVALID_STATE;
+	}
+	chan->enabled = true;
+	return ESP_OK;
+}
+
+esp_err_t esp_etm_channel_disable(esp_etm_channel_handle_t chan){
+	MOCK_CALL(MOCK_ETM, 0);
+	if(!chan->enabled){
+		return ESP_ERR_INVALID_STATE;
+	}
+	chan->enabled = false;
+	return ESP_OK;
+}
+
+esp_err_t esp_etm_channel_connect(esp_etm_channel_handle_t chan, esp_etm_event_handle_t event, esp_etm_task_handle_t task){
+	MOCK_CALL(MOCK_ETM, 0);
+	chan->event = event;
+	chan->task = task;
+	return ESP_OK;
+}
+
+esp_err_t esp_etm_del_event(esp_etm_event_handle_t event){
+	MOCK_CALL(MOCK_ETM, 0);
+	free(event);
+	return ESP_OK;
+}
+
+esp_err_t esp_etm_del_task(esp_etm_task_handle_t task){
+	MOCK_CALL(MOCK_ETM, 0);
+	if(task->pins){
+		/* GPIOs must be removed first */
+		return ESP_ERR_INVALID_STATE;
+	}
+	free(task);
+	return ESP_OK;
+}
+
+esp_err_t gpio_new_etm_event(const gpio_etm_event_config_t *config, esp_etm_event_handle_t *ret_event){
+	MOCK_CALL(MOCK_ETM, 0);
+	esp_etm_event_handle_t event = calloc(1, sizeof(struct esp_etm_event_t));
+	event->source = ETM_GPIO;
+	event->pin = -1;
+	event->edge = config->edge;
+	*ret_event = event;
+	return ESP_OK;
+}
+
+esp_err_t gpio_etm_event_bind_gpio(esp_etm_event_handle_t event, int gpio_num){
+	MOCK_CALL(MOCK_ETM, 0);
+	if(gpio_num < 0 || gpio_num >= GPIO_NUM_MAX){
+		return ESP_ERR_INVALID_ARG;
+	}
+	event->pin = gpio_num;
+	return ESP_OK;
+}
+
+esp_err_t gpio_new_etm_task(const gpio_etm_task_config_t *config, esp_etm_task_handle_t *ret_task){
+	MOCK_CALL(MOCK_ETM, 0);
+	esp_etm_task_handle_t task = calloc(1, sizeof(struct esp_etm_task_t));
+	task->source = ETM_GPIO;
+	task->action = config->action;
+	*ret_task = task;
+	return ESP_OK;
+}
+
+esp_err_t gpio_etm_task_add_gpio(esp_etm_task_handle_t task, int gpio_num){
+	MOCK_CALL(MOCK_ETM, 0);
+	if(gpio_num < 0 || gpio_num >= GPIO_NUM_MAX){
+		return ESP_ERR_INVALID_ARG;
+	}
+	if(gpio_owner[gpio_num] != NULL){
+		/* The GPIO is already bound to another ETM task */
+		return ESP_ERR_INVALID_STATE;
+	}
+	gpio_owner[gpio_num] = task;
+	task->pins |= 1ULL << gpio_num;
+	return ESP_OK;
+}
+
+esp_err_t gpio_etm_task_rm_gpio(esp_etm_task_handle_t task, int gpio_num){
+	MOCK_CALL(MOCK_ETM, 0);
+	if(gpio_num < 0 || gpio_num >= GPIO_NUM_MAX || gpio_owner[gpio_num] != task){
+		return ESP_ERR_INVALID_ARG;
+	}
+	gpio_owner[gpio_num] = NULL;
+	task->pins &= ~(1ULL << gpio_num);
+	return ESP_OK;
+}
+
+esp_err_t gptimer_new_etm_event(gptimer_handle_t timer, const gptimer_etm_event_config_t *config, esp_etm_event_handle_t *out_event){
+	MOCK_CALL(MOCK_ETM, 0);
+	esp_etm_event_handle_t event = calloc(1, sizeof(struct esp_etm_event_t));
+	event->source = ETM_TIMER;
+	event->timer = timer;
+	*out_event = event;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_new_etm_task(gptimer_handle_t timer, const gptimer_etm_task_config_t *config, esp_etm_task_handle_t *out_task){
+	MOCK_CALL(MOCK_ETM, 0);
+	esp_etm_task_handle_t task = calloc(1, sizeof(struct esp_etm_task_t));
+	task->source = ETM_TIMER;
+	task->timer = timer;
+	task->timer_task = config->task_type;
+	*out_task = task;
+	return ESP_OK;
+}
+
+/*==================[end of file]============================================*/
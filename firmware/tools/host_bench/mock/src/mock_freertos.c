@@ -0,0 +1,361 @@
+/**
+ * @file mock_freertos.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: FreeRTOS queues, semaphores and tasks. Tasks are
+ * cooperative: each created task runs on its own stack (ucontext) until it
+ * blocks, and created tasks only run while the main task (the bench) blocks or
+ * calls MockRunTasks(). Priorities are ignored. When every task is blocked,
+ * the virtual time advances through the gptimer alarms (the only source of
+ * "ISRs") and the task timeouts. The run-time counter of a created task is the
+ * virtual time spent while it was running (busy waits), in us.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+/*==================[macros and definitions]=================================*/
+#define TICK_US		(1000u * portTICK_PERIOD_MS)
+#define TASKS_MAX	16				/* Created tasks */
+#define TASK_STACK	(256 * 1024)	/* Host stack of a created task */
+
+struct mock_queue {
+	UBaseType_t len;		/* Capacity */
+	UBaseType_t item_size;	/* 0: semaphore */
+	UBaseType_t count;		/* Items (or semaphore count) */
+	UBaseType_t head;
+	bool is_static;
+	uint8_t *items;
+};
+
+struct mock_task {
+	uint32_t notify;					/* Notification value */
+	TaskFunction_t fn;					/* NULL: main task */
+	void *param;
+	ucontext_t ctx;
+	void *stack;
+	bool started;
+	bool deleted;
+	volatile UBaseType_t *wait;			/* Count the task is blocked on (NULL: none) */
+	uint64_t deadline;					/* Virtual time it wakes up anyway */
+	uint64_t run_time;					/* Virtual time it ran, up to its last switch out (us) */
+};
+
+_Static_assert(sizeof(struct mock_queue) <= sizeof(StaticSemaphore_t), "StaticSemaphore_t too small");
+/*==================[internal data definition]===============================*/
+static struct mock_task main_task = {.deadline = UINT64_MAX};	/* The bench */
+static struct mock_task *tasks[TASKS_MAX];						/* Created tasks */
+static struct mock_task *current = &main_task;					/* Running task */
+/*==================[internal functions definition]==========================*/
+static void task_entry(void){
+	current->fn(current->param);
+	/* A FreeRTOS task must not return, treat it as deleted */
+	vTaskDelete(NULL);
+}
+
+static bool task_ready(struct mock_task *task){
+	if(task == NULL || task->deleted){
+		return false;
+	}
+	return !task->started || (task->wait != NULL && *task->wait != 0) || MockNow() >= task->deadline;
+}
+
+/* Switch from a created task back to the main task */
+static void task_block(volatile UBaseType_t *count, uint64_t deadline){
+	struct mock_task *task = current;
+	task->wait = count;
+	task->deadline = deadline;
+	current = &main_task;
+	swapcontext(&task->ctx, &main_task.ctx);
+}
+
+/* Earliest timeout of the blocked tasks */
+static uint64_t task_next_deadline(void){
+	uint64_t next = UINT64_MAX;
+	for(int i = 0; i < TASKS_MAX; i++){
+		if(tasks[i] != NULL && !tasks[i]->deleted && tasks[i]->deadline < next){
+			next = tasks[i]->deadline;
+		}
+	}
+	return next;
+}
+
+/* Wait for a count to be non zero, letting the tasks and the alarms run.
+ * Returns pdFALSE on timeout */
+static BaseType_t wait_for(volatile UBaseType_t *count, TickType_t ticks){
+	uint64_t deadline = (ticks == portMAX_DELAY) ? UINT64_MAX : MockNow() + (uint64_t)ticks * TICK_US;
+	while(*count == 0){
+		if(current != &main_task){
+			task_block(count, deadline);
+			current->wait = NULL;
+			current->deadline = UINT64_MAX;
+			if(*count == 0 && MockNow() >= deadline){
+				return pdFALSE;
+			}
+			continue;
+		}
+		if(MockRunTasks() > 0){
+			continue;
+		}
+		uint64_t wake = task_next_deadline();
+		if(wake < deadline){
+			MockAdvanceToAlarm(wake);
+			continue;
+		}
+		if(!MockAdvanceToAlarm(deadline)){
+			/* Timed out, or nothing left that could give it */
+			return *count != 0;
+		}
+	}
+	return pdTRUE;
+}
+
+static QueueHandle_t queue_new(struct mock_queue *q, UBaseType_t len, UBaseType_t item_size, UBaseType_t count){
+	bool is_static = (q != NULL);
+	if(q == NULL){
+		q = malloc(sizeof(struct mock_queue));
+	}
+	*q = (struct mock_queue){
+		.len = len,
+		.item_size = item_size,
+		.count = count,
+		.is_static = is_static,
+		.items = item_size ? malloc((size_t)len * item_size) : NULL,
+	};
+	return q;
+}
+
+/*==================[external functions definition]==========================*/
+int MockRunTasks(void){
+	int runs = 0;
+	bool ran;
+	if(current != &main_task){
+		return 0;
+	}
+	do{
+		ran = false;
+		for(int i = 0; i < TASKS_MAX; i++){
+			struct mock_task *task = tasks[i];
+			if(!task_ready(task)){
+				continue;
+			}
+			if(!task->started){
+				task->started = true;
+				getcontext(&task->ctx);
+				task->ctx.uc_stack.ss_sp = task->stack;
+				task->ctx.uc_stack.ss_size = TASK_STACK;
+				task->ctx.uc_link = NULL;
+				makecontext(&task->ctx, task_entry, 0);
+			}
+			uint64_t switched_in = MockNow();
+			current = task;
+			swapcontext(&main_task.ctx, &task->ctx);
+			task->run_time += MockNow() - switched_in;
+			ran = true;
+			runs++;
+		}
+	} while(ran);
+	return runs;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size){
+	MOCK_CALL(MOCK_RTOS, 0);
+	return queue_new(NULL, len, item_size, 0);
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks){
+	MOCK_CALL(MOCK_RTOS, 0);
+	if(q->count == q->len){
+		/* No other task can make room */
+		return pdFALSE;
+	}
+	memcpy(&q->items[((q->head + q->count) % q->len) * q->item_size], item, q->item_size);
+	q->count++;
+	return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks){
+	MOCK_CALL(MOCK_RTOS, 0);
+	if(!wait_for(&q->count, ticks)){
+		return pdFALSE;
+	}
+	memcpy(item, &q->items[q->head * q->item_size], q->item_size);
+	q->head = (q->head + 1) % q->len;
+	q->count--;
+	return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t q){
+	MOCK_CALL(MOCK_RTOS, 0);
+	q->count = 0;
+	q->head = 0;
+	return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q){
+	MOCK_CALL(MOCK_RTOS, 0);
+	return q->count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void){
+	MOCK_CALL(MOCK_RTOS, 0);
+	return queue_new(NULL, 1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void){
+	MOCK_CALL(MOCK_RTOS, 0);
+	return queue_new(NULL, 1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer){
+	MOCK_CALL(MOCK_RTOS, 0);
+	return queue_new((struct mock_queue*)buffer, 1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer){
+	MOCK_CALL(MOCK_RTOS, 0);
+	return queue_new((struct mock_queue*)buffer, 1, 0, 1);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t s){
+	MOCK_CALL(MOCK_RTOS, 0);
+	free(s->items);
+	if(!s->is_static){
+		free(s);
+	}
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks){
+	MOCK_CALL(MOCK_RTOS, 0);
+	if(!wait_for(&s->count, ticks)){
+		return pdFALSE;
+	}
+	s->count--;
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s){
+	MOCK_CALL(MOCK_RTOS, 0);
+	if(s->count == s->len){
+		return pdFALSE;
+	}
+	s->count++;
+	return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t s, BaseType_t *woken){
+	return xSemaphoreGive(s);
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *param, UBaseType_t prio, TaskHandle_t *handle){
+	MOCK_CALL(MOCK_RTOS, 0);
+	for(int i = 0; i < TASKS_MAX; i++){
+		if(tasks[i] == NULL || (tasks[i]->deleted && tasks[i] != current)){
+			if(tasks[i] != NULL){
+				free(tasks[i]->stack);
+				free(tasks[i]);
+			}
+			struct mock_task *task = calloc(1, sizeof(struct mock_task));
+			task->fn = fn;
+			task->param = param;
+			task->stack = malloc(TASK_STACK);
+			task->deadline = UINT64_MAX;
+			tasks[i] = task;
+			if(handle != NULL){
+				*handle = task;
+			}
+			return pdPASS;
+		}
+	}
+	return pdFAIL;
+}
+
+void vTaskDelete(TaskHandle_t task){
+	MOCK_CALL(MOCK_RTOS, 0);
+	if(task == NULL){
+		task = current;
+	}
+	if(task == &main_task){
+		return;
+	}
+	/* Freed by a later xTaskCreate(), the stack may be in use right now */
+	task->deleted = true;
+	if(task == current){
+		current = &main_task;
+		swapcontext(&task->ctx, &main_task.ctx);
+	}
+}
+
+void vTaskDelay(TickType_t ticks){
+	MOCK_CALL(MOCK_RTOS, 0);
+	uint64_t deadline = MockNow() + (uint64_t)ticks * TICK_US;
+	if(current != &main_task){
+		task_block(NULL, deadline);
+		current->deadline = UINT64_MAX;
+		return;
+	}
+	MockRunTasks();
+	MockAdvanceTo(deadline);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void){
+	return current;
+}
+
+TickType_t xTaskGetTickCount(void){
+	return MockNow() / TICK_US;
+}
+
+TickType_t xTaskGetTickCountFromISR(void){
+	return MockNow() / TICK_US;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken){
+	MOCK_CALL(MOCK_RTOS, 0);
+	task->notify++;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task){
+	MOCK_CALL(MOCK_RTOS, 0);
+	task->notify++;
+	return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks){
+	MOCK_CALL(MOCK_RTOS, 0);
+	struct mock_task *task = current;
+	if(!wait_for(&task->notify, ticks)){
+		return 0;
+	}
+	uint32_t value = task->notify;
+	task->notify = clear ? 0 : value - 1;
+	return value;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task){
+	return 0;
+}
+
+/* As FreeRTOS, the time since the running task was switched in is not counted */
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter(const TaskHandle_t task){
+	return (task != NULL) ? task->run_time : current->run_time;
+}
+
+void vTaskSuspendAll(void){
+}
+
+BaseType_t xTaskResumeAll(void){
+	return pdFALSE;
+}
+
+/*==================[end of file]============================================*/
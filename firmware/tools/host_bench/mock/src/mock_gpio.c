@@ -0,0 +1,110 @@
+/**
+ * @file mock_gpio.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: GPIO, dedicated GPIO and glitch filters
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "driver/gpio.h"
+#include "driver/gpio_filter.h"
+#include "driver/dedic_gpio.h"
+/*==================[internal data definition]===============================*/
+static uint32_t gpio_levels[GPIO_NUM_MAX];
+static uint32_t dedic_levels;
+/* Handles are only compared against NULL by the drivers */
+static int dummy;
+/*==================[external functions definition]==========================*/
+void MockGpioDrive(int pin, uint32_t level){
+	if(pin < 0 || pin >= GPIO_NUM_MAX){
+		return;
+	}
+	level = (level != 0);
+	if(gpio_levels[pin] != level){
+		gpio_levels[pin] = level;
+		MockEtmGpioEdge(pin, level);
+	}
+}
+
+esp_err_t gpio_config(const gpio_config_t *cfg){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t gpio_reset_pin(gpio_num_t gpio_num){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level){
+	MOCK_CALL(MOCK_GPIO, 0);
+	MockGpioDrive(gpio_num, level);
+	return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num){
+	MOCK_CALL(MOCK_GPIO, 0);
+	if(gpio_num >= 0 && gpio_num < GPIO_NUM_MAX){
+		return gpio_levels[gpio_num];
+	}
+	return 0;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t gpio_new_flex_glitch_filter(const gpio_flex_glitch_filter_config_t *config, gpio_glitch_filter_handle_t *ret_filter){
+	MOCK_CALL(MOCK_GPIO, 0);
+	*ret_filter = (gpio_glitch_filter_handle_t)&dummy;
+	return ESP_OK;
+}
+
+esp_err_t gpio_glitch_filter_enable(gpio_glitch_filter_handle_t filter){
+	MOCK_CALL(MOCK_GPIO, 0);
+	return ESP_OK;
+}
+
+esp_err_t dedic_gpio_new_bundle(const dedic_gpio_bundle_config_t *config, dedic_gpio_bundle_handle_t *ret_bundle){
+	MOCK_CALL(MOCK_DEDIC_GPIO, 0);
+	*ret_bundle = (dedic_gpio_bundle_handle_t)&dummy;
+	return ESP_OK;
+}
+
+void dedic_gpio_bundle_write(dedic_gpio_bundle_handle_t bundle, uint32_t mask, uint32_t value){
+	MOCK_CALL(MOCK_DEDIC_GPIO, 0);
+	dedic_levels = (dedic_levels & ~mask) | (value & mask);
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,265 @@
+/**
+ * @file mock_gptimer.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: virtual time and general purpose timers (with their alarms)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "driver/gptimer.h"
+#include "driver/gptimer_etm.h"
+#include "freertos/FreeRTOS.h"
+#include <stdbool.h>
+/*==================[macros and definitions]=================================*/
+#define TIMERS_MAX	2		/* ESP32-C6 gptimers */
+
+struct gptimer_t {
+	bool used;
+	bool enabled;
+	bool running;
+	bool alarm_on;
+	gptimer_alarm_config_t alarm;
+	gptimer_alarm_cb_t on_alarm;
+	void *user_ctx;
+	uint32_t resolution_hz;
+	uint64_t count_base;		/* Count at time_base */
+	uint64_t time_base;			/* Virtual time of the last count change (us) */
+	uint64_t captured;			/* Count captured by an ETM task */
+};
+/*==================[internal data definition]===============================*/
+static struct gptimer_t timers[TIMERS_MAX];
+static uint64_t mock_now = 0;		/* Virtual time (us) */
+static bool mock_in_isr = false;	/* An alarm callback is running */
+/*==================[internal functions definition]==========================*/
+static uint64_t timer_count(struct gptimer_t *timer){
+	if(!timer->running){
+		return timer->count_base;
+	}
+	return timer->count_base + (mock_now - timer->time_base) * timer->resolution_hz / 1000000u;
+}
+
+/* Virtual time of the next alarm of a timer (UINT64_MAX: none) */
+static uint64_t timer_due(struct gptimer_t *timer){
+	if(!timer->running || !timer->alarm_on){
+		return UINT64_MAX;
+	}
+	uint64_t count = timer_count(timer);
+	if(timer->alarm.alarm_count <= count){
+		/* Alarm set in the past fires right away */
+		return mock_now;
+	}
+	uint64_t ticks = timer->alarm.alarm_count - timer->count_base;
+	return timer->time_base + (ticks * 1000000u + timer->resolution_hz - 1) / timer->resolution_hz;
+}
+
+static struct gptimer_t *next_alarm(uint64_t *due){
+	struct gptimer_t *next = NULL;
+	*due = UINT64_MAX;
+	for(int i = 0; i < TIMERS_MAX; i++){
+		uint64_t t = timer_due(&timers[i]);
+		if(timers[i].used && t < *due){
+			*due = t;
+			next = &timers[i];
+		}
+	}
+	return next;
+}
+
+static void fire(struct gptimer_t *timer){
+	gptimer_alarm_event_data_t edata = {
+		.count_value = timer_count(timer),
+		.alarm_value = timer->alarm.alarm_count,
+	};
+	if(timer->alarm.flags.auto_reload_on_alarm){
+		timer->count_base = timer->alarm.reload_count;
+		timer->time_base = mock_now;
+	}
+	/* The hardware disables the alarm when it fires. The driver ISR enables it
+	 * again for auto reload alarms; without ISR only an ETM task can */
+	timer->alarm_on = false;
+	MockEtmTimerAlarm(timer);
+	if(timer->on_alarm != NULL){
+		if(timer->alarm.flags.auto_reload_on_alarm){
+			timer->alarm_on = true;
+		}
+		mock_in_isr = true;
+		timer->on_alarm(timer, &edata, timer->user_ctx);
+		mock_in_isr = false;
+	}
+}
+
+/*==================[external functions definition]==========================*/
+uint64_t MockNow(void){
+	return mock_now;
+}
+
+void MockAdvanceTo(uint64_t deadline){
+	uint64_t due;
+	struct gptimer_t *timer;
+	if(mock_in_isr){
+		/* Busy wait inside a callback: alarms fire once it returns */
+		if(deadline > mock_now){
+			mock_now = deadline;
+		}
+		return;
+	}
+	while((timer = next_alarm(&due)) != NULL && due <= deadline){
+		if(due > mock_now){
+			mock_now = due;
+		}
+		fire(timer);
+	}
+	if(deadline > mock_now){
+		mock_now = deadline;
+	}
+}
+
+int MockAdvanceToAlarm(uint64_t deadline){
+	uint64_t due;
+	if(mock_in_isr){
+		return 0;
+	}
+	if(next_alarm(&due) == NULL || due > deadline){
+		if(deadline != UINT64_MAX){
+			MockAdvanceTo(deadline);
+		}
+		return 0;
+	}
+	MockAdvanceTo(due);
+	return 1;
+}
+
+void MockGptimerEtmTask(gptimer_handle_t timer, int task_type){
+	switch(task_type){
+		case GPTIMER_ETM_TASK_START_COUNT:
+			if(!timer->running){
+				timer->time_base = mock_now;
+				timer->running = true;
+			}
+			break;
+		case GPTIMER_ETM_TASK_STOP_COUNT:
+			timer->count_base = timer_count(timer);
+			timer->running = false;
+			break;
+		case GPTIMER_ETM_TASK_EN_ALARM:
+			timer->alarm_on = true;
+			break;
+		case GPTIMER_ETM_TASK_RELOAD:
+			timer->count_base = timer->alarm.reload_count;
+			timer->time_base = mock_now;
+			break;
+		case GPTIMER_ETM_TASK_CAPTURE:
+			timer->captured = timer_count(timer);
+			break;
+	}
+}
+
+BaseType_t xPortInIsrContext(void){
+	return mock_in_isr;
+}
+
+esp_err_t gptimer_new_timer(const gptimer_config_t *config, gptimer_handle_t *ret_timer){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	for(int i = 0; i < TIMERS_MAX; i++){
+		if(!timers[i].used){
+			timers[i] = (struct gptimer_t){
+				.used = true,
+				.resolution_hz = config->resolution_hz,
+				.time_base = mock_now,
+			};
+			*ret_timer = &timers[i];
+			return ESP_OK;
+		}
+	}
+	return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t gptimer_del_timer(gptimer_handle_t timer){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	timer->used = false;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_set_raw_count(gptimer_handle_t timer, uint64_t value){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	timer->count_base = value;
+	timer->time_base = mock_now;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_get_raw_count(gptimer_handle_t timer, uint64_t *value){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	if(timer == NULL){
+		return ESP_ERR_INVALID_ARG;
+	}
+	*value = timer_count(timer);
+	return ESP_OK;
+}
+
+esp_err_t gptimer_get_captured_count(gptimer_handle_t timer, uint64_t *value){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	*value = timer->captured;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_get_resolution(gptimer_handle_t timer, uint32_t *out_resolution){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	*out_resolution = timer->resolution_hz;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_register_event_callbacks(gptimer_handle_t timer, const gptimer_event_callbacks_t *cbs, void *user_data){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	timer->on_alarm = cbs->on_alarm;
+	timer->user_ctx = user_data;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_set_alarm_action(gptimer_handle_t timer, const gptimer_alarm_config_t *config){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	if(config == NULL){
+		timer->alarm_on = false;
+		return ESP_OK;
+	}
+	timer->alarm = *config;
+	timer->alarm_on = true;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_enable(gptimer_handle_t timer){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	timer->enabled = true;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_disable(gptimer_handle_t timer){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	timer->enabled = false;
+	return ESP_OK;
+}
+
+esp_err_t gptimer_start(gptimer_handle_t timer){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	if(!timer->enabled){
+		return ESP_ERR_INVALID_STATE;
+	}
+	if(!timer->running){
+		timer->time_base = mock_now;
+		timer->running = true;
+	}
+	return ESP_OK;
+}
+
+esp_err_t gptimer_stop(gptimer_handle_t timer){
+	MOCK_CALL(MOCK_GPTIMER, 0);
+	timer->count_base = timer_count(timer);
+	timer->running = false;
+	return ESP_OK;
+}
+
+/*==================[end of file]============================================*/
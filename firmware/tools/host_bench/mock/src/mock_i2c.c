@@ -0,0 +1,105 @@
+/**
+ * @file mock_i2c.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: I2C master (legacy command link driver). Every device
+ * acknowledges and registers read as an incrementing byte pattern.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "driver/i2c.h"
+#include <stdlib.h>
+/*==================[macros and definitions]=================================*/
+#define READS_MAX	8		/* Read steps per command link */
+
+typedef struct {
+	uint8_t *data[READS_MAX];
+	size_t len[READS_MAX];
+	int reads;
+	size_t bytes;			/* Bytes on the bus (address, written and read) */
+} cmd_link_t;
+/*==================[internal data definition]===============================*/
+static uint8_t pattern = 0;
+/*==================[internal functions definition]==========================*/
+static esp_err_t cmd_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t len){
+	cmd_link_t *cmd = cmd_handle;
+	if(cmd->reads == READS_MAX){
+		return ESP_ERR_NO_MEM;
+	}
+	cmd->data[cmd->reads] = data;
+	cmd->len[cmd->reads++] = len;
+	cmd->bytes += len;
+	return ESP_OK;
+}
+
+/*==================[external functions definition]==========================*/
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t *i2c_conf){
+	MOCK_CALL(MOCK_I2C, 0);
+	return ESP_OK;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len, int intr_alloc_flags){
+	MOCK_CALL(MOCK_I2C, 0);
+	return ESP_OK;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void){
+	MOCK_CALL(MOCK_I2C, 0);
+	return calloc(1, sizeof(cmd_link_t));
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle){
+	MOCK_CALL(MOCK_I2C, 0);
+	free(cmd_handle);
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle){
+	MOCK_CALL(MOCK_I2C, 0);
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle){
+	MOCK_CALL(MOCK_I2C, 0);
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en){
+	MOCK_CALL(MOCK_I2C, 0);
+	((cmd_link_t*)cmd_handle)->bytes++;
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, const uint8_t *data, size_t data_len, bool ack_en){
+	MOCK_CALL(MOCK_I2C, 0);
+	((cmd_link_t*)cmd_handle)->bytes += data_len;
+	return ESP_OK;
+}
+
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd_handle, uint8_t *data, i2c_ack_type_t ack){
+	MOCK_CALL(MOCK_I2C, 0);
+	return cmd_read(cmd_handle, data, 1);
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd_handle, uint8_t *data, size_t data_len, i2c_ack_type_t ack){
+	MOCK_CALL(MOCK_I2C, 0);
+	return cmd_read(cmd_handle, data, data_len);
+}
+
+/* The bytes of a command link are counted when it is executed */
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait){
+	cmd_link_t *cmd = cmd_handle;
+	MOCK_CALL(MOCK_I2C, cmd->bytes);
+	for(int i = 0; i < cmd->reads; i++){
+		for(size_t j = 0; j < cmd->len[i]; j++){
+			cmd->data[i][j] = pattern++;
+		}
+	}
+	return ESP_OK;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,86 @@
+/**
+ * @file mock_pwm.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: LED PWM controller and sigma-delta modulator
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "driver/ledc.h"
+#include "driver/sdm.h"
+/*==================[internal data definition]===============================*/
+/* Handles are only compared against NULL by the drivers */
+static int dummy;
+/*==================[external functions definition]==========================*/
+esp_err_t ledc_timer_config(const ledc_timer_config_t *timer_conf){
+	MOCK_CALL(MOCK_LEDC, 0);
+	return ESP_OK;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *ledc_conf){
+	MOCK_CALL(MOCK_LEDC, 0);
+	return ESP_OK;
+}
+
+esp_err_t ledc_set_duty(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t duty){
+	MOCK_CALL(MOCK_LEDC, 0);
+	return ESP_OK;
+}
+
+esp_err_t ledc_update_duty(ledc_mode_t speed_mode, ledc_channel_t channel){
+	MOCK_CALL(MOCK_LEDC, 0);
+	return ESP_OK;
+}
+
+esp_err_t ledc_set_freq(ledc_mode_t speed_mode, ledc_timer_t timer_num, uint32_t freq_hz){
+	MOCK_CALL(MOCK_LEDC, 0);
+	return ESP_OK;
+}
+
+esp_err_t ledc_stop(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t idle_level){
+	MOCK_CALL(MOCK_LEDC, 0);
+	return ESP_OK;
+}
+
+esp_err_t ledc_timer_pause(ledc_mode_t speed_mode, ledc_timer_t timer_sel){
+	MOCK_CALL(MOCK_LEDC, 0);
+	return ESP_OK;
+}
+
+esp_err_t ledc_timer_resume(ledc_mode_t speed_mode, ledc_timer_t timer_sel){
+	MOCK_CALL(MOCK_LEDC, 0);
+	return ESP_OK;
+}
+
+esp_err_t sdm_new_channel(const sdm_config_t *config, sdm_channel_handle_t *ret_chan){
+	MOCK_CALL(MOCK_SDM, 0);
+	*ret_chan = (sdm_channel_handle_t)&dummy;
+	return ESP_OK;
+}
+
+esp_err_t sdm_del_channel(sdm_channel_handle_t chan){
+	MOCK_CALL(MOCK_SDM, 0);
+	return ESP_OK;
+}
+
+esp_err_t sdm_channel_enable(sdm_channel_handle_t chan){
+	MOCK_CALL(MOCK_SDM, 0);
+	return ESP_OK;
+}
+
+esp_err_t sdm_channel_disable(sdm_channel_handle_t chan){
+	MOCK_CALL(MOCK_SDM, 0);
+	return ESP_OK;
+}
+
+esp_err_t sdm_channel_set_pulse_density(sdm_channel_handle_t chan, int8_t density){
+	MOCK_CALL(MOCK_SDM, 0);
+	return ESP_OK;
+}
+
+/*==================[end of file]============================================*/
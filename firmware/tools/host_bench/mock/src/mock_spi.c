@@ -0,0 +1,75 @@
+/**
+ * @file mock_spi.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: SPI master. Received data reads as zeros.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "driver/spi_master.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define DEVICES_MAX		6		/* Chip selects per bus, as the target */
+
+struct spi_device_t {
+	spi_device_interface_config_t cfg;
+};
+/*==================[internal data definition]===============================*/
+static struct spi_device_t devices[DEVICES_MAX];
+static int devices_count = 0;
+/*==================[internal functions definition]==========================*/
+static esp_err_t spi_transfer(spi_device_handle_t handle, spi_transaction_t *trans){
+	size_t bits = trans->length > trans->rxlength ? trans->length : trans->rxlength;
+	MOCK_CALL(MOCK_SPI, (bits + 7) / 8);
+	if(trans->rx_buffer != NULL){
+		memset(trans->rx_buffer, 0, (trans->rxlength ? trans->rxlength : trans->length) / 8);
+	}
+	if(handle->cfg.pre_cb != NULL){
+		handle->cfg.pre_cb(trans);
+	}
+	if(handle->cfg.post_cb != NULL){
+		handle->cfg.post_cb(trans);
+	}
+	return ESP_OK;
+}
+
+/*==================[external functions definition]==========================*/
+esp_err_t spi_bus_initialize(spi_host_device_t host_id, const spi_bus_config_t *bus_config, spi_common_dma_t dma_chan){
+	MOCK_CALL(MOCK_SPI, 0);
+	return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host_id, const spi_device_interface_config_t *dev_config, spi_device_handle_t *handle){
+	MOCK_CALL(MOCK_SPI, 0);
+	if(devices_count == DEVICES_MAX){
+		/* No free chip select: the handle is left untouched */
+		return ESP_ERR_NOT_FOUND;
+	}
+	devices[devices_count].cfg = *dev_config;
+	*handle = &devices[devices_count++];
+	return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc){
+	return spi_transfer(handle, trans_desc);
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans_desc){
+	return spi_transfer(handle, trans_desc);
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans_desc, TickType_t ticks_to_wait){
+	return spi_transfer(handle, trans_desc);
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans_desc, TickType_t ticks_to_wait){
+	MOCK_CALL(MOCK_SPI, 0);
+	return ESP_OK;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,220 @@
+/**
+ * @file mock_uart.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host mock: UART driver. Transmitted bytes keep the line busy for
+ * their duration at the configured baud rate: uart_write_bytes() waits for
+ * room in the driver buffer and FIFO, uart_tx_chars() writes only what fits in
+ * the FIFO. Received data comes from MockUartReceive().
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "driver/uart.h"
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define RX_BUFFER_MAX	4096	/* Received data waiting to be read */
+#define BAUD_DEFAULT	115200
+
+typedef struct {
+	int baud_rate;
+	int tx_buffer_size;
+	uint64_t tx_busy_ns;		/* Virtual time the last queued byte leaves the line (ns) */
+	QueueHandle_t queue;		/* Event queue (NULL: none) */
+	uint8_t rx[RX_BUFFER_MAX];
+	uint32_t rx_len;
+} mock_uart_t;
+/*==================[internal data definition]===============================*/
+static mock_uart_t uarts[UART_NUM_MAX];
+static void (*write_hook)(int uart_num, const void *data, uint32_t len);
+/*==================[internal functions definition]==========================*/
+/* Line time of a byte (ns): start, 8 data and stop bits */
+static uint64_t byte_ns(mock_uart_t *u){
+	return 10000000000ULL / (u->baud_rate ? u->baud_rate : BAUD_DEFAULT);
+}
+
+/* Bytes queued in the driver buffer and FIFO, not yet on the line */
+static uint32_t tx_queued(mock_uart_t *u){
+	uint64_t now = MockNow() * 1000;
+	if(u->tx_busy_ns <= now){
+		return 0;
+	}
+	return (u->tx_busy_ns - now + byte_ns(u) - 1) / byte_ns(u);
+}
+
+/* Queue bytes for transmission, the line is busy for their duration */
+static void tx_queue(mock_uart_t *u, uint32_t len){
+	uint64_t now = MockNow() * 1000;
+	if(u->tx_busy_ns < now){
+		u->tx_busy_ns = now;
+	}
+	u->tx_busy_ns += len * byte_ns(u);
+}
+
+/*==================[external functions definition]==========================*/
+void MockUartReceive(int uart_num, const void *data, uint32_t len){
+	mock_uart_t *u = &uarts[uart_num];
+	if(len > RX_BUFFER_MAX - u->rx_len){
+		len = RX_BUFFER_MAX - u->rx_len;
+	}
+	memcpy(&u->rx[u->rx_len], data, len);
+	u->rx_len += len;
+	if(u->queue != NULL && len > 0){
+		uart_event_t event = {
+			.type = UART_DATA,
+			.size = len,
+		};
+		xQueueSend(u->queue, &event, 0);
+	}
+}
+
+void MockUartWriteHook(void (*hook)(int uart_num, const void *data, uint32_t len)){
+	write_hook = hook;
+}
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size, QueueHandle_t *uart_queue, int intr_alloc_flags){
+	MOCK_CALL(MOCK_UART, 0);
+	uarts[uart_num].tx_buffer_size = tx_buffer_size;
+	uarts[uart_num].queue = NULL;
+	if(uart_queue != NULL){
+		*uart_queue = xQueueCreate(queue_size, sizeof(uart_event_t));
+		uarts[uart_num].queue = *uart_queue;
+	}
+	return ESP_OK;
+}
+
+esp_err_t uart_driver_delete(uart_port_t uart_num){
+	MOCK_CALL(MOCK_UART, 0);
+	uarts[uart_num].queue = NULL;
+	return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t uart_num, const uart_config_t *uart_config){
+	MOCK_CALL(MOCK_UART, 0);
+	uarts[uart_num].baud_rate = uart_config->baud_rate;
+	return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t uart_num, int tx_io_num, int rx_io_num, int rts_io_num, int cts_io_num){
+	MOCK_CALL(MOCK_UART, 0);
+	return ESP_OK;
+}
+
+/* Straight to the FIFO: never waits, writes only what fits */
+int uart_tx_chars(uart_port_t uart_num, const char *buffer, uint32_t len){
+	mock_uart_t *u = &uarts[uart_num];
+	uint32_t queued = tx_queued(u);
+	uint32_t room = (queued < UART_FIFO_LEN) ? UART_FIFO_LEN - queued : 0;
+	if(len > room){
+		len = room;
+	}
+	MOCK_CALL(MOCK_UART, len);
+	tx_queue(u, len);
+	return len;
+}
+
+/* Through the driver buffer (or the FIFO without one): waits for room */
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size){
+	mock_uart_t *u = &uarts[uart_num];
+	uint32_t capacity = u->tx_buffer_size + UART_FIFO_LEN;
+	size_t left = size;
+	MOCK_CALL(MOCK_UART, size);
+	if(write_hook != NULL){
+		write_hook(uart_num, src, size);
+	}
+	while(left > 0){
+		uint32_t queued = tx_queued(u);
+		if(queued >= capacity){
+			/* Wait until a byte leaves the line */
+			MockAdvanceTo((u->tx_busy_ns - (uint64_t)(capacity - 1) * byte_ns(u) + 999) / 1000);
+			continue;
+		}
+		uint32_t n = capacity - queued;
+		if(n > left){
+			n = left;
+		}
+		tx_queue(u, n);
+		left -= n;
+	}
+	return size;
+}
+
+int uart_read_bytes(uart_port_t uart_num, void *buf, uint32_t length, TickType_t ticks_to_wait){
+	mock_uart_t *u = &uarts[uart_num];
+	MOCK_CALL(MOCK_UART, 0);
+	if(u->rx_len == 0){
+		if(ticks_to_wait != portMAX_DELAY){
+			/* Times out */
+			MockAdvanceTo(MockNow() + (uint64_t)ticks_to_wait * portTICK_PERIOD_MS * 1000);
+		}
+		return 0;
+	}
+	if(length > u->rx_len){
+		length = u->rx_len;
+	}
+	memcpy(buf, u->rx, length);
+	memmove(u->rx, &u->rx[length], u->rx_len - length);
+	u->rx_len -= length;
+	mock_counts[MOCK_UART].bytes += length;
+	return length;
+}
+
+esp_err_t uart_flush_input(uart_port_t uart_num){
+	MOCK_CALL(MOCK_UART, 0);
+	uarts[uart_num].rx_len = 0;
+	return ESP_OK;
+}
+
+esp_err_t uart_get_buffered_data_len(uart_port_t uart_num, size_t *size){
+	MOCK_CALL(MOCK_UART, 0);
+	*size = uarts[uart_num].rx_len;
+	return ESP_OK;
+}
+
+esp_err_t uart_get_tx_buffer_free_size(uart_port_t uart_num, size_t *size){
+	MOCK_CALL(MOCK_UART, 0);
+	uint32_t queued = tx_queued(&uarts[uart_num]);
+	queued = (queued > UART_FIFO_LEN) ? queued - UART_FIFO_LEN : 0;
+	*size = (queued < (uint32_t)uarts[uart_num].tx_buffer_size) ? uarts[uart_num].tx_buffer_size - queued : 0;
+	return ESP_OK;
+}
+
+esp_err_t uart_wait_tx_done(uart_port_t uart_num, TickType_t ticks_to_wait){
+	MOCK_CALL(MOCK_UART, 0);
+	uint64_t done = (uarts[uart_num].tx_busy_ns + 999) / 1000;
+	uint64_t deadline = MockNow() + (uint64_t)ticks_to_wait * portTICK_PERIOD_MS * 1000;
+	if(done > deadline){
+		MockAdvanceTo(deadline);
+		return ESP_ERR_TIMEOUT;
+	}
+	if(done > MockNow()){
+		MockAdvanceTo(done);
+	}
+	return ESP_OK;
+}
+
+esp_err_t uart_enable_pattern_det_baud_intr(uart_port_t uart_num, char pattern_chr, uint8_t chr_num, int chr_tout, int post_idle, int pre_idle){
+	MOCK_CALL(MOCK_UART, 0);
+	return ESP_OK;
+}
+
+esp_err_t uart_disable_pattern_det_intr(uart_port_t uart_num){
+	MOCK_CALL(MOCK_UART, 0);
+	return ESP_OK;
+}
+
+esp_err_t uart_pattern_queue_reset(uart_port_t uart_num, int queue_length){
+	MOCK_CALL(MOCK_UART, 0);
+	return ESP_OK;
+}
+
+int uart_pattern_pop_pos(uart_port_t uart_num){
+	MOCK_CALL(MOCK_UART, 0);
+	return -1;
+}
+
+/*==================[end of file]============================================*/
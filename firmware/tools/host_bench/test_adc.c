@@ -0,0 +1,148 @@
+/**
+ * @file test_adc.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the ADC continuous mode oversampling. A constant input
+ * with white gaussian noise is converted through the mocked ADC at every
+ * oversampling ratio, with both decimation filters, and AnalogInputEnob() of
+ * the output must match the value expected from the noise gain of the filter.
+ *
+ * Run: ctest (or test_adc directly), returns non zero on failure.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "analog_io_mcu.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+/*==================[macros and definitions]=================================*/
+#define INPUT_LSB		1234.3	/* Constant input (12 bit LSB) */
+#define NOISE_LSB		2.0		/* Input noise rms (12 bit LSB), typical of the ESP32-C6 ADC */
+#define OUTPUTS			8192	/* Output values measured */
+#define SKIP_BLOCKS		2		/* Blocks discarded while the filter settles */
+#define CHUNK			64		/* Samples converted between task runs */
+#define SAMPLE_FREC		1000	/* Output frequency (Hz) */
+#define CIC_ORDER		3		/* Stages of the driver CIC filter */
+#define ENOB_TOL		0.15	/* Max difference with the expected ENOB (bits) */
+/*==================[internal data definition]===============================*/
+static uint16_t outputs[OUTPUTS];
+static uint32_t outputs_len;
+static uint32_t blocks;
+static uint32_t seed = 1;
+/*==================[internal functions definition]==========================*/
+/* Gaussian noise with unit variance (Box-Muller), repeatable */
+static double gauss(void){
+	double u[2];
+	for(int i = 0; i < 2; i++){
+		seed = seed * 1664525u + 1013904223u;
+		u[i] = (seed + 1.0) / 4294967297.0;
+	}
+	return sqrt(-2 * log(u[0])) * cos(2 * M_PI * u[1]);
+}
+
+static void listener(const uint16_t *block, uint16_t len){
+	if(blocks++ < SKIP_BLOCKS){
+		return;
+	}
+	for(uint16_t i = 0; i < len && outputs_len < OUTPUTS; i++){
+		outputs[outputs_len++] = block[i];
+	}
+}
+
+/* Sum of the squared taps over the squared sum of the taps: the gain of the
+ * filter (normalized to unity DC gain) for white noise power */
+static double noise_gain(uint16_t ratio, adc_decim_t decimation){
+	uint8_t order = (decimation == ADC_DECIM_CIC) ? CIC_ORDER : 1;
+	uint32_t len = order * (ratio - 1) + 1;
+	double *h = calloc(len, sizeof(double));
+	double *tmp = calloc(len, sizeof(double));
+	double sum = 0, sum2 = 0;
+	h[0] = 1;
+	/* Cascade of order boxcars of ratio taps */
+	for(uint8_t s = 0; s < order; s++){
+		for(uint32_t n = 0; n < len; n++){
+			tmp[n] = 0;
+			for(uint16_t k = 0; k < ratio && k <= n; k++){
+				tmp[n] += h[n - k];
+			}
+		}
+		for(uint32_t n = 0; n < len; n++){
+			h[n] = tmp[n];
+		}
+	}
+	for(uint32_t n = 0; n < len; n++){
+		sum += h[n];
+		sum2 += h[n] * h[n];
+	}
+	free(h);
+	free(tmp);
+	return sum2 / (sum * sum);
+}
+
+static int run_case(uint16_t ratio, adc_decim_t decimation){
+	static uint16_t raw[CHUNK];
+	analog_input_config_t config = {
+		.input = CH1,
+		.mode = ADC_CONTINUOUS,
+		.func_p = NULL,
+		.param_p = NULL,
+		.sample_frec = SAMPLE_FREC,
+		.oversampling = ratio,
+		.decimation = decimation,
+	};
+	uint8_t log2_ratio = 0;
+	while((1u << log2_ratio) < ratio){
+		log2_ratio++;
+	}
+	uint8_t extra = log2_ratio / 2;
+	uint8_t bits = 12 + extra;
+
+	AnalogInputInit(&config);
+	AnalogInputBlockListener(listener);
+	outputs_len = 0;
+	blocks = 0;
+	AnalogStartContinuous(CH1);
+	while(outputs_len < OUTPUTS){
+		for(uint16_t i = 0; i < CHUNK; i++){
+			/* The ADC quantizes the noisy input */
+			double v = round(INPUT_LSB + NOISE_LSB * gauss());
+			raw[i] = (v < 0) ? 0 : (v > 4095) ? 4095 : (uint16_t)v;
+		}
+		MockAdcConvert(raw, CHUNK);
+		MockRunTasks();
+	}
+	AnalogStopContinuous(CH1);
+
+	/* Input noise (with its quantization), filtered and scaled to the output
+	 * LSB, plus the quantization of the output */
+	double in_var = NOISE_LSB * NOISE_LSB + 1.0 / 12;
+	double out_var = in_var * noise_gain(ratio, decimation) * (1 << (2 * extra)) + 1.0 / 12;
+	double expected = bits - 0.5 * log2(12 * out_var);
+	double enob = AnalogInputEnob(outputs, OUTPUTS, bits);
+	double enob_in = 12 - 0.5 * log2(12 * in_var);
+	int error = fabs(enob - expected) > ENOB_TOL;
+	printf("%-6s %-6s x%-3u: %2u bits, ENOB %5.2f (expected %5.2f), gain %+5.2f bits\n",
+		error ? "FAIL" : "ok", (decimation == ADC_DECIM_CIC) ? "cic" : "boxcar", ratio,
+		bits, enob, expected, enob - enob_in);
+	return error;
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	int failed = 0;
+	for(uint16_t ratio = 1; ratio <= (1 << ADC_MAX_LOG2_OVERSAMPLING); ratio <<= 1){
+		failed += run_case(ratio, ADC_DECIM_BOXCAR);
+	}
+	for(uint16_t ratio = 2; ratio <= (1 << ADC_MAX_LOG2_OVERSAMPLING_CIC); ratio <<= 1){
+		failed += run_case(ratio, ADC_DECIM_CIC);
+	}
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,63 @@
+/**
+ * @file test_fft.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of DspFftDominant(): near full scale tones, raw ADC
+ * samples through a 1024 point Hann FFT, at the sampling frequencies used by
+ * the drivers (up to the 80kHz of the continuous ADC). The result must be
+ * within a fraction of a bin of the tone frequency.
+ *
+ * Run: ctest (or test_fft directly), returns non zero on failure.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "dsp_fft.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+/*==================[macros and definitions]=================================*/
+#define FFT_SIZE		1024
+#define AMPLITUDE		2000	/* Tone amplitude (12 bit counts) */
+#define OFFSET			2048	/* ADC mid scale */
+#define TOL_BINS		0.1		/* Max error of the interpolated peak (bins) */
+/*==================[internal data definition]===============================*/
+static dsp_fft_t fft;
+static uint16_t raw[FFT_SIZE];
+static dsp_cq31_t buf[FFT_SIZE];
+static uint32_t mag[FFT_SIZE / 2];
+static const uint32_t fs_list[] = {1000, 20000, 80000};
+/* Tone frequency (fraction of fs): on a bin, between bins and near the ends */
+static const double tone_list[] = {0.3, 0.125, 0.0123, 0.4567};
+/*==================[internal functions definition]==========================*/
+static int run_case(uint32_t fs, double tone){
+	for(uint16_t i = 0; i < FFT_SIZE; i++){
+		raw[i] = lround(OFFSET + AMPLITUDE * sin(2 * M_PI * tone * i));
+	}
+	DspFftRaw(&fft, raw, buf);
+	DspFftMagnitude(&fft, buf, mag);
+	double got = DspFftDominant(&fft, mag, fs) / 1000.0;
+	double want = tone * fs;
+	int error = fabs(got - want) > TOL_BINS * fs / FFT_SIZE;
+	printf("%-4s fs %5u Hz: dominant %12.3f Hz (expected %12.3f Hz)\n",
+		error ? "FAIL" : "ok", fs, got, want);
+	return error;
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	int failed = 0;
+	DspFftInit(&fft, FFT_SIZE, DSP_WINDOW_HANN);
+	for(uint8_t f = 0; f < sizeof(fs_list) / sizeof(fs_list[0]); f++){
+		for(uint8_t t = 0; t < sizeof(tone_list) / sizeof(tone_list[0]); t++){
+			failed += run_case(fs_list[f], tone_list[t]);
+		}
+	}
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,153 @@
+/**
+ * @file test_fmt.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the fmt module against the C library snprintf(): the
+ * integer conversions with every width and padding, FmtFixed() and FmtFloat()
+ * with every number of decimals, over edge cases and random values.
+ *
+ * Run: ctest (or test_fmt directly), returns non zero on failure.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "fmt.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define RANDOM_VALUES	50000		/* Random values per test */
+#define ERRORS_SHOWN	10			/* Mismatches printed per test */
+/*==================[internal data definition]===============================*/
+static uint32_t seed = 1;
+static uint32_t checks;
+static uint32_t errors;
+/*==================[internal functions definition]==========================*/
+/* Repeatable 32 bit random values */
+static uint32_t random32(void){
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+static void check(const char *what, const char *got, uint8_t len, const char *want){
+	checks++;
+	if(strcmp(got, want) != 0 || len != strlen(want)){
+		if(errors++ < ERRORS_SHOWN){
+			printf("FAIL %s: \"%s\" (%u), expected \"%s\"\n", what, got, len, want);
+		}
+	}
+}
+
+static void test_int(uint32_t u){
+	char got[FMT_BUF_SIZE];
+	char want[FMT_BUF_SIZE + 8];
+	int32_t i = (int32_t)u;
+	check("FmtUint dec", got, FmtUint(got, u, 10, 0, ' '), (snprintf(want, sizeof(want), "%" PRIu32, u), want));
+	check("FmtUint hex", got, FmtUint(got, u, 16, 0, ' '), (snprintf(want, sizeof(want), "%" PRIx32, u), want));
+	check("FmtUint oct", got, FmtUint(got, u, 8, 0, ' '), (snprintf(want, sizeof(want), "%" PRIo32, u), want));
+	check("FmtInt dec", got, FmtInt(got, i, 10, 0, ' '), (snprintf(want, sizeof(want), "%" PRId32, i), want));
+	for(uint8_t width = 1; width <= 12; width += 3){
+		check("FmtUint width", got, FmtUint(got, u, 10, width, ' '), (snprintf(want, sizeof(want), "%*" PRIu32, width, u), want));
+		check("FmtUint zeros", got, FmtUint(got, u, 10, width, '0'), (snprintf(want, sizeof(want), "%0*" PRIu32, width, u), want));
+		check("FmtInt width", got, FmtInt(got, i, 10, width, ' '), (snprintf(want, sizeof(want), "%*" PRId32, width, i), want));
+		check("FmtInt zeros", got, FmtInt(got, i, 10, width, '0'), (snprintf(want, sizeof(want), "%0*" PRId32, width, i), want));
+	}
+}
+
+static void test_fixed(int32_t val){
+	char got[FMT_BUF_SIZE];
+	char want[FMT_BUF_SIZE + 8];
+	for(uint8_t d = 0; d <= FMT_MAX_DECIMALS; d++){
+		/* Reference from integer parts, snprintf has no fixed point */
+		uint32_t mag = (val < 0) ? -(uint32_t)val : (uint32_t)val;
+		uint32_t p = 1;
+		for(uint8_t k = 0; k < d; k++){
+			p *= 10;
+		}
+		if(d == 0){
+			snprintf(want, sizeof(want), "%s%" PRIu32, (val < 0) ? "-" : "", mag);
+		}
+		else{
+			snprintf(want, sizeof(want), "%s%" PRIu32 ".%0*" PRIu32, (val < 0) ? "-" : "", mag / p, d, mag % p);
+		}
+		check("FmtFixed", got, FmtFixed(got, val, d), want);
+	}
+}
+
+static void test_float(float val){
+	char got[FMT_BUF_SIZE];
+	char want[64];
+	for(uint8_t d = 0; d <= FMT_MAX_DECIMALS; d++){
+		uint8_t len = FmtFloat(got, val, d);
+		if(isnan(val)){
+			strcpy(want, "nan");
+		}
+		else if(fabs((double)val) >= 4294967296.0){
+			strcpy(want, "ovf");
+		}
+		else{
+			snprintf(want, sizeof(want), "%.*f", d, (double)val);
+			if(strcmp(want + (want[0] == '-'), "4294967296") == 0 ||
+				strncmp(want + (want[0] == '-'), "4294967296.", 11) == 0){
+				/* Rounded up past 32 bits */
+				strcpy(want, "ovf");
+			}
+		}
+		check("FmtFloat", got, len, want);
+	}
+}
+
+/* Random float with a uniformly distributed exponent */
+static float random_float(void){
+	uint32_t bits = random32();
+	float val;
+	memcpy(&val, &bits, sizeof(val));
+	if(isnan(val)){
+		val = 0;
+	}
+	/* Keep most values inside the 32 bit integer part range */
+	if(fabsf(val) >= 4294967296.0f && (bits & 7) != 0){
+		val = ldexpf(val, -(int)(bits >> 23 & 0x7F));
+	}
+	return val;
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	static const uint32_t ints[] = {0, 1, 9, 10, 99, 100, 12345, 65535, 2147483647u, 2147483648u, 4294967295u};
+	static const float floats[] = {
+		0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 1.5f, 2.5f, 0.125f, 0.375f, 0.05f, 0.15f, 0.25f,
+		-15600.585f, 15600.585f, 123456.789f, 99999.995f, 9.9999995f, 3.14159265f,
+		1e-10f, -1e-10f, 1e-30f, 1e-45f, 0.000000001f, 0.0000000005f,
+		16777216.0f, 16777217.0f, 2147483648.0f, 4294967040.0f, 4294967295.0f,
+		4294967296.0f, 1e20f, INFINITY, -INFINITY, NAN,
+	};
+	for(size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); i++){
+		test_int(ints[i]);
+		test_fixed((int32_t)ints[i]);
+		test_fixed(-(int32_t)ints[i]);
+	}
+	for(size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++){
+		test_float(floats[i]);
+	}
+	for(uint32_t i = 0; i < RANDOM_VALUES; i++){
+		uint32_t u = random32() >> (random32() & 31);
+		test_int(u);
+		test_fixed((int32_t)u);
+		test_float(random_float());
+		/* Values with few decimals, like sensor readings */
+		test_float((float)((int32_t)random32() % 10000000) / 100.0f);
+	}
+	printf("%s: %u checks, %u errors\n", errors ? "FAIL" : "ok", checks, errors);
+	return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,87 @@
+/**
+ * @file test_order_stat.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the order statistics filter against a sorted copy of
+ * the window: median, trimmed mean, min and max of random samples, for power
+ * of 2 and other window lengths. The sample count starts just before it wraps
+ * at 2^32 (about 15h at 80kS/s), so the window must stay right across it.
+ *
+ * Run: ctest (or test_order_stat directly), returns non zero on failure.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "dsp_order_stat.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+/*==================[macros and definitions]=================================*/
+#define SAMPLES			5000		/* Samples per case */
+#define SEQ_START		(UINT32_MAX - SAMPLES / 2)	/* Sample count at the start */
+/*==================[internal data definition]===============================*/
+static dsp_order_stat_t filter;
+static int32_t window[DSP_ORDER_MAX_WINDOW];
+static uint32_t seed = 1;
+static const uint8_t windows[] = {1, 5, 7, 16, 100, 128};
+/*==================[internal functions definition]==========================*/
+/* Repeatable random values, with spikes */
+static int32_t random_value(void){
+	seed = seed * 1664525u + 1013904223u;
+	int32_t x = (int32_t)(seed >> 20) - 2048;
+	return ((seed & 0x1F) == 0) ? x * 1000 : x;
+}
+
+static int compare(const void *a, const void *b){
+	int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+	return (x > y) - (x < y);
+}
+
+static int run_case(uint8_t len, uint8_t trim, bool wrap){
+	static int32_t sorted[DSP_ORDER_MAX_WINDOW];
+	uint32_t errors = 0;
+	DspOrderStatInit(&filter, len, trim);
+	if(wrap){
+		/* As if it had been running for about 15h */
+		filter.seq = SEQ_START;
+	}
+	for(uint32_t i = 0; i < SAMPLES; i++){
+		int32_t x = random_value();
+		window[i % len] = x;
+		DspOrderStatUpdate(&filter, x);
+		uint8_t n = (i + 1 < len) ? i + 1 : len;
+		for(uint8_t j = 0; j < n; j++){
+			sorted[j] = window[j];
+		}
+		qsort(sorted, n, sizeof(int32_t), compare);
+		int32_t median = (n & 1) ? sorted[n / 2] : ((int64_t)sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+		uint8_t k = (filter.trim * n) / len;
+		int64_t sum = 0;
+		for(uint8_t j = k; j < n - k; j++){
+			sum += sorted[j];
+		}
+		if(DspOrderStatMedian(&filter) != median || DspOrderStatMin(&filter) != sorted[0] ||
+			DspOrderStatMax(&filter) != sorted[n - 1] || DspOrderStatTrimmedMean(&filter) != sum / (n - 2 * k)){
+			errors++;
+		}
+	}
+	printf("%-4s window %3u trim %2u%s: %u errors\n", errors ? "FAIL" : "ok", len, filter.trim,
+		wrap ? " (count wraps)" : "", (unsigned)errors);
+	return errors != 0;
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	int failed = 0;
+	for(uint8_t i = 0; i < sizeof(windows) / sizeof(windows[0]); i++){
+		failed += run_case(windows[i], windows[i] / 4, false);
+		failed += run_case(windows[i], windows[i] / 4, true);
+	}
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,146 @@
+/**
+ * @file test_qrs.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host replay test of the QRS detector. Synthetic ECGs (P, Q, R, S and
+ * T waves as gaussians, with baseline wander, 50Hz hum and noise) are fed in
+ * blocks at 250, 500 and 1000Hz. Every beat after the learning phase must be
+ * detected once, close to its R wave, with the right heart rate.
+ *
+ * Run: ctest (or test_qrs directly), returns non zero on failure.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "qrs_detector.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+/*==================[macros and definitions]=================================*/
+#define TEST_S			30		/* Record length (s) */
+#define LEARN_S			2		/* Detector learning phase (s) */
+#define BLOCK			64		/* Samples per QrsProcessQ15() call */
+#define R_TOL_MS		30		/* Max distance between a beat and its R wave */
+#define HR_TOL_BPM		2		/* Max heart rate error */
+#define MV_TO_Q15		8192.0	/* 1mV = 0.25 full scale */
+
+typedef struct {
+	uint16_t fs;		/* Sample frequency (Hz) */
+	uint16_t hr_bpm;	/* Heart rate of the record */
+	float noise_mv;		/* Uniform noise amplitude (mV) */
+	float hum_mv;		/* 50Hz hum amplitude (mV) */
+} test_case_t;
+
+typedef struct {
+	float amp;		/* mV */
+	float t;		/* Offset from the R wave (s) */
+	float width;	/* Standard deviation (s) */
+} wave_t;
+/*==================[internal data definition]===============================*/
+static const wave_t waves[] = {
+	{0.15f, -0.20f, 0.025f},	/* P */
+	{-0.10f, -0.03f, 0.008f},	/* Q */
+	{1.00f, 0.00f, 0.010f},		/* R */
+	{-0.25f, 0.03f, 0.008f},	/* S */
+	{0.30f, 0.28f, 0.040f},		/* T */
+};
+
+static const test_case_t cases[] = {
+	{250, 72, 0.02f, 0.05f},
+	{250, 120, 0.02f, 0.05f},
+	{500, 60, 0.05f, 0.10f},
+	{500, 72, 0.02f, 0.05f},
+	{1000, 72, 0.02f, 0.05f},
+	{1000, 150, 0.05f, 0.10f},
+};
+
+static uint32_t seed = 1;
+/*==================[internal functions definition]==========================*/
+/* Uniform noise in [-1, 1), repeatable */
+static float noise(void){
+	seed = seed * 1664525u + 1013904223u;
+	return (float)(int32_t)seed / 2147483648.0f;
+}
+
+/* Synthetic ECG sample at time t (s), in mV */
+static float ecg_mv(const test_case_t *c, float t){
+	float rr = 60.0f / c->hr_bpm;
+	/* Nearest R waves: the one before and the one after t */
+	float r0 = floorf(t / rr) * rr + rr / 2;
+	float v = 0;
+	for(int k = -1; k <= 1; k++){
+		float r = r0 + k * rr;
+		for(size_t w = 0; w < sizeof(waves) / sizeof(waves[0]); w++){
+			float x = (t - r - waves[w].t) / waves[w].width;
+			v += waves[w].amp * expf(-x * x / 2);
+		}
+	}
+	v += 0.2f * sinf(2 * (float)M_PI * 0.3f * t);
+	v += c->hum_mv * sinf(2 * (float)M_PI * 50.0f * t);
+	v += c->noise_mv * noise();
+	return v;
+}
+
+static int run_case(const test_case_t *c){
+	static qrs_detector_t qrs;
+	static q15_t block[BLOCK];
+	qrs_beat_t beats[8];
+	float rr = 60.0f / c->hr_bpm;
+	uint32_t total = (uint32_t)TEST_S * c->fs;
+	uint32_t detected = 0;
+	uint32_t misplaced = 0;
+	uint16_t hr = 0;
+	int errors = 0;
+
+	QrsInit(&qrs, c->fs);
+	for(uint32_t n = 0; n < total; n += BLOCK){
+		for(uint32_t i = 0; i < BLOCK; i++){
+			float v = ecg_mv(c, (float)(n + i) / c->fs) * MV_TO_Q15;
+			block[i] = (v > 32767) ? 32767 : (v < -32768) ? -32768 : (q15_t)lrintf(v);
+		}
+		uint8_t found = QrsProcessQ15(&qrs, block, BLOCK, beats, 8);
+		for(uint8_t b = 0; b < found; b++){
+			/* Distance to the nearest R wave (at rr / 2 + k * rr) */
+			float t = beats[b].time_ms / 1000.0f - rr / 2;
+			float off = (t - roundf(t / rr) * rr) * 1000;
+			if(fabsf(off) > R_TOL_MS){
+				misplaced++;
+			}
+			detected++;
+			hr = beats[b].hr_bpm;
+		}
+	}
+	/* R waves from the end of the learning phase to the last one reported in time */
+	float first = ceilf((LEARN_S - rr / 2) / rr) * rr + rr / 2;
+	float last = TEST_S - (float)QRS_MAX_LATENCY_MS / 1000;
+	uint32_t expected = (uint32_t)floorf((last - first) / rr) + 1;
+
+	/* A beat right at the end of the learning phase may or may not be reported */
+	if(detected + 1 < expected || detected > expected + 1){
+		errors++;
+	}
+	if(misplaced != 0){
+		errors++;
+	}
+	if(abs((int)hr - c->hr_bpm) > HR_TOL_BPM || abs((int)QrsHeartRate(&qrs) - c->hr_bpm) > HR_TOL_BPM){
+		errors++;
+	}
+	printf("%-6s fs %4u Hz, %3u bpm: %3u beats (expected %3u), %u misplaced, %3u bpm\n",
+		errors ? "FAIL" : "ok", c->fs, c->hr_bpm, detected, expected, misplaced, hr);
+	return errors;
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	int failed = 0;
+	for(size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++){
+		failed += (run_case(&cases[i]) != 0);
+	}
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,118 @@
+/**
+ * @file test_uart.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Host test of the buffered transmitter overflow policy
+ * UART_TX_DROP_OLDEST. Numbered messages overflow the ring while the drain
+ * task is idle (the oldest ones must be dropped) and while it is writing to
+ * the UART (the bytes being written can not be reused, so the newest ones must
+ * be dropped). The messages that reach the mocked UART are checked.
+ *
+ * Run: ctest (or test_uart directly), returns non zero on failure.
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include "mock.h"
+#include "uart_mcu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*==================[macros and definitions]=================================*/
+#define MSG_LEN			64		/* Bytes per message */
+#define RING_MSGS		(UART_TX_RING_SIZE / MSG_LEN)	/* Messages that fit in the ring */
+#define EXTRA_MSGS		5		/* Messages sent beyond the ring size */
+#define MSG_QTY			1000	/* Message numbers */
+/*==================[internal data definition]===============================*/
+static bool sent[MSG_QTY];
+static uint16_t last_sent;
+static uint16_t burst_first;	/* First message of the burst sent during a write */
+static bool burst_pending;
+static bool order_error;
+/*==================[internal functions definition]==========================*/
+/* Message n: its number in 3 digits, padded to MSG_LEN bytes */
+static void send(uint16_t n){
+	char msg[MSG_LEN + 1];
+	snprintf(msg, sizeof(msg), "%03u", n);
+	memset(&msg[3], '.', MSG_LEN - 4);
+	msg[MSG_LEN - 1] = '\n';
+	msg[MSG_LEN] = '\0';
+	UartTxString(UART_CONNECTOR, msg);
+}
+
+static void send_burst(uint16_t first, uint16_t count){
+	for(uint16_t n = first; n < first + count; n++){
+		send(n);
+	}
+}
+
+/* Every write holds whole messages: record their numbers, and send a burst
+ * the first time, as a higher priority task would while the write lasts */
+static void write_hook(int uart_num, const void *data, uint32_t len){
+	const char *p = data;
+	for(uint32_t i = 0; i + MSG_LEN <= len; i += MSG_LEN){
+		uint16_t n = (p[i] - '0') * 100 + (p[i + 1] - '0') * 10 + (p[i + 2] - '0');
+		if(n < last_sent){
+			order_error = true;
+		}
+		last_sent = n;
+		sent[n] = true;
+	}
+	if(burst_pending){
+		burst_pending = false;
+		send_burst(burst_first, RING_MSGS + EXTRA_MSGS);
+	}
+}
+
+/* Messages first to last must have been sent, and no other one from base */
+static int check(const char *what, uint16_t base, uint16_t first, uint16_t last, uint32_t dropped){
+	int error = order_error || (UartTxDropped(UART_CONNECTOR) != dropped);
+	for(uint16_t n = base; n < base + 100; n++){
+		if(sent[n] != (n >= first && n <= last)){
+			error = 1;
+		}
+	}
+	printf("%-4s %s: ", error ? "FAIL" : "ok", what);
+	for(uint16_t n = base; n < base + 100; n++){
+		if(sent[n]){
+			printf("%u ", n);
+		}
+	}
+	printf("(dropped %u)\n", (unsigned)UartTxDropped(UART_CONNECTOR));
+	return error;
+}
+
+/*==================[external functions definition]==========================*/
+int main(void){
+	int failed = 0;
+	serial_config_t port = {
+		.port = UART_CONNECTOR,
+		.baud_rate = 115200,
+		.func_p = UART_NO_INT,
+		.param_p = NULL,
+	};
+	UartInit(&port);
+	MockUartWriteHook(write_hook);
+
+	/* Drain task idle: the oldest messages make room */
+	UartTxInit(UART_CONNECTOR, UART_TX_DROP_OLDEST);
+	send_burst(100, RING_MSGS + EXTRA_MSGS);
+	MockRunTasks();
+	failed += check("drain idle", 100, 100 + EXTRA_MSGS, 100 + RING_MSGS + EXTRA_MSGS - 1, EXTRA_MSGS);
+
+	/* Drain task writing message 200: it keeps its space until the write ends */
+	UartTxInit(UART_CONNECTOR, UART_TX_DROP_OLDEST);
+	burst_first = 201;
+	burst_pending = true;
+	send(200);
+	MockRunTasks();
+	failed += check("drain writing", 200, 200, 200 + RING_MSGS - 1, EXTRA_MSGS + 1);
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*==================[end of file]============================================*/
@@ -0,0 +1,114 @@
+/**
+ * @file telemetry.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief PC side telemetry frame decoder
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "telemetry.h"
+#include <string.h>
+/*==================[internal functions declaration]=========================*/
+static int telemetry_frame(telemetry_decoder_t *dec);
+/*==================[internal functions definition]==========================*/
+/**
+ * @brief Decode and check the frame in dec->buf
+ * 
+ * @return int 1 if the frame was valid
+ */
+static int telemetry_frame(telemetry_decoder_t *dec){
+	uint8_t raw[sizeof(dec->buf)];
+	telemetry_frame_t frame;
+	long len = TelemetryCobsDecode(dec->buf, dec->len, raw);
+	if(len < TELEMETRY_HEADER + 2 || len != TELEMETRY_HEADER + 2 * raw[7] + 2 || raw[7] > TELEMETRY_MAX_SAMPLES){
+		dec->stats.bad_frames++;
+		return 0;
+	}
+	uint16_t crc = raw[len - 2] | (raw[len - 1] << 8);
+	if(TelemetryCrc16(0xFFFF, raw, len - 2) != crc){
+		dec->stats.crc_errors++;
+		return 0;
+	}
+	frame.channel = raw[0];
+	frame.seq = raw[1] | (raw[2] << 8);
+	frame.timestamp = raw[3] | (raw[4] << 8) | (raw[5] << 16) | ((uint32_t)raw[6] << 24);
+	frame.count = raw[7];
+	for(uint8_t i = 0; i < frame.count; i++){
+		frame.samples[i] = (int16_t)(raw[TELEMETRY_HEADER + 2 * i] | (raw[TELEMETRY_HEADER + 2 * i + 1] << 8));
+	}
+	if(dec->synced){
+		dec->stats.lost += (uint16_t)(frame.seq - dec->next_seq);
+	}
+	dec->synced = 1;
+	dec->next_seq = frame.seq + 1;
+	dec->stats.frames++;
+	if(dec->func_p != NULL){
+		dec->func_p(&frame, dec->param_p);
+	}
+	return 1;
+}
+
+/*==================[external functions definition]==========================*/
+void TelemetryDecoderInit(telemetry_decoder_t *dec, void (*func_p)(const telemetry_frame_t *frame, void *param), void *param_p){
+	memset(dec, 0, sizeof(telemetry_decoder_t));
+	dec->func_p = func_p;
+	dec->param_p = param_p;
+}
+
+int TelemetryDecoderFeed(telemetry_decoder_t *dec, const uint8_t *data, size_t len){
+	int frames = 0;
+	dec->stats.bytes += len;
+	for(size_t i = 0; i < len; i++){
+		if(data[i] == 0){
+			if(!dec->overflow && dec->len > 0){
+				frames += telemetry_frame(dec);
+			}
+			else if(dec->overflow){
+				dec->stats.bad_frames++;
+			}
+			dec->len = 0;
+			dec->overflow = 0;
+		}
+		else if(dec->len < sizeof(dec->buf)){
+			dec->buf[dec->len++] = data[i];
+		}
+		else{
+			dec->overflow = 1;
+		}
+	}
+	return frames;
+}
+
+long TelemetryCobsDecode(const uint8_t *src, size_t len, uint8_t *dst){
+	size_t in = 0;
+	long out = 0;
+	while(in < len){
+		uint8_t code = src[in++];
+		if(code == 0 || in + code - 1 > len){
+			return -1;
+		}
+		for(uint8_t i = 1; i < code; i++){
+			dst[out++] = src[in++];
+		}
+		if(code != 0xFF && in < len){
+			dst[out++] = 0;
+		}
+	}
+	return out;
+}
+
+uint16_t TelemetryCrc16(uint16_t crc, const uint8_t *data, size_t len){
+	while(len--){
+		crc ^= (uint16_t)*data++ << 8;
+		for(uint8_t i = 0; i < 8; i++){
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+/*==================[end of file]============================================*/
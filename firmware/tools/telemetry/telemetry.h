@@ -0,0 +1,113 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+/** \brief PC side decoder for the binary telemetry frames sent by UartTelemetrySend().
+ *
+ * Bytes read from the serial port are fed in chunks of any size; complete 
+ * frames are COBS decoded, checked (length and CRC-16) and passed to a 
+ * callback. Lost frames are detected from the sequence number.
+ * 
+ * Example:
+ * @code
+ * telemetry_decoder_t dec;
+ * TelemetryDecoderInit(&dec, PrintFrame, NULL);
+ * while((n = read(fd, buf, sizeof(buf))) > 0){
+ * 	TelemetryDecoderFeed(&dec, buf, n);
+ * }
+ * @endcode
+ *
+ * @author Albano Peñalva
+ *
+ * @section changelog
+ *
+ * |   Date	    | Description                                    						|
+ * |:----------:|:----------------------------------------------------------------------|
+ * | 19/10/2026 | Document creation		                         						|
+ * 
+ **/
+
+/*==================[inclusions]=============================================*/
+#include <stdint.h>
+#include <stddef.h>
+/*==================[macros]=================================================*/
+#define TELEMETRY_MAX_SAMPLES	120		/*!< Must match UART_TELEMETRY_MAX_SAMPLES */
+#define TELEMETRY_HEADER		8		/*!< Channel, sequence, timestamp, count */
+#define TELEMETRY_MAX_FRAME		(TELEMETRY_HEADER + 2 * TELEMETRY_MAX_SAMPLES + 2)	/*!< Decoded frame bytes */
+/*==================[typedef]================================================*/
+/**
+ * @brief Decoded frame
+ */
+typedef struct {
+	uint8_t channel;							/*!< Channel id */
+	uint16_t seq;								/*!< Sequence number */
+	uint32_t timestamp;							/*!< Timestamp of first sample */
+	uint8_t count;								/*!< Number of samples */
+	int16_t samples[TELEMETRY_MAX_SAMPLES];		/*!< Samples */
+} telemetry_frame_t;
+
+/**
+ * @brief Decoder statistics
+ */
+typedef struct {
+	uint32_t frames;		/*!< Valid frames */
+	uint32_t crc_errors;	/*!< Frames with wrong CRC */
+	uint32_t bad_frames;	/*!< Frames with invalid COBS encoding or length */
+	uint32_t lost;			/*!< Frames missing according to the sequence number */
+	uint64_t bytes;			/*!< Bytes received */
+} telemetry_stats_t;
+
+/**
+ * @brief Decoder instance
+ */
+typedef struct {
+	uint8_t buf[TELEMETRY_MAX_FRAME + 4];	/*!< Encoded bytes of current frame */
+	size_t len;								/*!< Bytes in buf */
+	int overflow;							/*!< Current frame too long, discard until delimiter */
+	int synced;								/*!< A valid frame was received (sequence is known) */
+	uint16_t next_seq;						/*!< Expected sequence number */
+	telemetry_stats_t stats;				/*!< Statistics */
+	void (*func_p)(const telemetry_frame_t *frame, void *param);	/*!< Frame callback */
+	void *param_p;							/*!< Parameter for func_p */
+} telemetry_decoder_t;
+/*==================[external functions declaration]=========================*/
+/**
+ * @brief Decoder initialization
+ * 
+ * @param dec Decoder
+ * @param func_p Called for every valid frame
+ * @param param_p Parameter for func_p
+ */
+void TelemetryDecoderInit(telemetry_decoder_t *dec, void (*func_p)(const telemetry_frame_t *frame, void *param), void *param_p);
+
+/**
+ * @brief Feed received bytes
+ * 
+ * @param dec Decoder
+ * @param data Bytes
+ * @param len Number of bytes
+ * @return int Number of valid frames completed
+ */
+int TelemetryDecoderFeed(telemetry_decoder_t *dec, const uint8_t *data, size_t len);
+
+/**
+ * @brief COBS decoding
+ * 
+ * @param src Encoded data (without delimiter)
+ * @param len Encoded length
+ * @param dst Decoded data (len bytes max)
+ * @return long Decoded length, -1 if the encoding is invalid
+ */
+long TelemetryCobsDecode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/**
+ * @brief CRC-16/CCITT-FALSE (same as UartCrc16())
+ * 
+ * @param crc Previous CRC (0xFFFF to start)
+ * @param data Data
+ * @param len Number of bytes
+ * @return uint16_t Updated CRC
+ */
+uint16_t TelemetryCrc16(uint16_t crc, const uint8_t *data, size_t len);
+
+#endif /* #ifndef TELEMETRY_H */
+
+/*==================[end of file]============================================*/
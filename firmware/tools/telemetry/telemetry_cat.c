@@ -0,0 +1,89 @@
+/**
+ * @file telemetry_cat.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Reads telemetry frames from a serial port and prints them as CSV 
+ * (channel, sequence, timestamp, samples...). Statistics go to stderr on exit.
+ * 
+ * Build: cc -O2 -o telemetry_cat telemetry_cat.c telemetry.c
+ * Usage: telemetry_cat /dev/ttyUSB0 921600
+ * 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+/*==================[inclusions]=============================================*/
+#include "telemetry.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+/*==================[internal data definition]===============================*/
+static volatile sig_atomic_t running = 1;
+/*==================[internal functions definition]==========================*/
+static void stop(int sig){
+	(void)sig;
+	running = 0;
+}
+
+static speed_t baud_to_speed(long baud){
+	switch(baud){
+	case 9600: return B9600;
+	case 115200: return B115200;
+	case 230400: return B230400;
+	case 460800: return B460800;
+	case 921600: return B921600;
+	default: return B115200;
+	}
+}
+
+static void print_frame(const telemetry_frame_t *frame, void *param){
+	(void)param;
+	printf("%u,%u,%u", frame->channel, frame->seq, frame->timestamp);
+	for(uint8_t i = 0; i < frame->count; i++){
+		printf(",%d", frame->samples[i]);
+	}
+	printf("\n");
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+	if(argc < 2){
+		fprintf(stderr, "usage: %s <serial port> [baud rate]\n", argv[0]);
+		return 1;
+	}
+	int fd = open(argv[1], O_RDONLY | O_NOCTTY);
+	if(fd < 0){
+		perror(argv[1]);
+		return 1;
+	}
+	struct termios tty;
+	tcgetattr(fd, &tty);
+	cfmakeraw(&tty);
+	speed_t speed = baud_to_speed(argc > 2 ? atol(argv[2]) : 115200);
+	cfsetispeed(&tty, speed);
+	cfsetospeed(&tty, speed);
+	tty.c_cc[VMIN] = 1;
+	tty.c_cc[VTIME] = 0;
+	tcsetattr(fd, TCSANOW, &tty);
+	signal(SIGINT, stop);
+
+	telemetry_decoder_t dec;
+	uint8_t buf[4096];
+	ssize_t n;
+	TelemetryDecoderInit(&dec, print_frame, NULL);
+	while(running && (n = read(fd, buf, sizeof(buf))) > 0){
+		TelemetryDecoderFeed(&dec, buf, n);
+	}
+	fprintf(stderr, "frames %u, lost %u, crc errors %u, bad frames %u, bytes %llu\n",
+		dec.stats.frames, dec.stats.lost, dec.stats.crc_errors, dec.stats.bad_frames,
+		(unsigned long long)dec.stats.bytes);
+	close(fd);
+	return 0;
+}
+
+/*==================[end of file]============================================*/
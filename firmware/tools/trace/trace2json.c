@@ -0,0 +1,161 @@
+/**
+ * @file trace2json.c
+ * @author Albano Peñalva (albano.penalva@uner.edu.ar)
+ * @brief Converts a trace dump sent by TraceDump() to Chrome trace_event JSON
+ * (open it in chrome://tracing or ui.perfetto.dev). Text before the dump is
+ * ignored, so the whole serial output can be captured.
+ *
+ * Build: cc -O2 -o trace2json trace2json.c
+ * Usage: trace2json [file or serial port [baud rate]] > trace.json
+ *        (reads stdin without arguments, configures the port when a baud rate is given)
+ *
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+/*==================[inclusions]=============================================*/
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+/*==================[macros and definitions]=================================*/
+#define IDS_MAX		256		/* Event ids with name */
+#define TASKS_MAX	64		/* Distinct tasks */
+#define LINE_MAX	256		/* Longest input line */
+/*==================[internal data definition]===============================*/
+static char *names[IDS_MAX];
+static unsigned long tasks[TASKS_MAX];
+static int tasks_count = 0;
+/*==================[internal functions definition]==========================*/
+static speed_t baud_to_speed(long baud){
+	switch(baud){
+	case 9600: return B9600;
+	case 115200: return B115200;
+	case 230400: return B230400;
+	case 460800: return B460800;
+	case 921600: return B921600;
+	default: return B115200;
+	}
+}
+
+static FILE *open_input(int argc, char *argv[]){
+	if(argc < 2){
+		return stdin;
+	}
+	int fd = open(argv[1], O_RDONLY | O_NOCTTY);
+	if(fd < 0){
+		perror(argv[1]);
+		return NULL;
+	}
+	if(argc > 2){
+		struct termios tty;
+		tcgetattr(fd, &tty);
+		cfmakeraw(&tty);
+		cfsetispeed(&tty, baud_to_speed(atol(argv[2])));
+		cfsetospeed(&tty, baud_to_speed(atol(argv[2])));
+		tty.c_cc[VMIN] = 1;
+		tty.c_cc[VTIME] = 0;
+		tcsetattr(fd, TCSANOW, &tty);
+	}
+	return fdopen(fd, "r");
+}
+
+/* Print a JSON string without the characters that need escaping */
+static void print_name(const char *name){
+	putchar('"');
+	for(; *name != '\0'; name++){
+		if(*name != '"' && *name != '\\' && (unsigned char)*name >= ' '){
+			putchar(*name);
+		}
+	}
+	putchar('"');
+}
+
+/* Emit a thread name record the first time a task appears */
+static void task_seen(unsigned long task, int *first){
+	for(int i = 0; i < tasks_count; i++){
+		if(tasks[i] == task){
+			return;
+		}
+	}
+	if(tasks_count < TASKS_MAX){
+		tasks[tasks_count++] = task;
+	}
+	printf("%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":", *first ? "" : ",", task);
+	if(task == 0){
+		printf("\"ISR\"}}");
+	} else{
+		printf("\"task 0x%08lx\"}}", task);
+	}
+	*first = 0;
+}
+
+/*==================[external functions definition]==========================*/
+int main(int argc, char *argv[]){
+	char line[LINE_MAX];
+	unsigned mhz = 0, count = 0, lost = 0;
+	uint64_t wraps = 0;
+	uint32_t last = 0;
+	unsigned events = 0;
+	int first = 1;
+	FILE *in = open_input(argc, argv);
+	if(in == NULL){
+		return 1;
+	}
+	/* Skip everything before the dump header */
+	while(fgets(line, sizeof(line), in) != NULL){
+		if(sscanf(line, "# trace %u %u %u", &mhz, &count, &lost) == 3 && mhz != 0){
+			break;
+		}
+	}
+	if(mhz == 0){
+		fprintf(stderr, "no trace dump found\n");
+		return 1;
+	}
+	printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	while(fgets(line, sizeof(line), in) != NULL){
+		unsigned id;
+		char type;
+		unsigned long cycles, task;
+		int name_pos;
+		line[strcspn(line, "\r\n")] = '\0';
+		if(strncmp(line, "# end", 5) == 0){
+			break;
+		}
+		if(sscanf(line, "N %u %n", &id, &name_pos) == 1 && id < IDS_MAX){
+			free(names[id]);
+			names[id] = strdup(&line[name_pos]);
+			continue;
+		}
+		if(sscanf(line, "%c %lu %u %lx", &type, &cycles, &id, &task) != 4 ||
+			(type != 'B' && type != 'E' && type != 'i')){
+			continue;
+		}
+		/* Unwrap the 32 bit cycle count (small steps back are preemption, not wraps) */
+		if((uint32_t)cycles < last && last - (uint32_t)cycles > 0x80000000u){
+			wraps += 1ULL << 32;
+		}
+		last = cycles;
+		task_seen(task, &first);
+		printf(",\n{\"name\":");
+		if(id < IDS_MAX && names[id] != NULL){
+			print_name(names[id]);
+		} else{
+			printf("\"id %u\"", id);
+		}
+		printf(",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu%s}", type,
+			(double)(wraps + (uint32_t)cycles) / mhz, task, type == 'i' ? ",\"s\":\"t\"" : "");
+		events++;
+	}
+	printf("\n]}\n");
+	fprintf(stderr, "events %u of %u, overwritten %u, cpu %u MHz\n", events, count, lost, mhz);
+	return 0;
+}
+
+/*==================[end of file]============================================*/